@@ -135,6 +135,39 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+// カーネルオブジェクトは静的に確保する (mem_plan.h)。ヒープはmem_alloc.c(heap_4.cは使わない)、起動後の確保はmem_plan.cで数える
+// (*) 生成されるconfigTOTAL_HEAP_SIZEは使わない (ヒープのサイズはMEM_ALLOC_HEAP_SIZE)
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void mem_plan_trace_malloc(void *p_addr, uint32_t size);
+#endif
+#define traceMALLOC( pvAddress, uiSize )         mem_plan_trace_malloc( ( pvAddress ), ( uint32_t ) ( uiSize ) )
+// 実行時間統計 (DWTのサイクルカウンタを使う、os_stat.c)
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void os_stat_timer_init(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() os_stat_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         ( *( volatile uint32_t * ) 0xE0001004UL )	/* DWT->CYCCNT */
+// イベントトレース (trace.c、タスクはTCB番号、キューはアドレスの下位16bitを記録する)
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "trace.h"
+#endif
+#define traceTASK_SWITCHED_IN()                  TRACE_EVT( TRACE_TASK_IN, pxCurrentTCB->uxTCBNumber )
+#define traceTASK_SWITCHED_OUT()                 TRACE_EVT( TRACE_TASK_OUT, pxCurrentTCB->uxTCBNumber )
+#define traceQUEUE_SEND( pxQueue )               TRACE_EVT( TRACE_QUEUE_SEND, ( uint32_t ) ( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )      TRACE_EVT( TRACE_QUEUE_SEND, ( uint32_t ) ( pxQueue ) )
+#define traceQUEUE_RECEIVE( pxQueue )            TRACE_EVT( TRACE_QUEUE_RECV, ( uint32_t ) ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )   TRACE_EVT( TRACE_QUEUE_RECV, ( uint32_t ) ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )   TRACE_EVT( TRACE_QUEUE_BLOCK_SEND, ( uint32_t ) ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) TRACE_EVT( TRACE_QUEUE_BLOCK_RECV, ( uint32_t ) ( pxQueue ) )
+#define traceTASK_NOTIFY()                       TRACE_EVT( TRACE_NOTIFY, pxTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_FROM_ISR()              TRACE_EVT( TRACE_NOTIFY, pxTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()         TRACE_EVT( TRACE_NOTIFY, pxTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_TAKE_BLOCK()            TRACE_EVT( TRACE_NOTIFY_BLOCK, pxCurrentTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_WAIT_BLOCK()            TRACE_EVT( TRACE_NOTIFY_BLOCK, pxCurrentTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_TAKE()                  TRACE_EVT( TRACE_NOTIFY_TAKE, pxCurrentTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_WAIT()                  TRACE_EVT( TRACE_NOTIFY_TAKE, pxCurrentTCB->uxTCBNumber )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
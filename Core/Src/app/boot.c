@@ -0,0 +1,442 @@
+/*
+ * boot.c
+ *
+ *  Created on: 2026/4/4
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "event_groups.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "boot.h"
+
+// 依存関係つきの初期化と起動時間の計測
+// ・モジュールの表を依存関係でソートし、earlyのモジュールはスケジューラ開始前にmain()で順に実行する
+// ・それ以外はスケジューラ開始後にワーカースレッドが並行して実行する
+//   (依存するモジュールの完了はイベントグループのビットで待つので、待ちの長い初期化の裏でほかが進む)
+// ・依存するモジュールがエラーになったモジュールは実行しない
+// ・時刻は初期化開始(boot_run_early())からのDWTのサイクル数で取り、µsで表示する
+// ・main()より前(スタートアップ)の各段階のサイクル数はReset_Handlerがstartup_cyc[]に記録する
+// (*) サイクルカウンタは216MHzで約19.8秒で一周するので、それより後のイベントはHAL_GetTick()のms分解能で表示する
+
+// マクロ
+#define BOOT_WORKER_NUM			(2)				// 並行に初期化するスレッド数
+#define BOOT_STACK_SIZE			(256)			// ワーカースレッドのスタックサイズ[word]
+#define BOOT_EVT_ALL			(1UL << 23)		// 全モジュール完了 (イベントグループは24bit)
+#define BOOT_CYC_LIMIT_MS		(19000)			// サイクルカウンタで表示する範囲[ms]
+
+// モジュールの状態
+#define MOD_ST_WAIT				(0)		// 未実行
+#define MOD_ST_RUN				(1)		// 実行中
+#define MOD_ST_DONE				(2)		// 完了
+#define MOD_ST_FAIL				(3)		// 初期化関数がエラー
+#define MOD_ST_SKIP				(4)		// 依存するモジュールがエラーなので実行しない
+
+// モジュールの実行結果
+typedef struct {
+	uint32_t	status;		// 状態
+	uint32_t	worker;		// 実行したスレッド (0:スケジューラ開始前)
+	uint32_t	start_cyc;	// 開始時のサイクルカウンタ
+	uint32_t	end_cyc;	// 終了時のサイクルカウンタ
+	osStatus	ercd;		// 初期化関数の戻り値
+} BOOT_MOD_STAT;
+
+// 制御ブロック
+typedef struct {
+	const BOOT_MOD		*p_mod;						// モジュールの表
+	uint32_t			mod_num;					// モジュール数
+	uint32_t			order[BOOT_MOD_MAX];		// 実行順 (表のインデックス)
+	uint32_t			next;						// 次に取り出す実行順
+	uint32_t			done_num;					// 終わったモジュール数
+	uint32_t			fail_mask;					// エラーになったモジュール
+	BOOT_MOD_STAT		stat[BOOT_MOD_MAX];			// 実行結果
+	EventGroupHandle_t	evt;						// 完了したモジュール
+	uint32_t			base_cyc;					// 基準 (初期化開始)
+	uint32_t			base_tick;					// 基準 (初期化開始)
+	uint32_t			late_cyc;					// スケジューラ開始
+	uint32_t			end_cyc;					// 全モジュール完了
+	uint32_t			mark_cyc[BOOT_MARK_NUM];	// イベントのサイクルカウンタ
+	uint32_t			mark_tick[BOOT_MARK_NUM];	// イベントのtick
+} BOOT_CB;
+static BOOT_CB boot_cb MEM_PLAN(os);
+#define get_myself() (&boot_cb)
+
+// イベント記録済み
+volatile uint32_t boot_mark_done[BOOT_MARK_NUM] MEM_PLAN(os);
+
+// イベント名
+static const char * const boot_mark_name[BOOT_MARK_NUM] = {
+	"link up", "first tx", "first rx",
+};
+
+// スタートアップの記録 (Reset_Handlerが書く、.bssのゼロクリアで消えないように.noinitに置く)
+#define STARTUP_CYC_RESET		(0)		// リセット直後
+#define STARTUP_CYC_SYSINIT		(1)		// SystemInit()終了
+#define STARTUP_CYC_COPY		(2)		// コピー表の処理終了 (.data、.itcm_text)
+#define STARTUP_CYC_ZERO		(3)		// ゼロクリア表の処理終了 (.bss)
+#define STARTUP_CYC_MAIN		(4)		// __libc_init_array()終了
+#define STARTUP_CYC_NUM			(5)
+uint32_t startup_cyc[STARTUP_CYC_NUM] MEM_PLAN_NOINIT(os);
+
+// 初期化の表 (リンカスクリプト)
+extern uint32_t __copy_table_start__[];	// ロードアドレス、先頭、終端
+extern uint32_t __copy_table_end__[];
+extern uint32_t __zero_table_start__[];	// 先頭、終端
+extern uint32_t __zero_table_end__[];
+extern uint8_t __noinit_start__[];
+extern uint8_t __noinit_end__[];
+
+// 状態名
+static const char * const boot_st_name[] = {
+	"wait", "run", "ok", "fail", "skip",
+};
+
+// 初期化開始からの経過時間[us]
+static uint32_t boot_elapsed_us(uint32_t cyc, uint32_t tick)
+{
+	BOOT_CB *this = get_myself();
+	
+	if ((tick - this->base_tick) >= BOOT_CYC_LIMIT_MS) {
+		return (tick - this->base_tick) * 1000;
+	}
+	
+	return (cyc - this->base_cyc) / (SystemCoreClock / 1000000);
+}
+
+// 依存関係でソート (依存先がないモジュールや循環がある場合はエラー)
+static osStatus boot_sort(void)
+{
+	BOOT_CB *this = get_myself();
+	const BOOT_MOD *p_mod;
+	uint32_t placed = 0;
+	uint32_t n = 0;
+	uint32_t progress;
+	uint32_t i;
+	
+	while (n < this->mod_num) {
+		progress = 0;
+		for (i = 0; i < this->mod_num; i++) {
+			p_mod = &(this->p_mod[i]);
+			if (((placed & BOOT_DEP(i)) == 0) && ((p_mod->deps & ~placed) == 0)) {
+				this->order[n++] = i;
+				placed |= BOOT_DEP(i);
+				progress = 1;
+			}
+		}
+		if (!progress) {
+			return osErrorParameter;
+		}
+	}
+	
+	return osOK;
+}
+
+// モジュール完了
+static void boot_done(uint32_t id)
+{
+	BOOT_CB *this = get_myself();
+	uint32_t primask;
+	uint32_t all;
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (this->stat[id].status != MOD_ST_DONE) {
+		this->fail_mask |= BOOT_DEP(id);
+	}
+	all = (++this->done_num == this->mod_num);
+	if (all) {
+		this->end_cyc = DWT->CYCCNT;
+	}
+	__set_PRIMASK(primask);
+	
+	xEventGroupSetBits(this->evt, BOOT_DEP(id) | (all ? BOOT_EVT_ALL : 0));
+}
+
+// モジュール実行
+static void boot_exec(uint32_t id, uint32_t worker)
+{
+	BOOT_CB *this = get_myself();
+	const BOOT_MOD *p_mod = &(this->p_mod[id]);
+	BOOT_MOD_STAT *p_stat = &(this->stat[id]);
+	
+	p_stat->worker = worker;
+	p_stat->status = MOD_ST_RUN;
+	p_stat->start_cyc = DWT->CYCCNT;
+	
+	if ((p_mod->deps & this->fail_mask) != 0) {
+		p_stat->ercd = osErrorResource;
+		p_stat->status = MOD_ST_SKIP;
+	} else {
+		p_stat->ercd = p_mod->func();
+		p_stat->status = (p_stat->ercd == osOK) ? MOD_ST_DONE : MOD_ST_FAIL;
+	}
+	
+	p_stat->end_cyc = DWT->CYCCNT;
+	boot_done(id);
+}
+
+// 次に実行するモジュールを取り出す (なければmod_num)
+static uint32_t boot_next(void)
+{
+	BOOT_CB *this = get_myself();
+	uint32_t id = this->mod_num;
+	uint32_t primask;
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	while (this->next < this->mod_num) {
+		id = this->order[this->next++];
+		if (!this->p_mod[id].early) {
+			break;
+		}
+		id = this->mod_num;
+	}
+	__set_PRIMASK(primask);
+	
+	return id;
+}
+
+// ワーカースレッド
+// 実行順に取り出すので、依存するモジュールはすでにどれかのスレッドが取り出している (待っても詰まらない)
+static void boot_worker_thread(void const *argument)
+{
+	BOOT_CB *this = get_myself();
+	uint32_t worker = (uint32_t)argument;
+	uint32_t deps;
+	uint32_t id;
+	
+	while ((id = boot_next()) < this->mod_num) {
+		// 依存するモジュールの完了待ち
+		deps = this->p_mod[id].deps;
+		if (deps != 0) {
+			xEventGroupWaitBits(this->evt, deps, pdFALSE, pdTRUE, portMAX_DELAY);
+		}
+		boot_exec(id, worker);
+	}
+	
+	osThreadTerminate(NULL);
+}
+
+// スケジューラ開始前の初期化 (クロック設定後にmain()から呼ぶ)
+// 戻り値 : earlyのモジュールがエラーになった場合はosErrorResource (スケジューラを開始しないこと)
+osStatus boot_run_early(const BOOT_MOD *p_mod, uint32_t num)
+{
+	BOOT_CB *this = get_myself();
+	static StaticEventGroup_t boot_evt_cb MEM_PLAN(os);
+	uint32_t id;
+	uint32_t i;
+	osStatus ercd;
+	
+	// 時刻の基準 (サイクルカウンタはReset_Handlerで有効にしている)
+	memset(this, 0, sizeof(BOOT_CB));
+	this->base_cyc = DWT->CYCCNT;
+	this->base_tick = HAL_GetTick();
+	
+	// パラメータチェック
+	if ((p_mod == NULL) || (num == 0) || (num > BOOT_MOD_MAX)) {
+		return osErrorParameter;
+	}
+	this->p_mod = p_mod;
+	this->mod_num = num;
+	
+	// earlyのモジュールはearlyにしか依存できない
+	for (i = 0; i < num; i++) {
+		for (id = 0; id < num; id++) {
+			if (p_mod[i].early && ((p_mod[i].deps & BOOT_DEP(id)) != 0) && !p_mod[id].early) {
+				return osErrorParameter;
+			}
+		}
+	}
+	if ((ercd = boot_sort()) != osOK) {
+		return ercd;
+	}
+	
+	// 完了通知
+	if ((this->evt = xEventGroupCreateStatic(&boot_evt_cb)) == NULL) {
+		return osErrorOS;
+	}
+	
+	// 実行順にearlyのモジュールだけ実行
+	for (i = 0; i < num; i++) {
+		id = this->order[i];
+		if (p_mod[id].early) {
+			boot_exec(id, 0);
+		}
+	}
+	
+	// earlyのモジュールがエラー (lateのモジュールも依存していれば実行されない)
+	if (this->fail_mask != 0) {
+		return osErrorResource;
+	}
+	
+	return osOK;
+}
+
+// スケジューラ開始後の初期化 (osKernelStart()の前に呼ぶ)
+osStatus boot_start_late(void)
+{
+	BOOT_CB *this = get_myself();
+	uint32_t i;
+	
+	if (this->evt == NULL) {
+		return osErrorResource;
+	}
+	
+	MEM_PLAN_THREAD(os, boot_w1, boot_worker_thread, osPriorityNormal, BOOT_STACK_SIZE);
+	MEM_PLAN_THREAD(os, boot_w2, boot_worker_thread, osPriorityNormal, BOOT_STACK_SIZE);
+	const osThreadDef_t *worker_def[BOOT_WORKER_NUM] = {
+		osThread(boot_w1), osThread(boot_w2),
+	};
+	
+	this->late_cyc = DWT->CYCCNT;
+	for (i = 0; i < BOOT_WORKER_NUM; i++) {
+		if (osThreadCreate(worker_def[i], (void*)(i + 1)) == NULL) {
+			return osErrorOS;
+		}
+	}
+	
+	return osOK;
+}
+
+// 全モジュールの完了待ち
+osStatus boot_wait(uint32_t tmout)
+{
+	BOOT_CB *this = get_myself();
+	EventBits_t bits;
+	
+	if (this->evt == NULL) {
+		return osErrorResource;
+	}
+	
+	bits = xEventGroupWaitBits(this->evt, BOOT_EVT_ALL, pdFALSE, pdTRUE,
+	                           (tmout == osWaitForever) ? portMAX_DELAY : pdMS_TO_TICKS(tmout));
+	
+	return ((bits & BOOT_EVT_ALL) != 0) ? osOK : osErrorTimeoutResource;
+}
+
+// イベント記録
+void boot_mark_set(uint32_t id)
+{
+	BOOT_CB *this = get_myself();
+	uint32_t primask;
+	
+	if (id >= BOOT_MARK_NUM) {
+		return;
+	}
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (!boot_mark_done[id]) {
+		this->mark_cyc[id] = DWT->CYCCNT;
+		this->mark_tick[id] = HAL_GetTick();
+		boot_mark_done[id] = 1;
+	}
+	__set_PRIMASK(primask);
+}
+
+// スタートアップの表示
+static void boot_startup_report(void)
+{
+	uint32_t *p;
+	uint32_t copy = 0, zero = 0, noinit, saved = 0;
+	uint32_t zero_cyc;
+	
+	// コピーした量 (ロードアドレスと同じ場所はコピーしていない)
+	for (p = __copy_table_start__; p < __copy_table_end__; p += 3) {
+		if (p[0] != p[1]) {
+			copy += p[2] - p[1];
+		}
+	}
+	for (p = __zero_table_start__; p < __zero_table_end__; p += 2) {
+		zero += p[1] - p[0];
+	}
+	
+	// .noinitをゼロクリアしていたらかかったサイクル数 (今回のゼロクリアの速さで見積もる)
+	noinit = (uint32_t)(__noinit_end__ - __noinit_start__);
+	zero_cyc = startup_cyc[STARTUP_CYC_ZERO] - startup_cyc[STARTUP_CYC_COPY];
+	if (zero != 0) {
+		saved = (uint32_t)(((uint64_t)noinit * zero_cyc) / zero);
+	}
+	
+	console_printf("startup [cycles]\n");
+	console_printf(" SystemInit : %u\n", startup_cyc[STARTUP_CYC_SYSINIT] - startup_cyc[STARTUP_CYC_RESET]);
+	console_printf(" copy : %u bytes %u\n", copy, startup_cyc[STARTUP_CYC_COPY] - startup_cyc[STARTUP_CYC_SYSINIT]);
+	console_printf(" zero : %u bytes %u\n", zero, zero_cyc);
+	console_printf(" noinit : %u bytes, saved about %u\n", noinit, saved);
+	console_printf(" libc init : %u\n", startup_cyc[STARTUP_CYC_MAIN] - startup_cyc[STARTUP_CYC_ZERO]);
+}
+
+// モジュールの初期化が成功したか
+// id : モジュール (表のインデックス)
+uint32_t boot_is_done(uint32_t id)
+{
+	BOOT_CB *this = get_myself();
+	
+	if (id >= this->mod_num) {
+		return 0;
+	}
+	
+	return (this->stat[id].status == MOD_ST_DONE) ? 1 : 0;
+}
+
+// 起動タイムラインの表示
+void boot_report(void)
+{
+	BOOT_CB *this = get_myself();
+	const BOOT_MOD *p_mod;
+	BOOT_MOD_STAT *p_stat;
+	uint32_t cyc_per_us = SystemCoreClock / 1000000;
+	uint32_t start, end;
+	uint32_t i, id;
+	
+	boot_startup_report();
+	
+	console_printf("boot timeline [us from init start]\n");
+	for (i = 0; i < this->mod_num; i++) {
+		id = this->order[i];
+		p_mod = &(this->p_mod[id]);
+		p_stat = &(this->stat[id]);
+		start = (p_stat->start_cyc - this->base_cyc) / cyc_per_us;
+		end = (p_stat->end_cyc - this->base_cyc) / cyc_per_us;
+		if (p_stat->worker == 0) {
+			console_printf(" %s : early %u - %u (%u) %s\n", p_mod->name, start, end, end - start, boot_st_name[p_stat->status]);
+		} else {
+			console_printf(" %s : task%u %u - %u (%u) %s\n", p_mod->name, p_stat->worker, start, end, end - start, boot_st_name[p_stat->status]);
+		}
+		if ((p_stat->status == MOD_ST_FAIL) || (p_stat->status == MOD_ST_SKIP)) {
+			console_printf("   ercd = %d\n", p_stat->ercd);
+		}
+	}
+	console_printf(" scheduler start : %u\n", (this->late_cyc - this->base_cyc) / cyc_per_us);
+	if (this->done_num == this->mod_num) {
+		console_printf(" all done : %u\n", (this->end_cyc - this->base_cyc) / cyc_per_us);
+	}
+	
+	// イベント
+	for (i = 0; i < BOOT_MARK_NUM; i++) {
+		if (boot_mark_done[i]) {
+			console_printf(" %s : %u\n", boot_mark_name[i], boot_elapsed_us(this->mark_cyc[i], this->mark_tick[i]));
+		} else {
+			console_printf(" %s : -\n", boot_mark_name[i]);
+		}
+	}
+}
+
+// 起動タイムライン表示コマンド
+static void boot_cmd(int argc, char *argv[])
+{
+	boot_report();
+}
+
+// コマンド設定関数
+void boot_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "boot";
+	cmd.func = boot_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,47 @@
+/*
+ * boot.h
+ *
+ *  Created on: 2026/4/4
+ *      Author: user
+ */
+
+#ifndef APL_BOOT_H_
+#define APL_BOOT_H_
+
+// 初期化関数
+typedef osStatus (*BOOT_FUNC)(void);
+
+// モジュール情報
+#define BOOT_DEP(id)		(1UL << (id))	// 依存するモジュール (表のインデックス)
+#define BOOT_MOD_MAX		(16)			// 登録できるモジュール数の最大
+typedef struct {
+	const char	*name;		// 名前
+	BOOT_FUNC	func;		// 初期化関数
+	uint32_t	deps;		// 依存するモジュール (BOOT_DEP()の論理和)
+	uint32_t	early;		// 1:スケジューラ開始前に実行する (early同士にしか依存できない)
+} BOOT_MOD;
+
+// 起動後のイベント (最初の1回だけ記録する)
+#define BOOT_MARK_LINK_UP	(0)		// PHYのリンクアップ
+#define BOOT_MARK_FIRST_TX	(1)		// 最初の送信
+#define BOOT_MARK_FIRST_RX	(2)		// 最初の受信
+#define BOOT_MARK_NUM		(3)
+
+// イベント記録 (割り込み、タスクどちらからでも呼べる、2回目以降は判定だけ)
+extern volatile uint32_t boot_mark_done[BOOT_MARK_NUM];
+#define BOOT_MARK(id) \
+	do { \
+		if (boot_mark_done[(id)] == 0) { \
+			boot_mark_set(id); \
+		} \
+	} while (0)
+
+extern osStatus boot_run_early(const BOOT_MOD *p_mod, uint32_t num);
+extern osStatus boot_start_late(void);
+extern osStatus boot_wait(uint32_t tmout);
+extern uint32_t boot_is_done(uint32_t id);
+extern void boot_mark_set(uint32_t id);
+extern void boot_report(void);
+extern void boot_set_cmd(void);
+
+#endif /* APL_BOOT_H_ */
@@ -7,14 +7,17 @@
 #include <stdarg.h>
 #include <string.h>
 #include "cmsis_os.h"
+#include "mem_plan.h"
 #include "console.h"
 #include "usart_drv.h"
+#include "dma_cpy.h"
 
 #define CONOLE_BUF_SIZE		(64)		// コマンドラインバッファサイズ
 #define STACK_SIZE			(512)		// スタックサイズ
-#define CONOLE_CMD_NUM		(16)		// 設定できるコマンドの数
+#define CONOLE_CMD_NUM		(24)		// 設定できるコマンドの数
 #define CONSOLE_ARG_MAX		(10)		// 引数の個数の最大値
 #define CONSOLE_SEND_MAX	(128)		// コンソール出力する最大の文字数
+#define CONSOLE_SEND_NUM	(32)		// コンソール送信バッファ数
 
 #define CONSOLE_SEND_TASK	(0)
 #define CONSOLE_RECV_TASK	(1)
@@ -24,15 +27,19 @@
 typedef struct {
 	osThreadId 		ConsoleSendTaskHandle;		// コンソール送信タスク
 	osThreadId 		ConsoleRecvTaskHandle;		// コンソール受信タスク
-	osMailQId		ConsoleSendMailHandle;		// コンソール送信バッファ
+	osMessageQId	ConsoleSendQueHandle;		// コンソール送信キュー (送信バッファ番号)
+	osMessageQId	ConsoleFreeQueHandle;		// 空き送信バッファキュー (送信バッファ番号)
 	char			buf[CONOLE_BUF_SIZE];		// コマンドラインバッファ
 	uint8_t			buf_idx;					// コマンドラインバッファインデックス
 	COMMAND_INFO	cmd_info[CONOLE_CMD_NUM];	// コマンド関数
 	uint8_t			cmd_idx;					// コマンド関数インデックス
 } CONSOLE_CB;
-static CONSOLE_CB console_cb;
+static CONSOLE_CB console_cb MEM_PLAN(app);
 #define get_myself() (&console_cb)
 
+// 送信バッファ (静的に確保し、番号をキューでやり取りする)
+static char console_send_buf[CONSOLE_SEND_NUM][CONSOLE_SEND_MAX] MEM_PLAN_NOINIT(app);	// 使う前にクリアする
+
 // 特定の文字位置を取得
 uint8_t find_str(char str, char *data)
 {
@@ -289,13 +296,13 @@ void StartConsoleSend(void const * argument)
 	
 	while (1) {
 		// 送信データ待ち
-		evt = osMailGet(this->ConsoleSendMailHandle, 10);
+		evt = osMessageGet(this->ConsoleSendQueHandle, 10);
 		// イベントがないなら次の送信データを待つ
-		if (evt.status == osEventMail) {
-			// 早く開放したいからローカル変数にコピー
-			memcpy(print_buf, evt.value.p, CONSOLE_SEND_MAX);
+		if (evt.status == osEventMessage) {
+			// 早く開放したいからローカル変数にコピー (閾値未満なのでCPUのワード単位コピーになる)
+			dma_cpy(print_buf, console_send_buf[evt.value.v], CONSOLE_SEND_MAX);
 			// 解放
-			osMailFree(this->ConsoleSendMailHandle, evt.value.p);
+			osMessagePut(this->ConsoleFreeQueHandle, evt.value.v, 0);
 			// サイズ取得
 			size = strlen(print_buf);
 			// コンソール出力
@@ -336,6 +343,7 @@ osStatus console_init(void)
 {
 	CONSOLE_CB *this =  get_myself();
 	uint32_t ercd;
+	uint32_t i;
 	
 	// 初期化
 	memset(this, 0x00, sizeof(CONSOLE_CB));
@@ -345,14 +353,19 @@ osStatus console_init(void)
 		goto EXIT;
 	}
 	
-	// メールキュー作成
-	osMailQDef(ConsoleSendBuf, 32, CONSOLE_SEND_MAX);
-	this->ConsoleSendMailHandle = osMailCreate(osMailQ(ConsoleSendBuf), NULL);
+	// 送信キュー作成 (空きキューには全送信バッファを登録しておく)
+	MEM_PLAN_MESSAGE_Q(app, ConsoleSendQue, CONSOLE_SEND_NUM, uint32_t);
+	this->ConsoleSendQueHandle = osMessageCreate(osMessageQ(ConsoleSendQue), NULL);
+	MEM_PLAN_MESSAGE_Q(app, ConsoleFreeQue, CONSOLE_SEND_NUM, uint32_t);
+	this->ConsoleFreeQueHandle = osMessageCreate(osMessageQ(ConsoleFreeQue), NULL);
+	for (i = 0; i < CONSOLE_SEND_NUM; i++) {
+		osMessagePut(this->ConsoleFreeQueHandle, i, 0);
+	}
 	
-	osThreadDef(ConsoleSend, StartConsoleSend, osPriorityNormal, 0, 512);
+	MEM_PLAN_THREAD(app, ConsoleSend, StartConsoleSend, osPriorityNormal, STACK_SIZE);
 	this->ConsoleSendTaskHandle = osThreadCreate(osThread(ConsoleSend), NULL);
 	
-	osThreadDef(ConsoleRecv, StartConsoleRecv, osPriorityLow, 0, 512);
+	MEM_PLAN_THREAD(app, ConsoleRecv, StartConsoleRecv, osPriorityLow, STACK_SIZE);
 	this->ConsoleRecvTaskHandle = osThreadCreate(osThread(ConsoleRecv), NULL);
 	
 EXIT:
@@ -365,6 +378,7 @@ void console_printf(const char *fmt, ...)
 	int32_t length = 0;
 	va_list va;
 	char *output;
+	osEvent evt;
 	
 	va_start(va, fmt);
 	length = ts_formatlength(fmt, va);
@@ -375,8 +389,12 @@ void console_printf(const char *fmt, ...)
 		return;
 	}
 	
-	// メモリ確保
-	output = osMailAlloc(this->ConsoleSendMailHandle, osWaitForever);
+	// 送信バッファ確保
+	evt = osMessageGet(this->ConsoleFreeQueHandle, osWaitForever);
+	if (evt.status != osEventMessage) {
+		return;
+	}
+	output = console_send_buf[evt.value.v];
 	
 	// 初期化
 	memset(output, 0x00, CONSOLE_SEND_MAX);
@@ -384,7 +402,7 @@ void console_printf(const char *fmt, ...)
 	va_start(va, fmt);
 	length = ts_formatstring(output, fmt, va);
 	// コンソール送信タスクへ送信
-	osMailPut(this->ConsoleSendMailHandle, output);
+	osMessagePut(this->ConsoleSendQueHandle, evt.value.v, 0);
 	va_end(va);
 	
 }
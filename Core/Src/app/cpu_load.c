@@ -0,0 +1,105 @@
+/*
+ * cpu_load.c
+ *
+ *  Created on: 2026/2/7
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "mem_plan.h"
+#include "cpu_load.h"
+
+// 最低優先度でカウンタを回し、計測区間中に進んだ量からCPUの空き時間を求める
+// (*) 校正中(100ms)はほかの処理が動いていないこと
+
+// マクロ
+#define CPU_LOAD_CAL_TIME		(100)		// 校正時間[ms]
+#define CPU_LOAD_DWT_MAX_MS		(10000)		// DWTで経過時間を測る最大[ms] (これより長い場合はティックを使う)
+
+// 制御ブロック
+typedef struct {
+	osThreadId			idle_thread_id;	// アイドルカウンタスレッド
+	volatile uint32_t	idle_cnt;		// アイドルカウンタ
+	uint32_t			cyc_per_idle;	// 1カウントあたりのサイクル数 (x256)
+} CPU_LOAD_CB;
+static CPU_LOAD_CB cpu_load_cb MEM_PLAN(app);
+#define get_myself() (&cpu_load_cb)
+
+// アイドルカウンタスレッド
+static void cpu_load_idle_thread(void const *argument)
+{
+	CPU_LOAD_CB *this = get_myself();
+	
+	while (1) {
+		this->idle_cnt++;
+	}
+}
+
+// アイドルカウンタ開始と校正
+void cpu_load_calibrate(void)
+{
+	CPU_LOAD_CB *this = get_myself();
+	uint32_t cnt, cyc;
+	
+	if (this->idle_thread_id == NULL) {
+		MEM_PLAN_THREAD(app, cpu_idle, cpu_load_idle_thread, osPriorityIdle, 128);
+		this->idle_thread_id = osThreadCreate(osThread(cpu_idle), NULL);
+	}
+	
+	cnt = this->idle_cnt;
+	cyc = DWT->CYCCNT;
+	osDelay(CPU_LOAD_CAL_TIME);
+	cnt = this->idle_cnt - cnt;
+	cyc = DWT->CYCCNT - cyc;
+	if (cnt == 0) {
+		cnt = 1;
+	}
+	
+	this->cyc_per_idle = (uint32_t)(((uint64_t)cyc << 8) / cnt);
+}
+
+// 計測開始
+void cpu_load_start(CPU_LOAD_MEAS *p_meas)
+{
+	CPU_LOAD_CB *this = get_myself();
+	
+	p_meas->idle_cnt = this->idle_cnt;
+	p_meas->cyc = DWT->CYCCNT;
+	p_meas->tick = osKernelSysTick();
+}
+
+// 計測終了
+// p_busy_cyc : 計測区間でCPUが処理に使ったサイクル数 (NULL可)
+// 戻り値 : CPU負荷[0.1%]
+uint32_t cpu_load_stop(CPU_LOAD_MEAS *p_meas, uint64_t *p_busy_cyc)
+{
+	CPU_LOAD_CB *this = get_myself();
+	uint64_t elapsed;
+	uint64_t idle_cyc;
+	uint64_t busy = 0;
+	uint32_t ms;
+	
+	// 経過サイクル数 (DWTは216MHzで約19秒で一周するので長い区間はティックから求める)
+	ms = osKernelSysTick() - p_meas->tick;
+	if (ms < CPU_LOAD_DWT_MAX_MS) {
+		elapsed = (uint32_t)(DWT->CYCCNT - p_meas->cyc);
+	} else {
+		elapsed = (uint64_t)ms * (SystemCoreClock / 1000);
+	}
+	
+	// アイドルだったサイクル数
+	idle_cyc = ((uint64_t)(this->idle_cnt - p_meas->idle_cnt) * this->cyc_per_idle) >> 8;
+	if (idle_cyc < elapsed) {
+		busy = elapsed - idle_cyc;
+	}
+	
+	if (p_busy_cyc != NULL) {
+		*p_busy_cyc = busy;
+	}
+	if (elapsed == 0) {
+		return 0;
+	}
+	
+	return (uint32_t)((busy * 1000) / elapsed);
+}
@@ -0,0 +1,22 @@
+/*
+ * cpu_load.h
+ *
+ *  Created on: 2026/2/7
+ *      Author: user
+ */
+
+#ifndef APL_CPU_LOAD_H_
+#define APL_CPU_LOAD_H_
+
+// 計測情報
+typedef struct {
+	uint32_t	idle_cnt;	// 開始時のアイドルカウンタ
+	uint32_t	cyc;		// 開始時のサイクルカウンタ
+	uint32_t	tick;		// 開始時のティック[ms]
+} CPU_LOAD_MEAS;
+
+extern void cpu_load_calibrate(void);
+extern void cpu_load_start(CPU_LOAD_MEAS *p_meas);
+extern uint32_t cpu_load_stop(CPU_LOAD_MEAS *p_meas, uint64_t *p_busy_cyc);
+
+#endif /* APL_CPU_LOAD_H_ */
@@ -0,0 +1,781 @@
+/*
+ * mem_alloc.c
+ *
+ *  Created on: 2026/4/11
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <reent.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "mem_alloc.h"
+
+// ヒープの実装
+// ・領域は静的に確保し(os、.noinit)、先頭をサイズクラスごとのプール、残りをTLSFで管理する
+// ・プール : 固定長ブロックの空きリスト。解放時はアドレスの範囲でどのプールかを判定する (ヘッダなし)
+// ・TLSF : 空きブロックを2段のリスト (第1段はサイズの2のべき、第2段はそれを8分割) とビットマップで管理し、
+//   確保も解放もO(1)。ブロックの先頭にヘッダ(物理的に前のブロック、サイズとフラグ)を置き、解放時に前後の空きと結合する
+// ・newlibの_malloc_r()系とFreeRTOSのpvPortMalloc()系をここで定義して置き換える
+//   (FreeRTOSのheap_4.cはビルドから外している、sysmem.cの_sbrk()は使われない)
+// ・初期化は最初の確保で行う (スケジューラ開始前でもよい)
+// (*) 排他はスケジューラ停止なので、割り込みから確保、解放しないこと
+
+// マクロ
+#define MEM_ALLOC_HEAP_SIZE		(0x6000)	// ヒープ全体[byte]
+#define MEM_ALLOC_ALIGN			(8)			// アライメント[byte]
+
+// 確保した側 (統計用)
+#define MEM_ALLOC_USER_LIBC		(0)		// newlib (malloc())
+#define MEM_ALLOC_USER_OS		(1)		// FreeRTOS (pvPortMalloc())
+#define MEM_ALLOC_USER_NUM		(2)
+
+// TLSF
+#define TLSF_SL_LOG2			(3)										// 第2段の分割数(log2)
+#define TLSF_SL_NUM				(1UL << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT			(TLSF_SL_LOG2 + 3)						// これ未満のサイズは第1段が0 (8byte刻み)
+#define TLSF_SMALL_SIZE			(1UL << TLSF_FL_SHIFT)					// 64byte
+#define TLSF_FL_MAX_LOG2		(15)									// 扱えるサイズは2^15未満
+#define TLSF_FL_NUM				(TLSF_FL_MAX_LOG2 - TLSF_FL_SHIFT + 1)
+#define TLSF_MIN_SIZE			(8)										// ペイロードの最小 (空きリストのリンクが入る)
+
+// TLSFのブロックのフラグ (サイズの下位ビット)
+#define TLSF_BLK_FREE			(1UL << 0)		// 空き
+#define TLSF_BLK_PREV_FREE		(1UL << 1)		// 物理的に前のブロックが空き
+#define TLSF_FLAG_MASK			(MEM_ALLOC_ALIGN - 1)
+
+// TLSFのブロック (ペイロードの先頭に空きリストのリンクを重ねる)
+typedef struct tlsf_blk {
+	struct tlsf_blk	*prev_phys;		// 物理的に前のブロック (前が空きのときだけ有効)
+	uint32_t		size;			// ペイロードのサイズ | フラグ
+	struct tlsf_blk	*next_free;		// 空きリストの次 (空きブロックのみ)
+	struct tlsf_blk	*prev_free;		// 空きリストの前 (空きブロックのみ)
+} TLSF_BLK;
+#define TLSF_HDR_SIZE			(offsetof(TLSF_BLK, next_free))
+#define TLSF_BLK_SIZE(p)		((p)->size & ~TLSF_FLAG_MASK)
+#define TLSF_PAYLOAD(p)			((void *)((uint8_t *)(p) + TLSF_HDR_SIZE))
+#define TLSF_BLK_OF(p)			((TLSF_BLK *)((uint8_t *)(p) - TLSF_HDR_SIZE))
+
+// プールのサイズクラス
+typedef struct {
+	uint32_t	size;		// ブロックサイズ[byte]
+	uint32_t	num;		// ブロック数
+} MEM_ALLOC_CLASS;
+static const MEM_ALLOC_CLASS mem_alloc_class[] = {
+	{ 16, 64},
+	{ 32, 32},
+	{ 64, 32},
+	{128, 16},
+};
+#define MEM_ALLOC_POOL_NUM		(sizeof(mem_alloc_class) / sizeof(mem_alloc_class[0]))
+
+// プールの空きブロック
+typedef struct pool_blk {
+	struct pool_blk	*next;
+} POOL_BLK;
+
+// プール
+typedef struct {
+	uint8_t		*start;		// 先頭
+	uint8_t		*end;		// 終端
+	POOL_BLK	*free;		// 空きリスト
+	uint32_t	used;		// 使用中のブロック数
+	uint32_t	peak;		// 使用中のブロック数の最大
+	uint32_t	fallback;	// 空きがなくTLSFから確保した回数
+} MEM_ALLOC_POOL;
+
+// TLSFの状態 (表示用、ロック中に集計する)
+typedef struct {
+	uint32_t	used_num;					// 使用中のブロック数
+	uint32_t	used_size;					// 使用中のサイズ[byte]
+	uint32_t	free_num;					// 空きブロック数
+	uint32_t	free_size;					// 空きサイズ[byte]
+	uint32_t	largest;					// 最大の空きブロック[byte]
+	uint32_t	fl_num[TLSF_FL_NUM];		// 第1段ごとの空きブロック数
+	uint32_t	fl_size[TLSF_FL_NUM];		// 第1段ごとの空きサイズ[byte]
+	uint32_t	broken;						// ヘッダの不整合
+} MEM_ALLOC_SNAP;
+
+// 制御ブロック
+typedef struct {
+	uint32_t		init;									// 初期化済み
+	MEM_ALLOC_POOL	pool[MEM_ALLOC_POOL_NUM];				// プール
+	uint8_t			*pool_end;								// プール全体の終端
+	uint32_t		pool_free;								// プールの空き[byte]
+	TLSF_BLK		*tlsf_start;							// TLSFの先頭のブロック
+	uint32_t		tlsf_free;								// TLSFの空き[byte] (空きリストにあるブロックの合計)
+	uint32_t		fl_bitmap;								// 空きのある第1段
+	uint32_t		sl_bitmap[TLSF_FL_NUM];					// 空きのある第2段
+	TLSF_BLK		*free_list[TLSF_FL_NUM][TLSF_SL_NUM];	// 空きリスト
+	uint32_t		min_free;								// 空きの最小[byte]
+	uint32_t		alloc_cnt[MEM_ALLOC_USER_NUM];			// 確保回数
+	uint32_t		free_cnt[MEM_ALLOC_USER_NUM];			// 解放回数
+	uint32_t		fail_cnt;								// 確保失敗回数
+	MEM_ALLOC_SNAP	snap;									// 表示用
+} MEM_ALLOC_CB;
+static MEM_ALLOC_CB mem_alloc_cb MEM_PLAN(os);
+#define get_myself() (&mem_alloc_cb)
+
+// ヒープ領域 (管理情報は初期化時に書くのでゼロクリア不要)
+static uint8_t mem_alloc_heap[MEM_ALLOC_HEAP_SIZE] MEM_PLAN_NOINIT(os) __attribute__((aligned(MEM_ALLOC_ALIGN)));
+
+// 確保した側の名前
+static const char * const mem_alloc_user_name[MEM_ALLOC_USER_NUM] = {
+	"libc", "os",
+};
+
+// ロック (入れ子にできる)
+static void mem_alloc_lock(void)
+{
+	vTaskSuspendAll();
+}
+
+// アンロック
+static void mem_alloc_unlock(void)
+{
+	(void)xTaskResumeAll();
+}
+
+// 最上位の1のビット位置
+static uint32_t tlsf_fls(uint32_t val)
+{
+	return (31 - __CLZ(val));
+}
+
+// 最下位の1のビット位置
+static uint32_t tlsf_ffs(uint32_t val)
+{
+	return __CLZ(__RBIT(val));
+}
+
+// サイズから空きリストの位置を求める
+static void tlsf_mapping(uint32_t size, uint32_t *p_fl, uint32_t *p_sl)
+{
+	uint32_t msb;
+	
+	if (size < TLSF_SMALL_SIZE) {
+		*p_fl = 0;
+		*p_sl = size / (TLSF_SMALL_SIZE / TLSF_SL_NUM);
+	} else {
+		msb = tlsf_fls(size);
+		*p_sl = (size >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_NUM;
+		*p_fl = msb - (TLSF_FL_SHIFT - 1);
+	}
+}
+
+// 物理的に次のブロック
+static TLSF_BLK *tlsf_next(TLSF_BLK *p_blk)
+{
+	return (TLSF_BLK *)((uint8_t *)p_blk + TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_blk));
+}
+
+// 空きリストに入れる
+static void tlsf_insert(MEM_ALLOC_CB *this, TLSF_BLK *p_blk)
+{
+	TLSF_BLK *p_head;
+	uint32_t fl, sl;
+	
+	tlsf_mapping(TLSF_BLK_SIZE(p_blk), &fl, &sl);
+	p_head = this->free_list[fl][sl];
+	p_blk->next_free = p_head;
+	p_blk->prev_free = NULL;
+	if (p_head != NULL) {
+		p_head->prev_free = p_blk;
+	}
+	this->free_list[fl][sl] = p_blk;
+	this->fl_bitmap |= (1UL << fl);
+	this->sl_bitmap[fl] |= (1UL << sl);
+	this->tlsf_free += TLSF_BLK_SIZE(p_blk);
+}
+
+// 空きリストから外す
+static void tlsf_remove(MEM_ALLOC_CB *this, TLSF_BLK *p_blk)
+{
+	uint32_t fl, sl;
+	
+	tlsf_mapping(TLSF_BLK_SIZE(p_blk), &fl, &sl);
+	if (p_blk->next_free != NULL) {
+		p_blk->next_free->prev_free = p_blk->prev_free;
+	}
+	if (p_blk->prev_free != NULL) {
+		p_blk->prev_free->next_free = p_blk->next_free;
+	} else {
+		// 先頭だった
+		this->free_list[fl][sl] = p_blk->next_free;
+		if (p_blk->next_free == NULL) {
+			this->sl_bitmap[fl] &= ~(1UL << sl);
+			if (this->sl_bitmap[fl] == 0) {
+				this->fl_bitmap &= ~(1UL << fl);
+			}
+		}
+	}
+	this->tlsf_free -= TLSF_BLK_SIZE(p_blk);
+}
+
+// 使用中のブロックをsizeに切り詰め、余りを空きブロックにする (余りが小さいときは何もしない)
+static void tlsf_split(MEM_ALLOC_CB *this, TLSF_BLK *p_blk, uint32_t size)
+{
+	TLSF_BLK *p_rest, *p_next;
+	uint32_t blk_size = TLSF_BLK_SIZE(p_blk);
+	
+	if (blk_size < size + TLSF_HDR_SIZE + TLSF_MIN_SIZE) {
+		return;
+	}
+	
+	p_blk->size = size | (p_blk->size & TLSF_FLAG_MASK);
+	p_rest = tlsf_next(p_blk);
+	p_rest->size = (blk_size - size - TLSF_HDR_SIZE) | TLSF_BLK_FREE;
+	p_rest->prev_phys = p_blk;
+	
+	// 次も空きなら結合する (縮小のとき)
+	p_next = tlsf_next(p_rest);
+	if (p_next->size & TLSF_BLK_FREE) {
+		tlsf_remove(this, p_next);
+		p_rest->size += TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_next);
+		p_next = tlsf_next(p_rest);
+	}
+	p_next->prev_phys = p_rest;
+	p_next->size |= TLSF_BLK_PREV_FREE;
+	tlsf_insert(this, p_rest);
+}
+
+// TLSFから確保 (sizeはアライメント済み)
+static void *tlsf_alloc(MEM_ALLOC_CB *this, uint32_t size)
+{
+	TLSF_BLK *p_blk;
+	uint32_t search = size;
+	uint32_t fl, sl;
+	uint32_t fl_map, sl_map;
+	
+	// 見つかったリストのどのブロックでも足りるように、第2段の1区間ぶん切り上げて探す
+	if (search >= TLSF_SMALL_SIZE) {
+		search += (1UL << (tlsf_fls(search) - TLSF_SL_LOG2)) - 1;
+	}
+	tlsf_mapping(search, &fl, &sl);
+	if (fl >= TLSF_FL_NUM) {
+		return NULL;
+	}
+	
+	// 同じ第1段の大きい方、なければ大きい第1段の最小
+	sl_map = this->sl_bitmap[fl] & (~0UL << sl);
+	if (sl_map == 0) {
+		fl_map = this->fl_bitmap & (~0UL << (fl + 1));
+		if (fl_map == 0) {
+			return NULL;
+		}
+		fl = tlsf_ffs(fl_map);
+		sl_map = this->sl_bitmap[fl];
+	}
+	sl = tlsf_ffs(sl_map);
+	p_blk = this->free_list[fl][sl];
+	
+	// 使用中にして余りを戻す
+	tlsf_remove(this, p_blk);
+	p_blk->size &= ~TLSF_BLK_FREE;
+	tlsf_next(p_blk)->size &= ~TLSF_BLK_PREV_FREE;
+	tlsf_split(this, p_blk, size);
+	
+	return TLSF_PAYLOAD(p_blk);
+}
+
+// TLSFに解放 (前後の空きブロックと結合する)
+static void tlsf_release(MEM_ALLOC_CB *this, TLSF_BLK *p_blk)
+{
+	TLSF_BLK *p_prev, *p_next;
+	
+	p_blk->size |= TLSF_BLK_FREE;
+	if (p_blk->size & TLSF_BLK_PREV_FREE) {
+		p_prev = p_blk->prev_phys;
+		tlsf_remove(this, p_prev);
+		p_prev->size += TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_blk);
+		p_blk = p_prev;
+	}
+	p_next = tlsf_next(p_blk);
+	if (p_next->size & TLSF_BLK_FREE) {
+		tlsf_remove(this, p_next);
+		p_blk->size += TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_next);
+		p_next = tlsf_next(p_blk);
+	}
+	p_next->prev_phys = p_blk;
+	p_next->size |= TLSF_BLK_PREV_FREE;
+	tlsf_insert(this, p_blk);
+}
+
+// TLSFのブロックをその場で伸縮 (できなければNULL)
+static void *tlsf_resize(MEM_ALLOC_CB *this, TLSF_BLK *p_blk, uint32_t size)
+{
+	TLSF_BLK *p_next;
+	
+	if (size > TLSF_BLK_SIZE(p_blk)) {
+		// 次の空きブロックを取り込む
+		p_next = tlsf_next(p_blk);
+		if (((p_next->size & TLSF_BLK_FREE) == 0) ||
+		    (TLSF_BLK_SIZE(p_blk) + TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_next) < size)) {
+			return NULL;
+		}
+		tlsf_remove(this, p_next);
+		p_blk->size += TLSF_HDR_SIZE + TLSF_BLK_SIZE(p_next);
+		tlsf_next(p_blk)->size &= ~TLSF_BLK_PREV_FREE;
+	}
+	tlsf_split(this, p_blk, size);
+	
+	return TLSF_PAYLOAD(p_blk);
+}
+
+// 初期化
+static void mem_alloc_init(MEM_ALLOC_CB *this)
+{
+	MEM_ALLOC_POOL *p_pool;
+	POOL_BLK *p_pool_blk;
+	TLSF_BLK *p_blk, *p_end;
+	uint8_t *p = mem_alloc_heap;
+	uint32_t i, j;
+	
+	// プール (ヒープの先頭から順に切り出す)
+	for (i = 0; i < MEM_ALLOC_POOL_NUM; i++) {
+		p_pool = &(this->pool[i]);
+		p_pool->start = p;
+		for (j = 0; j < mem_alloc_class[i].num; j++) {
+			p_pool_blk = (POOL_BLK *)p;
+			p_pool_blk->next = p_pool->free;
+			p_pool->free = p_pool_blk;
+			p += mem_alloc_class[i].size;
+		}
+		p_pool->end = p;
+		this->pool_free += mem_alloc_class[i].size * mem_alloc_class[i].num;
+	}
+	this->pool_end = p;
+	
+	// TLSF (残り全体を1つの空きブロックにし、終端に番兵として大きさ0の使用中ブロックを置く)
+	p_blk = (TLSF_BLK *)p;
+	p_blk->prev_phys = NULL;
+	p_blk->size = ((uint32_t)(&mem_alloc_heap[MEM_ALLOC_HEAP_SIZE] - p) - (TLSF_HDR_SIZE * 2)) | TLSF_BLK_FREE;
+	p_end = tlsf_next(p_blk);
+	p_end->prev_phys = p_blk;
+	p_end->size = TLSF_BLK_PREV_FREE;
+	this->tlsf_start = p_blk;
+	tlsf_insert(this, p_blk);
+	
+	this->min_free = this->pool_free + this->tlsf_free;
+	this->init = 1;
+}
+
+// プールのブロックか (プールのインデックス、プール外はMEM_ALLOC_POOL_NUM)
+static uint32_t mem_alloc_which_pool(MEM_ALLOC_CB *this, void *ptr)
+{
+	uint32_t i;
+	
+	if (((uint8_t *)ptr < this->pool[0].start) || ((uint8_t *)ptr >= this->pool_end)) {
+		return MEM_ALLOC_POOL_NUM;
+	}
+	for (i = 0; i < MEM_ALLOC_POOL_NUM; i++) {
+		if ((uint8_t *)ptr < this->pool[i].end) {
+			break;
+		}
+	}
+	
+	return i;
+}
+
+// 確保 (ロックは内部で取る、ネストしてもよい)
+static void *mem_alloc_get(size_t size, uint32_t user)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	MEM_ALLOC_POOL *p_pool;
+	POOL_BLK *p_pool_blk;
+	void *ptr = NULL;
+	uint32_t i;
+	
+	mem_alloc_lock();
+	
+	if (this->init == 0) {
+		mem_alloc_init(this);
+	}
+	
+	if (size <= MEM_ALLOC_HEAP_SIZE) {
+		size = (size + MEM_ALLOC_ALIGN - 1) & ~(MEM_ALLOC_ALIGN - 1);
+		if (size < TLSF_MIN_SIZE) {
+			size = TLSF_MIN_SIZE;
+		}
+		
+		// 収まる最小のサイズクラス (空きがなければTLSF)
+		for (i = 0; i < MEM_ALLOC_POOL_NUM; i++) {
+			if (size <= mem_alloc_class[i].size) {
+				p_pool = &(this->pool[i]);
+				p_pool_blk = p_pool->free;
+				if (p_pool_blk == NULL) {
+					p_pool->fallback++;
+					break;
+				}
+				p_pool->free = p_pool_blk->next;
+				this->pool_free -= mem_alloc_class[i].size;
+				if (++p_pool->used > p_pool->peak) {
+					p_pool->peak = p_pool->used;
+				}
+				ptr = p_pool_blk;
+				break;
+			}
+		}
+		if (ptr == NULL) {
+			ptr = tlsf_alloc(this, size);
+		}
+	}
+	
+	if (ptr != NULL) {
+		this->alloc_cnt[user]++;
+		if (this->pool_free + this->tlsf_free < this->min_free) {
+			this->min_free = this->pool_free + this->tlsf_free;
+		}
+	} else {
+		this->fail_cnt++;
+	}
+	
+	mem_alloc_unlock();
+	
+	return ptr;
+}
+
+// 解放
+static void mem_alloc_put(void *ptr, uint32_t user)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	MEM_ALLOC_POOL *p_pool;
+	POOL_BLK *p_pool_blk;
+	uint32_t i;
+	
+	if (ptr == NULL) {
+		return;
+	}
+	
+	mem_alloc_lock();
+	
+	i = mem_alloc_which_pool(this, ptr);
+	if (i < MEM_ALLOC_POOL_NUM) {
+		p_pool = &(this->pool[i]);
+		p_pool_blk = (POOL_BLK *)ptr;
+		p_pool_blk->next = p_pool->free;
+		p_pool->free = p_pool_blk;
+		p_pool->used--;
+		this->pool_free += mem_alloc_class[i].size;
+	} else {
+		tlsf_release(this, TLSF_BLK_OF(ptr));
+	}
+	this->free_cnt[user]++;
+	
+	mem_alloc_unlock();
+}
+
+// 確保済みブロックの使えるサイズ
+static uint32_t mem_alloc_usable(void *ptr)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	uint32_t i;
+	
+	i = mem_alloc_which_pool(this, ptr);
+	if (i < MEM_ALLOC_POOL_NUM) {
+		return mem_alloc_class[i].size;
+	}
+	
+	return TLSF_BLK_SIZE(TLSF_BLK_OF(ptr));
+}
+
+// 再確保 (その場で伸縮できなければ確保してコピー)
+static void *mem_alloc_reget(void *ptr, size_t size, uint32_t user)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	void *p_new = NULL;
+	uint32_t cur;
+	
+	if (ptr == NULL) {
+		return mem_alloc_get(size, user);
+	}
+	if (size == 0) {
+		mem_alloc_put(ptr, user);
+		return NULL;
+	}
+	if (size > MEM_ALLOC_HEAP_SIZE) {
+		mem_alloc_lock();
+		this->fail_cnt++;
+		mem_alloc_unlock();
+		return NULL;
+	}
+	size = (size + MEM_ALLOC_ALIGN - 1) & ~(MEM_ALLOC_ALIGN - 1);
+	
+	mem_alloc_lock();
+	cur = mem_alloc_usable(ptr);
+	if (mem_alloc_which_pool(this, ptr) < MEM_ALLOC_POOL_NUM) {
+		if (size <= cur) {
+			p_new = ptr;
+		}
+	} else {
+		p_new = tlsf_resize(this, TLSF_BLK_OF(ptr), (size < TLSF_MIN_SIZE) ? TLSF_MIN_SIZE : size);
+		if ((p_new != NULL) && (this->pool_free + this->tlsf_free < this->min_free)) {
+			this->min_free = this->pool_free + this->tlsf_free;
+		}
+	}
+	mem_alloc_unlock();
+	
+	if (p_new == NULL) {
+		p_new = mem_alloc_get(size, user);
+		if (p_new != NULL) {
+			memcpy(p_new, ptr, (size < cur) ? size : cur);
+			mem_alloc_put(ptr, user);
+		}
+	}
+	
+	return p_new;
+}
+
+// newlibのロック (malloc()系はこのファイルで置き換えているが、newlibの中から呼ばれても同じロックになるようにする)
+void __malloc_lock(struct _reent *r)
+{
+	mem_alloc_lock();
+}
+
+void __malloc_unlock(struct _reent *r)
+{
+	mem_alloc_unlock();
+}
+
+// newlibの確保関数の置き換え
+void *_malloc_r(struct _reent *r, size_t size)
+{
+	void *ptr;
+	
+	ptr = mem_alloc_get(size, MEM_ALLOC_USER_LIBC);
+	if (ptr == NULL) {
+		r->_errno = ENOMEM;
+	}
+	
+	return ptr;
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+	mem_alloc_put(ptr, MEM_ALLOC_USER_LIBC);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+	void *p_new;
+	
+	p_new = mem_alloc_reget(ptr, size, MEM_ALLOC_USER_LIBC);
+	if ((p_new == NULL) && (size != 0)) {
+		r->_errno = ENOMEM;
+	}
+	
+	return p_new;
+}
+
+void *_calloc_r(struct _reent *r, size_t num, size_t size)
+{
+	void *ptr;
+	
+	if ((size != 0) && (num > SIZE_MAX / size)) {
+		r->_errno = ENOMEM;
+		return NULL;
+	}
+	ptr = _malloc_r(r, num * size);
+	if (ptr != NULL) {
+		memset(ptr, 0, num * size);
+	}
+	
+	return ptr;
+}
+
+void *malloc(size_t size)
+{
+	return _malloc_r(_REENT, size);
+}
+
+void free(void *ptr)
+{
+	_free_r(_REENT, ptr);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	return _realloc_r(_REENT, ptr, size);
+}
+
+void *calloc(size_t num, size_t size)
+{
+	return _calloc_r(_REENT, num, size);
+}
+
+// FreeRTOSの確保関数 (heap_4.cの置き換え、traceMALLOC()はスケジューラ停止中に呼ぶ)
+void *pvPortMalloc(size_t xWantedSize)
+{
+	void *ptr;
+	
+	mem_alloc_lock();
+	ptr = mem_alloc_get(xWantedSize, MEM_ALLOC_USER_OS);
+	traceMALLOC(ptr, xWantedSize);
+	mem_alloc_unlock();
+	
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+	if (ptr == NULL) {
+		extern void vApplicationMallocFailedHook(void);
+		vApplicationMallocFailedHook();
+	}
+#endif
+	
+	return ptr;
+}
+
+void vPortFree(void *pv)
+{
+	if (pv == NULL) {
+		return;
+	}
+	
+	mem_alloc_lock();
+	traceFREE(pv, mem_alloc_usable(pv));
+	mem_alloc_put(pv, MEM_ALLOC_USER_OS);
+	mem_alloc_unlock();
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	
+	if (this->init == 0) {
+		return MEM_ALLOC_HEAP_SIZE;
+	}
+	
+	return (this->pool_free + this->tlsf_free);
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+	MEM_ALLOC_CB *this = get_myself();
+	
+	if (this->init == 0) {
+		return MEM_ALLOC_HEAP_SIZE;
+	}
+	
+	return this->min_free;
+}
+
+// ヒープ全体のサイズ
+uint32_t mem_alloc_get_size(void)
+{
+	return MEM_ALLOC_HEAP_SIZE;
+}
+
+// TLSFのブロックを先頭からたどって集計する (ロック中に呼ぶこと)
+static void mem_alloc_walk(MEM_ALLOC_CB *this, MEM_ALLOC_SNAP *p_snap)
+{
+	TLSF_BLK *p_blk, *p_prev = NULL;
+	uint32_t size, fl, sl;
+	uint32_t prev_free = 0;
+	
+	memset(p_snap, 0, sizeof(MEM_ALLOC_SNAP));
+	for (p_blk = this->tlsf_start; TLSF_BLK_SIZE(p_blk) != 0; p_blk = tlsf_next(p_blk)) {
+		size = TLSF_BLK_SIZE(p_blk);
+		
+		// 前のブロックの空きフラグと結合漏れ (空き同士が隣り合わない) の確認
+		if ((((p_blk->size & TLSF_BLK_PREV_FREE) != 0) != prev_free) ||
+		    (prev_free && (p_blk->size & TLSF_BLK_FREE)) ||
+		    (prev_free && (p_blk->prev_phys != p_prev))) {
+			p_snap->broken++;
+		}
+		
+		if (p_blk->size & TLSF_BLK_FREE) {
+			tlsf_mapping(size, &fl, &sl);
+			p_snap->free_num++;
+			p_snap->free_size += size;
+			p_snap->fl_num[fl]++;
+			p_snap->fl_size[fl] += size;
+			if (size > p_snap->largest) {
+				p_snap->largest = size;
+			}
+			prev_free = 1;
+		} else {
+			p_snap->used_num++;
+			p_snap->used_size += size;
+			prev_free = 0;
+		}
+		p_prev = p_blk;
+		
+		// 番兵を越えたら壊れている
+		if ((uint8_t *)p_blk >= &mem_alloc_heap[MEM_ALLOC_HEAP_SIZE]) {
+			p_snap->broken++;
+			break;
+		}
+	}
+	
+	// 空きリストの合計と一致するか
+	if (p_snap->free_size != this->tlsf_free) {
+		p_snap->broken++;
+	}
+}
+
+// ヒープの統計表示コマンド
+// heap [frag]
+static void mem_alloc_cmd(int argc, char *argv[])
+{
+	MEM_ALLOC_CB *this = get_myself();
+	MEM_ALLOC_SNAP *p_snap = &(this->snap);
+	MEM_ALLOC_POOL *p_pool;
+	uint32_t free_size, frag = 0;
+	uint32_t i;
+	
+	mem_alloc_lock();
+	if (this->init == 0) {
+		mem_alloc_init(this);
+	}
+	mem_alloc_walk(this, p_snap);
+	free_size = this->pool_free + this->tlsf_free;
+	mem_alloc_unlock();
+	
+	console_printf("heap : %u byte, free %u (min %u)\n", MEM_ALLOC_HEAP_SIZE, free_size, this->min_free);
+	for (i = 0; i < MEM_ALLOC_USER_NUM; i++) {
+		console_printf(" %s : alloc %u, free %u\n", mem_alloc_user_name[i], this->alloc_cnt[i], this->free_cnt[i]);
+	}
+	console_printf(" fail : %u\n", this->fail_cnt);
+	
+	// プール
+	for (i = 0; i < MEM_ALLOC_POOL_NUM; i++) {
+		p_pool = &(this->pool[i]);
+		console_printf(" pool %u : %u / %u (peak %u), fallback %u\n", mem_alloc_class[i].size,
+		               p_pool->used, mem_alloc_class[i].num, p_pool->peak, p_pool->fallback);
+	}
+	
+	// TLSF (断片化率 = 最大の空きブロックに入らない空きの割合)
+	if (p_snap->free_size != 0) {
+		frag = 100 - (uint32_t)(((uint64_t)p_snap->largest * 100) / p_snap->free_size);
+	}
+	console_printf(" tlsf : used %u blocks %u byte, free %u blocks %u byte\n",
+	               p_snap->used_num, p_snap->used_size, p_snap->free_num, p_snap->free_size);
+	console_printf(" tlsf : largest %u, fragmentation %u%%\n", p_snap->largest, frag);
+	if (p_snap->broken != 0) {
+		console_printf(" tlsf : BROKEN (%u)\n", p_snap->broken);
+	}
+	
+	// 空きブロックのサイズ分布
+	if ((argc >= 2) && (strcmp(argv[1], "frag") == 0)) {
+		for (i = 0; i < TLSF_FL_NUM; i++) {
+			if (p_snap->fl_num[i] == 0) {
+				continue;
+			}
+			console_printf("  %u - %u : %u blocks %u byte\n", (i == 0) ? 0 : (TLSF_SMALL_SIZE << (i - 1)),
+			               (TLSF_SMALL_SIZE << i) - 1, p_snap->fl_num[i], p_snap->fl_size[i]);
+		}
+	}
+}
+
+// コマンド設定関数
+void mem_alloc_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "heap";
+	cmd.func = mem_alloc_cmd;
+	console_set_command(&cmd);
+}
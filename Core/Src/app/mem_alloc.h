@@ -0,0 +1,19 @@
+/*
+ * mem_alloc.h
+ *
+ *  Created on: 2026/4/11
+ *      Author: user
+ */
+
+#ifndef APL_MEM_ALLOC_H_
+#define APL_MEM_ALLOC_H_
+
+// ヒープ (newlibのmalloc()とFreeRTOSのpvPortMalloc()の両方がここから確保する)
+// ・小さいサイズはサイズクラスごとの固定長プールから、それ以外(プールが空のときも)はTLSFから確保する
+// ・排他はスケジューラ停止 (newlibの__malloc_lock()/__malloc_unlock()も同じ)
+// (*) 割り込みからは使えない
+
+extern uint32_t mem_alloc_get_size(void);
+extern void mem_alloc_set_cmd(void);
+
+#endif /* APL_MEM_ALLOC_H_ */
@@ -0,0 +1,157 @@
+/*
+ * mem_plan.c
+ *
+ *  Created on: 2026/2/28
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "mem_alloc.h"
+
+// サブシステムごとのRAM使用量の表示と、起動後のヒープ確保の検出
+// ・セクションの範囲と予算はリンカスクリプトのシンボルから取る (使用量は.bssとゼロクリアしない領域の合計)
+// ・mem_plan_lock()以降のpvPortMalloc()はホットパスでの確保とみなして数える (traceMALLOCから呼ばれる)
+
+// リンカスクリプトのシンボル
+#define MEM_PLAN_SYM(subsys) \
+	extern uint8_t __mem_plan_##subsys##_start__[]; \
+	extern uint8_t __mem_plan_##subsys##_end__[]; \
+	extern uint8_t _mem_budget_##subsys[]
+#define MEM_PLAN_NOINIT_SYM(subsys) \
+	extern uint8_t __mem_plan_##subsys##_noinit_start__[]; \
+	extern uint8_t __mem_plan_##subsys##_noinit_end__[]
+MEM_PLAN_SYM(os);
+MEM_PLAN_SYM(eth);
+MEM_PLAN_SYM(net);
+MEM_PLAN_SYM(app);
+MEM_PLAN_SYM(test);
+MEM_PLAN_SYM(pkt);
+MEM_PLAN_NOINIT_SYM(os);
+MEM_PLAN_NOINIT_SYM(eth);
+MEM_PLAN_NOINIT_SYM(net);
+MEM_PLAN_NOINIT_SYM(app);
+MEM_PLAN_NOINIT_SYM(test);
+extern uint8_t __noinit_start__[];
+extern uint8_t __noinit_end__[];
+extern uint8_t _sdata[];
+extern uint8_t _edata[];
+extern uint8_t _sbss[];
+extern uint8_t _ebss[];
+extern uint8_t _estack[];
+extern uint8_t _Min_Stack_Size[];
+extern uint8_t end[];
+
+// サブシステム情報
+typedef struct {
+	const char	*name;		// 名前
+	uint8_t		*start;		// 先頭
+	uint8_t		*end;		// 終端
+	uint8_t		*noinit_start;	// ゼロクリアしない領域の先頭
+	uint8_t		*noinit_end;	// ゼロクリアしない領域の終端
+	uint8_t		*budget;	// 予算[byte] (シンボルのアドレスが値)
+} MEM_PLAN_INFO;
+#define MEM_PLAN_INFO_ENTRY(subsys) \
+	{#subsys, __mem_plan_##subsys##_start__, __mem_plan_##subsys##_end__, \
+	 __mem_plan_##subsys##_noinit_start__, __mem_plan_##subsys##_noinit_end__, _mem_budget_##subsys}
+
+static const MEM_PLAN_INFO mem_plan_info[] = {
+	MEM_PLAN_INFO_ENTRY(os),
+	MEM_PLAN_INFO_ENTRY(eth),
+	MEM_PLAN_INFO_ENTRY(net),
+	MEM_PLAN_INFO_ENTRY(app),
+	MEM_PLAN_INFO_ENTRY(test),
+	{"pkt", __mem_plan_pkt_start__, __mem_plan_pkt_end__, NULL, NULL, _mem_budget_pkt},
+};
+#define MEM_PLAN_INFO_NUM	(sizeof(mem_plan_info) / sizeof(mem_plan_info[0]))
+
+// 制御ブロック
+typedef struct {
+	uint32_t			locked;			// 起動完了
+	volatile uint32_t	boot_alloc_cnt;	// 起動中の確保回数
+	volatile uint32_t	late_alloc_cnt;	// 起動後の確保回数
+	volatile uint32_t	late_alloc_size;// 起動後の確保サイズ合計[byte]
+	volatile uint32_t	fail_cnt;		// 確保失敗回数
+} MEM_PLAN_CB;
+static MEM_PLAN_CB mem_plan_cb MEM_PLAN(os);
+#define get_myself() (&mem_plan_cb)
+
+// ヒープ確保のトレース (FreeRTOSConfig.hのtraceMALLOCから呼ばれる、スケジューラ停止中)
+void mem_plan_trace_malloc(void *p_addr, uint32_t size)
+{
+	MEM_PLAN_CB *this = get_myself();
+	
+	if (p_addr == NULL) {
+		this->fail_cnt++;
+	}
+	if (this->locked) {
+		this->late_alloc_cnt++;
+		this->late_alloc_size += size;
+	} else {
+		this->boot_alloc_cnt++;
+	}
+}
+
+// 起動完了 (これ以降のヒープ確保を数える)
+void mem_plan_lock(void)
+{
+	MEM_PLAN_CB *this = get_myself();
+	
+	this->locked = 1;
+}
+
+// RAM使用量の表示
+void mem_plan_report(void)
+{
+	MEM_PLAN_CB *this = get_myself();
+	const MEM_PLAN_INFO *p_info;
+	uint32_t i;
+	uint32_t used, noinit, budget;
+	uint32_t plan_total = 0;
+	uint32_t static_total, ram_total, free_size;
+	
+	console_printf("subsys  used / budget [byte]\n");
+	for (i = 0; i < MEM_PLAN_INFO_NUM; i++) {
+		p_info = &(mem_plan_info[i]);
+		noinit = (uint32_t)(p_info->noinit_end - p_info->noinit_start);
+		used = (uint32_t)(p_info->end - p_info->start) + noinit;
+		budget = (uint32_t)p_info->budget;
+		plan_total += used;
+		console_printf(" %s : %u / %u (%u%%), noinit %u\n", p_info->name, used, budget, (budget != 0) ? (used * 100 / budget) : 0, noinit);
+	}
+	
+	// 計画外 (.data、サブシステム指定のない.bss、.noinit)
+	static_total = (uint32_t)(_edata - _sdata) + (uint32_t)(_ebss - _sbss) + (uint32_t)(__noinit_end__ - __noinit_start__) +
+	               (uint32_t)(__mem_plan_pkt_end__ - __mem_plan_pkt_start__);
+	console_printf(" other : %u\n", static_total - plan_total);
+	
+	// 全体 (静的領域の終端からMSPのスタックまでが空き)
+	ram_total = (uint32_t)(_estack - _sdata);
+	free_size = (uint32_t)(_estack - end) - (uint32_t)_Min_Stack_Size;
+	console_printf(" total : %u / %u, free %u\n", static_total, ram_total, free_size);
+	
+	// ヒープ
+	console_printf("heap : %u, free %u, min free %u\n", mem_alloc_get_size(),
+	               (uint32_t)xPortGetFreeHeapSize(), (uint32_t)xPortGetMinimumEverFreeHeapSize());
+	console_printf("heap alloc : boot %u, after boot %u (%u byte), fail %u\n",
+	               this->boot_alloc_cnt, this->late_alloc_cnt, this->late_alloc_size, this->fail_cnt);
+}
+
+// RAM使用量表示コマンド
+static void mem_plan_cmd(int argc, char *argv[])
+{
+	mem_plan_report();
+}
+
+// コマンド設定関数
+void mem_plan_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "mem";
+	cmd.func = mem_plan_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,55 @@
+/*
+ * mem_plan.h
+ *
+ *  Created on: 2026/2/28
+ *      Author: user
+ */
+
+#ifndef APL_MEM_PLAN_H_
+#define APL_MEM_PLAN_H_
+
+// RAM配置計画
+// ・カーネルオブジェクト(スタック、TCB、キュー)はすべて静的に確保し、サブシステムごとのセクションに置く
+// ・リンカスクリプトでセクションごとに集めて予算(_mem_budget_xxx)を超えたらリンクエラーにする
+// ・サブシステム : os, eth, net, app, test (パケットバッファは.pkt_bufセクション)
+// ・使う前に必ず書き込むバッファ(スタック、ヒープなど)はMEM_PLAN_NOINIT()にして起動時のゼロクリアを省く
+//   (予算は同じサブシステムの.bssと合わせて判定する)
+// (*) サブシステムを追加した場合はリンカスクリプト(FLASH/RAM両方)とmem_plan.cの表も追加すること
+
+// サブシステムのセクションに置く (ゼロ初期化される変数のみ)
+#define MEM_PLAN(subsys)	__attribute__((section(".bss.plan." #subsys)))
+
+// サブシステムのセクションに置く (起動時にゼロクリアしない、初期値は不定)
+#define MEM_PLAN_NOINIT(subsys)	__attribute__((section(".noinit.plan." #subsys)))
+
+// ITCMに置く関数 (起動時にFLASHからコピーされる、ウェイトなしで実行したいホットパス用)
+#define MEM_PLAN_ITCM		__attribute__((section(".itcm_text"), noinline))
+
+// 静的スレッド定義 (osThreadDef()の置き換え、stacksz[word])
+// スタックはタスク作成時にカーネルが埋めるのでゼロクリアしない
+#define MEM_PLAN_THREAD(subsys, name, thread, priority, stacksz) \
+	static uint32_t name##_stack[stacksz] MEM_PLAN_NOINIT(subsys) __attribute__((aligned(8))); \
+	static osStaticThreadDef_t name##_tcb MEM_PLAN(subsys); \
+	osThreadStaticDef(name, thread, priority, 0, stacksz, name##_stack, &name##_tcb)
+
+// 静的ミューテックス定義 (osMutexDef()の置き換え)
+#define MEM_PLAN_MUTEX(subsys, name) \
+	static osStaticMutexDef_t name##_mutex_cb MEM_PLAN(subsys); \
+	osMutexStaticDef(name, &name##_mutex_cb)
+
+// 静的セマフォ定義 (osSemaphoreDef()の置き換え)
+#define MEM_PLAN_SEMAPHORE(subsys, name) \
+	static osStaticSemaphoreDef_t name##_sem_cb MEM_PLAN(subsys); \
+	osSemaphoreStaticDef(name, &name##_sem_cb)
+
+// 静的メッセージキュー定義 (osMessageQDef()の置き換え)
+#define MEM_PLAN_MESSAGE_Q(subsys, name, queue_sz, type) \
+	static uint8_t name##_que_buf[(queue_sz) * sizeof(type)] MEM_PLAN(subsys) __attribute__((aligned(4))); \
+	static osStaticMessageQDef_t name##_que_cb MEM_PLAN(subsys); \
+	osMessageQStaticDef(name, queue_sz, type, name##_que_buf, &name##_que_cb)
+
+extern void mem_plan_lock(void);
+extern void mem_plan_report(void);
+extern void mem_plan_set_cmd(void);
+
+#endif /* APL_MEM_PLAN_H_ */
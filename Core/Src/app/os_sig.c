@@ -0,0 +1,240 @@
+/*
+ * os_sig.c
+ *
+ *  Created on: 2026/2/21
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "os_sig.h"
+
+// タスク通知(xTaskNotifyGive/ulTaskNotifyTake)を直接使ったイベント通知
+// ・通知するイベントは待ち合わせ情報に書き、タスク通知は起床だけに使う
+//   (osSignalWait()は待っていないビットの通知でも起床してしまい、呼び出し側で判定が必要だった)
+// ・待ち合わせ情報は要求ごとに用意するので、同じドライバを複数のタスクが使っても通知先を取り違えない
+// (*) タスク通知の値はこのモジュールが使うので、同じタスクでosSignalSet()/osSignalWait()と混在させないこと
+
+// マクロ
+#define OS_SIG_BENCH_NUM_MAX	(1000)				// ベンチマークの最大回数
+#define OS_SIG_BENCH_IRQn		(CEC_IRQn)			// ベンチマークで使う割り込み (未使用のもの)
+#define OS_SIG_BENCH_IRQ_PRIO	(6)					// ベンチマークの割り込み優先度 (FreeRTOSのAPIを呼べる範囲)
+#define OS_SIG_BENCH_EVT		(1UL << 0)
+
+// ベンチマークの方式
+#define BENCH_MODE_SIGNAL		(0)		// osSignalSet() / osSignalWait()
+#define BENCH_MODE_NOTIFY		(1)		// os_sig_set() / os_sig_wait()
+#define BENCH_MODE_NUM			(2)
+
+// ベンチマーク制御ブロック
+typedef struct {
+	osThreadId			thread_id;		// 待ちスレッド
+	OS_SIG_WAITER		waiter;			// 待ち合わせ情報
+	volatile uint32_t	mode;			// 方式
+	volatile uint32_t	ready;			// 待ちスレッドが待ちに入る直前
+	volatile uint32_t	isr_cyc;		// 割り込み発生時のサイクルカウンタ
+	volatile uint32_t	wake_cyc;		// 起床までのサイクル数
+	volatile uint32_t	done;			// 計測完了
+} OS_SIG_BENCH_CB;
+static OS_SIG_BENCH_CB os_sig_bench_cb MEM_PLAN(app);
+#define get_bench() (&os_sig_bench_cb)
+
+// 割り込みコンテキストか
+static inline uint32_t os_sig_in_isr(void)
+{
+	return (__get_IPSR() != 0) ? 1 : 0;
+}
+
+// 待ち準備 (通知を要求する前に呼ぶ)
+void os_sig_prepare(OS_SIG_WAITER *p_waiter)
+{
+	p_waiter->bits = 0;
+	p_waiter->task = xTaskGetCurrentTaskHandle();
+	
+	// 前回の要求の残った通知を捨てる
+	(void)ulTaskNotifyTake(pdTRUE, 0);
+}
+
+// イベント通知 (割り込み、タスクどちらからでも呼べる)
+void os_sig_set(OS_SIG_WAITER *p_waiter, uint32_t bits)
+{
+	BaseType_t woken = pdFALSE;
+	uint32_t primask;
+	
+	if ((p_waiter == NULL) || (p_waiter->task == NULL)) {
+		return;
+	}
+	
+	if (os_sig_in_isr()) {
+		p_waiter->bits |= bits;
+		vTaskNotifyGiveFromISR(p_waiter->task, &woken);
+		portYIELD_FROM_ISR(woken);
+	} else {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		p_waiter->bits |= bits;
+		__set_PRIMASK(primask);
+		xTaskNotifyGive(p_waiter->task);
+	}
+}
+
+// イベント待ち
+// mask  : 待つイベント (どれか1つで戻る)
+// tmout : タイムアウト[ms] (負の値は無限待ち)
+// 戻り値 : 通知されたイベント (maskの範囲、0はタイムアウト)
+uint32_t os_sig_wait(OS_SIG_WAITER *p_waiter, uint32_t mask, int32_t tmout)
+{
+	TickType_t start = xTaskGetTickCount();
+	TickType_t ticks;
+	TickType_t elapsed;
+	uint32_t bits;
+	uint32_t primask;
+	
+	while (1) {
+		// 通知済みのイベントを取り出す (割り込み禁止中に呼ばれてもよいように元に戻す)
+		primask = __get_PRIMASK();
+		__disable_irq();
+		bits = p_waiter->bits & mask;
+		p_waiter->bits &= ~bits;
+		__set_PRIMASK(primask);
+		if (bits != 0) {
+			break;
+		}
+		
+		// 残り時間
+		if (tmout < 0) {
+			ticks = portMAX_DELAY;
+		} else {
+			elapsed = xTaskGetTickCount() - start;
+			if (elapsed >= pdMS_TO_TICKS(tmout)) {
+				break;
+			}
+			ticks = pdMS_TO_TICKS(tmout) - elapsed;
+		}
+		
+		// 起床待ち
+		(void)ulTaskNotifyTake(pdTRUE, ticks);
+	}
+	
+	return bits;
+}
+
+// ベンチマークの割り込みハンドラ
+void CEC_IRQHandler(void)
+{
+	OS_SIG_BENCH_CB *this = get_bench();
+	
+	this->isr_cyc = DWT->CYCCNT;
+	if (this->mode == BENCH_MODE_SIGNAL) {
+		osSignalSet(this->thread_id, OS_SIG_BENCH_EVT);
+	} else {
+		os_sig_set(&(this->waiter), OS_SIG_BENCH_EVT);
+	}
+}
+
+// ベンチマークの待ちスレッド (コマンドのスレッドより高い優先度)
+static void os_sig_bench_thread(void const *argument)
+{
+	OS_SIG_BENCH_CB *this = get_bench();
+	
+	while (1) {
+		if (this->mode == BENCH_MODE_SIGNAL) {
+			this->ready = 1;
+			osSignalWait(OS_SIG_BENCH_EVT, osWaitForever);
+		} else {
+			os_sig_prepare(&(this->waiter));
+			this->ready = 1;
+			os_sig_wait(&(this->waiter), OS_SIG_BENCH_EVT, -1);
+		}
+		this->wake_cyc = DWT->CYCCNT - this->isr_cyc;
+		this->done = 1;
+	}
+}
+
+// 割り込みからタスク起床までのサイクル数のベンチマーク
+// osSignalSet/osSignalWait と os_sig_set/os_sig_wait を比較する
+static void os_sig_bench_cmd(int argc, char *argv[])
+{
+	OS_SIG_BENCH_CB *this = get_bench();
+	static const char * const mode_name[BENCH_MODE_NUM] = {"osSignal", "os_sig"};
+	uint32_t num;
+	uint32_t i, mode;
+	uint32_t cyc, cyc_min, cyc_max;
+	uint64_t sum;
+	
+	// 引数チェック
+	if (argc < 2) {
+		console_printf("os_sig_bench <num>\n");
+		return;
+	}
+	num = atoi(argv[1]);
+	if ((num == 0) || (num > OS_SIG_BENCH_NUM_MAX)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	// 割り込み設定
+	HAL_NVIC_SetPriority(OS_SIG_BENCH_IRQn, OS_SIG_BENCH_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(OS_SIG_BENCH_IRQn);
+	
+	// 待ちスレッド作成
+	if (this->thread_id == NULL) {
+		this->mode = BENCH_MODE_SIGNAL;
+		MEM_PLAN_THREAD(app, sig_bench, os_sig_bench_thread, osPriorityRealtime, 256);
+		this->thread_id = osThreadCreate(osThread(sig_bench), NULL);
+	}
+	
+	for (mode = 0; mode < BENCH_MODE_NUM; mode++) {
+		// 方式切り替え (前の方式の待ちを一度起こす)
+		this->ready = 0;
+		this->mode = mode;
+		if (mode == BENCH_MODE_NOTIFY) {
+			osSignalSet(this->thread_id, OS_SIG_BENCH_EVT);
+		} else {
+			os_sig_set(&(this->waiter), OS_SIG_BENCH_EVT);
+		}
+		osDelay(2);
+		
+		cyc_min = 0xFFFFFFFF;
+		cyc_max = 0;
+		sum = 0;
+		for (i = 0; i < num; i++) {
+			// 待ちに入るのを待ってから割り込みを発生させる
+			while (this->ready == 0) {
+				osDelay(1);
+			}
+			osDelay(1);
+			this->ready = 0;
+			this->done = 0;
+			NVIC_SetPendingIRQ(OS_SIG_BENCH_IRQn);
+			while (this->done == 0) {
+				osDelay(1);
+			}
+			cyc = this->wake_cyc;
+			sum += cyc;
+			if (cyc < cyc_min) {
+				cyc_min = cyc;
+			}
+			if (cyc > cyc_max) {
+				cyc_max = cyc;
+			}
+		}
+		console_printf("%s: isr->task cycles min:%u avg:%u max:%u\n", mode_name[mode], cyc_min, (uint32_t)(sum / num), cyc_max);
+	}
+	
+	HAL_NVIC_DisableIRQ(OS_SIG_BENCH_IRQn);
+}
+
+// コマンド設定関数
+void os_sig_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "os_sig_bench";
+	cmd.func = os_sig_bench_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,22 @@
+/*
+ * os_sig.h
+ *
+ *  Created on: 2026/2/21
+ *      Author: user
+ */
+
+#ifndef APL_OS_SIG_H_
+#define APL_OS_SIG_H_
+
+// 待ち合わせ情報 (要求ごとに待つ側のスタックに置き、通知する側に渡す)
+typedef struct {
+	TaskHandle_t		task;	// 待ちタスク
+	volatile uint32_t	bits;	// 通知されたイベント
+} OS_SIG_WAITER;
+
+extern void os_sig_prepare(OS_SIG_WAITER *p_waiter);
+extern void os_sig_set(OS_SIG_WAITER *p_waiter, uint32_t bits);
+extern uint32_t os_sig_wait(OS_SIG_WAITER *p_waiter, uint32_t mask, int32_t tmout);
+extern void os_sig_set_cmd(void);
+
+#endif /* APL_OS_SIG_H_ */
@@ -0,0 +1,190 @@
+/*
+ * os_stat.c
+ *
+ *  Created on: 2026/3/7
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "trace.h"
+#include "os_stat.h"
+
+// FreeRTOSの実行時間統計 (configGENERATE_RUN_TIME_STATS) をDWTのサイクルカウンタで取る
+// ・タスクの実行時間はタスク切り替え時にカーネルが積算する (割り込みの時間は割り込まれたタスクに含まれる)
+// ・割り込みの時間はOS_STAT_ISR_ENTER()/OS_STAT_ISR_EXIT()で別に積算する
+// ・topは2回のスナップショットの差分を表示するだけなので、計測中はosDelay()で寝ている
+// (*) カウンタは32bitなので、差分を取る間隔はサイクルカウンタが一周する時間(216MHzで約19.8秒)より短くすること
+
+// マクロ
+#define OS_STAT_TASK_MAX		(24)	// 取得するタスク数の最大
+#define OS_STAT_INTERVAL_MAX	(10)	// 更新間隔の最大[s]
+#define OS_STAT_INTERVAL_DEF	(2)		// 更新間隔のデフォルト[s]
+
+// スナップショット
+typedef struct {
+	TaskStatus_t	task[OS_STAT_TASK_MAX];			// タスク情報
+	uint32_t		task_num;						// タスク数
+	uint32_t		total;							// 取得時の実行時間カウンタ
+	uint32_t		isr_cyc[OS_STAT_ISR_NUM];		// 割り込みのサイクル数
+	uint32_t		isr_cnt[OS_STAT_ISR_NUM];		// 割り込み回数
+} OS_STAT_SNAP;
+
+// 制御ブロック
+typedef struct {
+	OS_STAT_SNAP	snap[2];		// 前回と今回
+	uint32_t		order[OS_STAT_TASK_MAX];		// 表示順 (今回のタスク情報のインデックス)
+	uint32_t		delta[OS_STAT_TASK_MAX];		// 区間中の実行時間
+} OS_STAT_CB;
+static OS_STAT_CB os_stat_cb MEM_PLAN(app);
+#define get_myself() (&os_stat_cb)
+
+// 割り込みの実行時間
+volatile uint32_t os_stat_isr_cyc[OS_STAT_ISR_NUM] MEM_PLAN(app);
+volatile uint32_t os_stat_isr_cnt[OS_STAT_ISR_NUM] MEM_PLAN(app);
+
+// 割り込みの名前
+const char * const os_stat_isr_name[OS_STAT_ISR_NUM] = {
+	"SysTick", "ETH", "USART", "HRT", "DMA",
+};
+
+// 実行時間統計のタイマ初期化 (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS、スケジューラ開始時に呼ばれる)
+// サイクルカウンタはリセット直後にdwt_init()で有効にしているので何もしない
+// (*) 計測中にCYCCNTを書き換えると差分が壊れるので、ほかのモジュールはCYCCNTを読むだけにすること
+void os_stat_timer_init(void)
+{
+}
+
+// スナップショット取得
+// 戻り値 : osOK、osErrorResource (タスクがOS_STAT_TASK_MAXより多い)
+static osStatus os_stat_snap(OS_STAT_SNAP *p_snap)
+{
+	uint32_t i;
+	
+	// タスクが多すぎるとuxTaskGetSystemState()は何も取得しない
+	p_snap->task_num = uxTaskGetSystemState(p_snap->task, OS_STAT_TASK_MAX, NULL);
+	if (p_snap->task_num == 0) {
+		return osErrorResource;
+	}
+	p_snap->total = DWT->CYCCNT;
+	for (i = 0; i < OS_STAT_ISR_NUM; i++) {
+		p_snap->isr_cyc[i] = os_stat_isr_cyc[i];
+		p_snap->isr_cnt[i] = os_stat_isr_cnt[i];
+	}
+	
+	return osOK;
+}
+
+// 割合を0.1%単位で表示用に計算
+static uint32_t os_stat_permil(uint32_t val, uint32_t total)
+{
+	if (total == 0) {
+		return 0;
+	}
+	
+	return (uint32_t)(((uint64_t)val * 1000) / total);
+}
+
+// 差分を表示
+static void os_stat_print(OS_STAT_SNAP *p_prev, OS_STAT_SNAP *p_cur)
+{
+	OS_STAT_CB *this = get_myself();
+	TaskStatus_t *p_task;
+	uint32_t total, idle = 0;
+	uint32_t i, j, tmp;
+	uint32_t permil;
+	
+	total = p_cur->total - p_prev->total;
+	
+	// タスクごとの区間中の実行時間 (前回にないタスクは作成されたばかり)
+	for (i = 0; i < p_cur->task_num; i++) {
+		p_task = &(p_cur->task[i]);
+		this->delta[i] = p_task->ulRunTimeCounter;
+		for (j = 0; j < p_prev->task_num; j++) {
+			if (p_prev->task[j].xTaskNumber == p_task->xTaskNumber) {
+				this->delta[i] = p_task->ulRunTimeCounter - p_prev->task[j].ulRunTimeCounter;
+				break;
+			}
+		}
+		// アイドル優先度のタスクはアイドルとして集計
+		if (p_task->uxBasePriority == tskIDLE_PRIORITY) {
+			idle += this->delta[i];
+		}
+		this->order[i] = i;
+	}
+	
+	// 実行時間の多い順に並べる
+	for (i = 1; i < p_cur->task_num; i++) {
+		tmp = this->order[i];
+		for (j = i; (j > 0) && (this->delta[this->order[j - 1]] < this->delta[tmp]); j--) {
+			this->order[j] = this->order[j - 1];
+		}
+		this->order[j] = tmp;
+	}
+	
+	permil = os_stat_permil(idle, total);
+	console_printf("--- %u cycles, idle %u.%u%%\n", total, permil / 10, permil % 10);
+	
+	// タスク
+	for (i = 0; i < p_cur->task_num; i++) {
+		p_task = &(p_cur->task[this->order[i]]);
+		permil = os_stat_permil(this->delta[this->order[i]], total);
+		console_printf(" %s : %u.%u%% prio %u stack free %u word\n", p_task->pcTaskName,
+		               permil / 10, permil % 10, (uint32_t)p_task->uxCurrentPriority, (uint32_t)p_task->usStackHighWaterMark);
+	}
+	
+	// 割り込み
+	for (i = 0; i < OS_STAT_ISR_NUM; i++) {
+		permil = os_stat_permil(p_cur->isr_cyc[i] - p_prev->isr_cyc[i], total);
+		console_printf(" [%s] : %u.%u%% %u times\n", os_stat_isr_name[i],
+		               permil / 10, permil % 10, p_cur->isr_cnt[i] - p_prev->isr_cnt[i]);
+	}
+}
+
+// タスクごとのCPU使用率表示コマンド
+// top [interval[s]] [count]
+static void os_stat_top_cmd(int argc, char *argv[])
+{
+	OS_STAT_CB *this = get_myself();
+	uint32_t interval = OS_STAT_INTERVAL_DEF;
+	uint32_t num = 1;
+	uint32_t i;
+	
+	if (argc >= 2) {
+		interval = atoi(argv[1]);
+	}
+	if (argc >= 3) {
+		num = atoi(argv[2]);
+	}
+	if ((interval == 0) || (interval > OS_STAT_INTERVAL_MAX) || (num == 0)) {
+		console_printf("top [interval(1-%u)[s]] [count]\n", OS_STAT_INTERVAL_MAX);
+		return;
+	}
+	
+	if (os_stat_snap(&(this->snap[0])) != osOK) {
+		console_printf("too many tasks (%u > %u)\n", (uint32_t)uxTaskGetNumberOfTasks(), OS_STAT_TASK_MAX);
+		return;
+	}
+	for (i = 0; i < num; i++) {
+		osDelay(interval * 1000);
+		if (os_stat_snap(&(this->snap[(i + 1) & 1])) != osOK) {
+			console_printf("too many tasks (%u > %u)\n", (uint32_t)uxTaskGetNumberOfTasks(), OS_STAT_TASK_MAX);
+			return;
+		}
+		os_stat_print(&(this->snap[i & 1]), &(this->snap[(i + 1) & 1]));
+	}
+}
+
+// コマンド設定関数
+void os_stat_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "top";
+	cmd.func = os_stat_top_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,39 @@
+/*
+ * os_stat.h
+ *
+ *  Created on: 2026/3/7
+ *      Author: user
+ */
+
+#ifndef APL_OS_STAT_H_
+#define APL_OS_STAT_H_
+
+// 割り込みの種類
+#define OS_STAT_ISR_SYSTICK		(0)
+#define OS_STAT_ISR_ETH			(1)
+#define OS_STAT_ISR_USART		(2)
+#define OS_STAT_ISR_HRT			(3)
+#define OS_STAT_ISR_DMA			(4)
+#define OS_STAT_ISR_NUM			(5)
+
+// 割り込みの実行時間 (サイクル数と回数、os_stat.c)
+extern volatile uint32_t os_stat_isr_cyc[OS_STAT_ISR_NUM];
+extern volatile uint32_t os_stat_isr_cnt[OS_STAT_ISR_NUM];
+extern const char * const os_stat_isr_name[OS_STAT_ISR_NUM];
+
+// 割り込みハンドラの先頭と最後に置く (trace.hが必要、トレースの入口、出口も記録する)
+// (*) 多重割り込みの場合、割り込んだ側の時間も含まれる
+#define OS_STAT_ISR_ENTER(id) \
+	uint32_t os_stat_isr_start = DWT->CYCCNT; \
+	TRACE_EVT(((id) == OS_STAT_ISR_SYSTICK) ? TRACE_TICK_ENTER : TRACE_ISR_ENTER, (id))
+#define OS_STAT_ISR_EXIT(id) \
+	do { \
+		TRACE_EVT(((id) == OS_STAT_ISR_SYSTICK) ? TRACE_TICK_EXIT : TRACE_ISR_EXIT, (id)); \
+		os_stat_isr_cyc[(id)] += DWT->CYCCNT - os_stat_isr_start; \
+		os_stat_isr_cnt[(id)]++; \
+	} while (0)
+
+extern void os_stat_timer_init(void);
+extern void os_stat_set_cmd(void);
+
+#endif /* APL_OS_STAT_H_ */
@@ -0,0 +1,254 @@
+/*
+ * prof.c
+ *
+ *  Created on: 2026/3/21
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "stm32f7xx_hal_rcc.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "prof.h"
+
+// PCサンプリングプロファイラ
+// ・TIM7の周期割り込みで、割り込まれた側の例外フレームからPC(とLR)を取り出してヒストグラムに数える
+// ・割り込み優先度はOSのクリティカルセクション(BASEPRI)より高くするので、割り込みハンドラ内でOSのAPIは呼ばないこと
+//   (__disable_irq()中はサンプルされない)
+// ・ダンプはTools/profsym.pyでDebug/Eth.elfと突き合わせて関数名にする
+// (*) SysTick(1kHz)と同期すると偏るので、サンプリング周波数はその倍数を避けること
+
+// マクロ
+#define PROF_HIST_NUM			(512)		// ヒストグラムのエントリ数 (2のべき乗)
+#define PROF_HIST_MASK			(PROF_HIST_NUM - 1)
+#define PROF_PROBE_MAX			(16)		// 衝突時に探すエントリ数
+#define PROF_TIM_CLK			(1000000)	// タイマのカウントクロック[Hz]
+#define PROF_RATE_DEF			(997)		// サンプリング周波数のデフォルト[Hz]
+#define PROF_RATE_MIN			(10)		// サンプリング周波数の最小[Hz]
+#define PROF_RATE_MAX			(20000)		// サンプリング周波数の最大[Hz]
+#define PROF_IRQ_PRIORITY		(0)			// 割り込み優先度 (最高)
+
+// 例外フレーム (スタックに積まれる順)
+#define PROF_FRAME_LR			(5)
+#define PROF_FRAME_PC			(6)
+
+// ヒストグラムのエントリ
+typedef struct {
+	uint32_t	pc;		// PC (0は未使用)
+	uint32_t	lr;		// LR (記録しない場合は0)
+	uint32_t	cnt;	// サンプル数
+} PROF_HIST;
+
+// 制御ブロック
+typedef struct {
+	volatile uint32_t	running;		// 計測中
+	uint32_t			with_lr;		// LRも記録する
+	uint32_t			rate;			// サンプリング周波数[Hz]
+	volatile uint32_t	sample_cnt;		// サンプル数
+	volatile uint32_t	isr_cnt;		// 割り込みハンドラ中のサンプル数
+	volatile uint32_t	lost_cnt;		// ヒストグラムに入らなかったサンプル数
+	uint32_t			used;			// 使用中のエントリ数
+} PROF_CB;
+static PROF_CB prof_cb MEM_PLAN(app);
+#define get_myself() (&prof_cb)
+
+// ヒストグラム
+static PROF_HIST prof_hist[PROF_HIST_NUM] MEM_PLAN(app);
+
+// サンプリング (TIM7_IRQHandlerから割り込まれた側のスタックポインタをもらう)
+static void __attribute__((used)) prof_sample(uint32_t *p_frame, uint32_t exc_return)
+{
+	PROF_CB *this = get_myself();
+	PROF_HIST *p_hist;
+	uint32_t pc, lr;
+	uint32_t idx, i;
+	
+	// 割り込み要因クリア (クリアが反映される前に抜けると再度割り込むのでDSB)
+	TIM7->SR = (uint32_t)~TIM_SR_UIF;
+	__DSB();
+	
+	pc = p_frame[PROF_FRAME_PC];
+	lr = this->with_lr ? p_frame[PROF_FRAME_LR] : 0;
+	
+	this->sample_cnt++;
+	// EXC_RETURNのbit3が0ならハンドラモード(割り込み中)に割り込んだ
+	if ((exc_return & 0x8) == 0) {
+		this->isr_cnt++;
+	}
+	
+	// 空きエントリか同じPC、LRのエントリを探す
+	idx = ((pc >> 1) ^ (lr >> 3)) & PROF_HIST_MASK;
+	for (i = 0; i < PROF_PROBE_MAX; i++) {
+		p_hist = &(prof_hist[(idx + i) & PROF_HIST_MASK]);
+		if ((p_hist->pc == pc) && (p_hist->lr == lr)) {
+			p_hist->cnt++;
+			return;
+		}
+		if (p_hist->pc == 0) {
+			p_hist->pc = pc;
+			p_hist->lr = lr;
+			p_hist->cnt = 1;
+			this->used++;
+			return;
+		}
+	}
+	
+	this->lost_cnt++;
+}
+
+// TIM7割り込みハンドラ
+// 割り込まれた側がPSP(タスク)かMSP(割り込み、スケジューラ開始前)かをEXC_RETURNで判定してフレームを渡す
+void __attribute__((naked)) TIM7_IRQHandler(void)
+{
+	__asm volatile (
+		"tst lr, #4      \n"
+		"ite eq          \n"
+		"mrseq r0, msp   \n"
+		"mrsne r0, psp   \n"
+		"mov r1, lr      \n"
+		"b prof_sample   \n"
+	);
+}
+
+// タイマのクロック (APB1のプリスケーラが1以外ならPCLK1の2倍)
+static uint32_t prof_get_tim_clk(void)
+{
+	uint32_t clk = HAL_RCC_GetPCLK1Freq();
+	
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+		clk *= 2;
+	}
+	
+	return clk;
+}
+
+// 計測開始
+static void prof_start(uint32_t rate, uint32_t with_lr)
+{
+	PROF_CB *this = get_myself();
+	
+	// ヒストグラムクリア
+	memset(prof_hist, 0, sizeof(prof_hist));
+	this->sample_cnt = 0;
+	this->isr_cnt = 0;
+	this->lost_cnt = 0;
+	this->used = 0;
+	this->rate = rate;
+	this->with_lr = with_lr;
+	
+	// TIM7 (1MHzでカウントしてrate[Hz]で更新割り込み)
+	__HAL_RCC_TIM7_CLK_ENABLE();
+	TIM7->CR1 = 0;
+	TIM7->PSC = (prof_get_tim_clk() / PROF_TIM_CLK) - 1;
+	TIM7->ARR = (PROF_TIM_CLK / rate) - 1;
+	TIM7->CNT = 0;
+	TIM7->EGR = TIM_EGR_UG;		// PSCを反映
+	TIM7->SR = 0;
+	TIM7->DIER = TIM_DIER_UIE;
+	HAL_NVIC_SetPriority(TIM7_IRQn, PROF_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(TIM7_IRQn);
+	
+	this->running = 1;
+	TIM7->CR1 = TIM_CR1_CEN;
+}
+
+// 計測停止
+static void prof_stop(void)
+{
+	PROF_CB *this = get_myself();
+	
+	if (!this->running) {
+		return;
+	}
+	
+	TIM7->CR1 = 0;
+	TIM7->DIER = 0;
+	HAL_NVIC_DisableIRQ(TIM7_IRQn);
+	this->running = 0;
+}
+
+// ダンプ
+// #PROF rate samples isr lost entries
+// P pc lr count
+// #END
+static void prof_dump(void)
+{
+	PROF_CB *this = get_myself();
+	PROF_HIST *p_hist;
+	uint32_t i;
+	
+	console_printf("#PROF %u %u %u %u %u\n", this->rate, this->sample_cnt, this->isr_cnt, this->lost_cnt, this->used);
+	for (i = 0; i < PROF_HIST_NUM; i++) {
+		p_hist = &(prof_hist[i]);
+		if (p_hist->pc != 0) {
+			console_printf("P %x %x %u\n", p_hist->pc, p_hist->lr, p_hist->cnt);
+		}
+	}
+	console_printf("#END\n");
+}
+
+// プロファイラコマンド
+// prof start [rate[Hz]] [lr] : 計測開始 (lr指定時は呼び出し元も記録)
+// prof stop                  : 計測停止
+// prof dump                  : 計測停止してダンプ
+// prof                       : 状態表示
+static void prof_cmd(int argc, char *argv[])
+{
+	PROF_CB *this = get_myself();
+	uint32_t rate = PROF_RATE_DEF;
+	uint32_t with_lr = 0;
+	
+	// 状態表示
+	if (argc < 2) {
+		console_printf("prof %s rate:%u samples:%u isr:%u lost:%u entries:%u/%u\n",
+		               this->running ? "running" : "stopped", this->rate,
+		               this->sample_cnt, this->isr_cnt, this->lost_cnt, this->used, PROF_HIST_NUM);
+		console_printf("prof start [rate(%u-%u)[Hz]] [lr] / stop / dump\n", PROF_RATE_MIN, PROF_RATE_MAX);
+		return;
+	}
+	
+	// 計測開始
+	if (strcmp(argv[1], "start") == 0) {
+		if (argc >= 3) {
+			rate = atoi(argv[2]);
+		}
+		if ((rate < PROF_RATE_MIN) || (rate > PROF_RATE_MAX)) {
+			console_printf("invalid parameter\n");
+			return;
+		}
+		if ((argc >= 4) && (strcmp(argv[3], "lr") == 0)) {
+			with_lr = 1;
+		}
+		prof_stop();
+		prof_start(rate, with_lr);
+		return;
+	}
+	
+	// 計測停止
+	if (strcmp(argv[1], "stop") == 0) {
+		prof_stop();
+		return;
+	}
+	
+	// ダンプ (計測を止めてから出力する)
+	if (strcmp(argv[1], "dump") == 0) {
+		prof_stop();
+		prof_dump();
+		return;
+	}
+	
+	console_printf("invalid parameter\n");
+}
+
+// コマンド設定関数
+void prof_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "prof";
+	cmd.func = prof_cmd;
+	console_set_command(&cmd);
+}
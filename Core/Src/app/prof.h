@@ -0,0 +1,13 @@
+/*
+ * prof.h
+ *
+ *  Created on: 2026/3/21
+ *      Author: user
+ */
+
+#ifndef APL_PROF_H_
+#define APL_PROF_H_
+
+extern void prof_set_cmd(void);
+
+#endif /* APL_PROF_H_ */
@@ -0,0 +1,333 @@
+/*
+ * trace.c
+ *
+ *  Created on: 2026/3/14
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "os_stat.h"
+#include "pkt_buf.h"
+#include "net.h"
+#include "trace.h"
+
+// イベントトレーサ
+// ・FreeRTOSのトレースマクロ(FreeRTOSConfig.h)とドライバのトレースポイントからTRACE_EVT()で記録する
+// ・記録はタイムスタンプ(DWT->CYCCNT)、イベントID、引数の8byteで、RAMのリングに書く
+// ・書き込み位置はLDREX/STREXで確保するので、割り込みとタスクが同時に記録してもロックは不要
+// ・ダンプはコンソール(テキスト)またはUDP(バイナリ)で出力し、Tools/trace2json.pyでChromeトレース形式(Perfettoで表示可能)に変換する
+
+// マクロ
+#define TRACE_REC_NUM			(2048)		// 記録数 (2のべき乗)
+#define TRACE_REC_MASK			(TRACE_REC_NUM - 1)
+#define TRACE_TASK_MAX			(16)		// タスク名を出力するタスク数の最大
+#define TRACE_NAME_SIZE			(16)		// UDPで送る名前の長さ (configMAX_TASK_NAME_LEN)
+#define TRACE_DUMP_PER_LINE		(4)			// コンソール1行あたりのイベント数 (console_printf()の長さ制限)
+#define TRACE_MASK_ALL			((1UL << TRACE_CAT_NUM) - 1)
+
+// 記録モード
+#define TRACE_MODE_WRAP			(0)			// 古いものから上書きする
+#define TRACE_MODE_STOP			(1)			// 一杯になったら記録しない
+
+// UDPダンプ
+// ヘッダ : "TRC1"(4) 種別(1) 予約(1) シーケンス番号(2)
+// META   : CPUクロック(4) イベント数(4) 欠落数(4) 名前数(2) {種別(1) 番号(1) 名前(16)}*名前数
+// EVENT  : 記録 * n (リトルエンディアン)
+// END    : なし
+#define TRACE_UDP_HDR_SIZE		(8)
+#define TRACE_UDP_TYPE_META		(0)
+#define TRACE_UDP_TYPE_EVENT	(1)
+#define TRACE_UDP_TYPE_END		(2)
+#define TRACE_UDP_NAME_TASK		(0)
+#define TRACE_UDP_NAME_ISR		(1)
+#define TRACE_UDP_REC_NUM		((NET_UDP_PAYLOAD_MAX - TRACE_UDP_HDR_SIZE) / sizeof(TRACE_REC))
+#define TRACE_UDP_INTERVAL		(1)			// パケット間の待ち時間[ms] (受信側の取りこぼし防止)
+
+// 記録
+typedef struct {
+	uint32_t	ts;		// タイムスタンプ (DWT->CYCCNT)
+	uint16_t	id;		// イベントID
+	uint16_t	arg;	// 引数
+} TRACE_REC;
+
+// 制御ブロック
+typedef struct {
+	volatile uint32_t	w_idx;						// 書き込み位置 (単調増加)
+	uint32_t			mode;						// 記録モード
+	TaskStatus_t		task[TRACE_TASK_MAX];		// タスク情報 (ダンプ時に取得)
+	uint32_t			task_num;					// タスク数
+} TRACE_CB;
+static TRACE_CB trace_cb MEM_PLAN(app);
+#define get_myself() (&trace_cb)
+
+// 記録バッファ
+static TRACE_REC trace_buf[TRACE_REC_NUM] MEM_PLAN_NOINIT(app);	// w_idxまでしか読まないのでゼロクリア不要
+
+// 記録するカテゴリのマスク (0は停止)
+volatile uint32_t trace_mask MEM_PLAN(app);
+
+// イベント記録 (タスク切り替えごとに呼ばれるのでITCMに置く)
+void MEM_PLAN_ITCM trace_put(uint32_t id, uint32_t arg)
+{
+	TRACE_CB *this = get_myself();
+	TRACE_REC *p_rec;
+	uint32_t ts = DWT->CYCCNT;
+	uint32_t idx;
+	
+	// 書き込み位置を確保 (途中で割り込まれたらSTREXが失敗するのでやり直す)
+	do {
+		idx = __LDREXW(&(this->w_idx));
+	} while (__STREXW(idx + 1, &(this->w_idx)) != 0);
+	
+	// 一杯
+	if ((this->mode == TRACE_MODE_STOP) && (idx >= TRACE_REC_NUM)) {
+		return;
+	}
+	
+	p_rec = &(trace_buf[idx & TRACE_REC_MASK]);
+	p_rec->ts = ts;
+	p_rec->id = (uint16_t)id;
+	p_rec->arg = (uint16_t)arg;
+}
+
+// 出力する範囲を取得
+static uint32_t trace_get_range(uint32_t *p_start, uint32_t *p_lost)
+{
+	TRACE_CB *this = get_myself();
+	uint32_t w_idx = this->w_idx;
+	
+	*p_start = 0;
+	*p_lost = 0;
+	if (w_idx <= TRACE_REC_NUM) {
+		return w_idx;
+	}
+	
+	*p_lost = w_idx - TRACE_REC_NUM;
+	if (this->mode == TRACE_MODE_WRAP) {
+		*p_start = w_idx - TRACE_REC_NUM;
+	}
+	
+	return TRACE_REC_NUM;
+}
+
+// コンソールにダンプ
+static void trace_dump_console(void)
+{
+	TRACE_CB *this = get_myself();
+	TRACE_REC *p_rec[TRACE_DUMP_PER_LINE];
+	uint32_t start, num, lost;
+	uint32_t i, j;
+	
+	num = trace_get_range(&start, &lost);
+	
+	// ヘッダ
+	console_printf("#TRACE %u %u %u\n", SystemCoreClock, num, lost);
+	for (i = 0; i < this->task_num; i++) {
+		console_printf("#TASK %u %s\n", (uint32_t)this->task[i].xTaskNumber, this->task[i].pcTaskName);
+	}
+	for (i = 0; i < OS_STAT_ISR_NUM; i++) {
+		console_printf("#ISR %u %s\n", i, os_stat_isr_name[i]);
+	}
+	
+	// イベント (16進、タイムスタンプ ID 引数の繰り返し)
+	for (i = 0; i < num; i += TRACE_DUMP_PER_LINE) {
+		for (j = 0; j < TRACE_DUMP_PER_LINE; j++) {
+			p_rec[j] = &(trace_buf[(start + i + ((i + j < num) ? j : 0)) & TRACE_REC_MASK]);
+		}
+		switch (num - i) {
+			case 1:
+				console_printf("E %x %x %x\n", p_rec[0]->ts, p_rec[0]->id, p_rec[0]->arg);
+				break;
+			case 2:
+				console_printf("E %x %x %x %x %x %x\n", p_rec[0]->ts, p_rec[0]->id, p_rec[0]->arg,
+				               p_rec[1]->ts, p_rec[1]->id, p_rec[1]->arg);
+				break;
+			case 3:
+				console_printf("E %x %x %x %x %x %x %x %x %x\n", p_rec[0]->ts, p_rec[0]->id, p_rec[0]->arg,
+				               p_rec[1]->ts, p_rec[1]->id, p_rec[1]->arg, p_rec[2]->ts, p_rec[2]->id, p_rec[2]->arg);
+				break;
+			default:
+				console_printf("E %x %x %x %x %x %x %x %x %x %x %x %x\n", p_rec[0]->ts, p_rec[0]->id, p_rec[0]->arg,
+				               p_rec[1]->ts, p_rec[1]->id, p_rec[1]->arg, p_rec[2]->ts, p_rec[2]->id, p_rec[2]->arg,
+				               p_rec[3]->ts, p_rec[3]->id, p_rec[3]->arg);
+				break;
+		}
+	}
+	console_printf("#END\n");
+}
+
+// UDPパケットのヘッダ作成
+static uint8_t* trace_udp_hdr(PKT_BUF *p_pkt, uint32_t type, uint32_t seq, uint32_t size)
+{
+	uint8_t *p;
+	
+	p = pkt_put(p_pkt, TRACE_UDP_HDR_SIZE + size);
+	memcpy(p, "TRC1", 4);
+	p[4] = (uint8_t)type;
+	p[5] = 0;
+	p[6] = (uint8_t)seq;
+	p[7] = (uint8_t)(seq >> 8);
+	
+	return &p[TRACE_UDP_HDR_SIZE];
+}
+
+// 名前を書く
+static uint8_t* trace_udp_name(uint8_t *p, uint32_t kind, uint32_t num, const char *p_name)
+{
+	p[0] = (uint8_t)kind;
+	p[1] = (uint8_t)num;
+	memset(&p[2], 0, TRACE_NAME_SIZE);
+	strncpy((char*)&p[2], p_name, TRACE_NAME_SIZE - 1);
+	
+	return &p[2 + TRACE_NAME_SIZE];
+}
+
+// UDPでダンプ
+static osStatus trace_dump_udp(uint32_t ip_addr, uint16_t port)
+{
+	TRACE_CB *this = get_myself();
+	PKT_BUF *p_pkt;
+	uint8_t *p;
+	uint32_t start, num, lost;
+	uint32_t seq = 0;
+	uint32_t i, j, n;
+	int32_t sock;
+	osStatus ercd = osOK;
+	
+	if ((sock = net_udp_open(0)) < 0) {
+		return osErrorResource;
+	}
+	
+	num = trace_get_range(&start, &lost);
+	
+	// META
+	if ((p_pkt = net_udp_alloc()) == NULL) {
+		ercd = osErrorNoMemory;
+		goto EXIT;
+	}
+	p = trace_udp_hdr(p_pkt, TRACE_UDP_TYPE_META, seq++, 14 + (this->task_num + OS_STAT_ISR_NUM) * (2 + TRACE_NAME_SIZE));
+	memcpy(&p[0], &SystemCoreClock, 4);
+	memcpy(&p[4], &num, 4);
+	memcpy(&p[8], &lost, 4);
+	p[12] = (uint8_t)(this->task_num + OS_STAT_ISR_NUM);
+	p[13] = 0;
+	p = &p[14];
+	for (i = 0; i < this->task_num; i++) {
+		p = trace_udp_name(p, TRACE_UDP_NAME_TASK, this->task[i].xTaskNumber, this->task[i].pcTaskName);
+	}
+	for (i = 0; i < OS_STAT_ISR_NUM; i++) {
+		p = trace_udp_name(p, TRACE_UDP_NAME_ISR, i, os_stat_isr_name[i]);
+	}
+	if ((ercd = net_udp_send(sock, p_pkt, ip_addr, port)) != osOK) {
+		goto EXIT;
+	}
+	
+	// EVENT (リングの折り返しがあるので1件ずつコピー)
+	for (i = 0; i < num; i += n) {
+		osDelay(TRACE_UDP_INTERVAL);
+		n = ((num - i) > TRACE_UDP_REC_NUM) ? TRACE_UDP_REC_NUM : (num - i);
+		if ((p_pkt = net_udp_alloc()) == NULL) {
+			ercd = osErrorNoMemory;
+			goto EXIT;
+		}
+		p = trace_udp_hdr(p_pkt, TRACE_UDP_TYPE_EVENT, seq++, n * sizeof(TRACE_REC));
+		for (j = 0; j < n; j++) {
+			memcpy(&p[j * sizeof(TRACE_REC)], &(trace_buf[(start + i + j) & TRACE_REC_MASK]), sizeof(TRACE_REC));
+		}
+		if ((ercd = net_udp_send(sock, p_pkt, ip_addr, port)) != osOK) {
+			goto EXIT;
+		}
+	}
+	
+	// END
+	osDelay(TRACE_UDP_INTERVAL);
+	if ((p_pkt = net_udp_alloc()) == NULL) {
+		ercd = osErrorNoMemory;
+		goto EXIT;
+	}
+	trace_udp_hdr(p_pkt, TRACE_UDP_TYPE_END, seq++, 0);
+	ercd = net_udp_send(sock, p_pkt, ip_addr, port);
+	
+EXIT:
+	net_udp_close(sock);
+	
+	return ercd;
+}
+
+// トレースコマンド
+// trace on [mask(16進)] [stop] : 記録開始 (mask bit0:OS bit1:ISR bit2:SysTick bit3:ETH)
+// trace off                    : 記録停止
+// trace dump [ip port]         : 記録停止してダンプ (ip、port指定時はUDP)
+// trace                        : 状態表示
+static void trace_cmd(int argc, char *argv[])
+{
+	TRACE_CB *this = get_myself();
+	uint32_t mask = TRACE_MASK_ALL;
+	uint32_t start, num, lost;
+	uint32_t ip_addr;
+	uint16_t port;
+	osStatus ercd;
+	
+	// 状態表示
+	if (argc < 2) {
+		num = trace_get_range(&start, &lost);
+		console_printf("trace mask:0x%x mode:%s rec:%u lost:%u\n", trace_mask,
+		               (this->mode == TRACE_MODE_STOP) ? "stop" : "wrap", num, lost);
+		console_printf("trace on [mask] [stop] / off / dump [ip port]\n");
+		return;
+	}
+	
+	// 記録開始
+	if (strcmp(argv[1], "on") == 0) {
+		if (argc >= 3) {
+			mask = strtoul(argv[2], NULL, 16) & TRACE_MASK_ALL;
+		}
+		trace_mask = 0;
+		this->mode = ((argc >= 4) && (strcmp(argv[3], "stop") == 0)) ? TRACE_MODE_STOP : TRACE_MODE_WRAP;
+		this->w_idx = 0;
+		trace_mask = mask;
+		return;
+	}
+	
+	// 記録停止
+	if (strcmp(argv[1], "off") == 0) {
+		trace_mask = 0;
+		return;
+	}
+	
+	// ダンプ (記録を止めてから出力する)
+	if (strcmp(argv[1], "dump") == 0) {
+		trace_mask = 0;
+		this->task_num = uxTaskGetSystemState(this->task, TRACE_TASK_MAX, NULL);
+		if (argc >= 4) {
+			ip_addr = net_aton(argv[2]);
+			port = (uint16_t)atoi(argv[3]);
+			if ((ip_addr == 0) || (port == 0)) {
+				console_printf("invalid parameter\n");
+				return;
+			}
+			ercd = trace_dump_udp(ip_addr, port);
+			console_printf("trace_dump_udp:ercd = %d\n", ercd);
+		} else {
+			trace_dump_console();
+		}
+		return;
+	}
+	
+	console_printf("invalid parameter\n");
+}
+
+// コマンド設定関数
+void trace_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "trace";
+	cmd.func = trace_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,62 @@
+/*
+ * trace.h
+ *
+ *  Created on: 2026/3/14
+ *      Author: user
+ */
+
+#ifndef APL_TRACE_H_
+#define APL_TRACE_H_
+
+// (*) FreeRTOSConfig.hからインクルードされるので、stdint.h以外に依存しないこと
+
+// カテゴリ (trace onのマスクのビット位置)
+#define TRACE_CAT_OS			(0)		// タスク切り替え、キュー、タスク通知
+#define TRACE_CAT_ISR			(1)		// 割り込みの入口、出口 (SysTick以外)
+#define TRACE_CAT_TICK			(2)		// SysTick割り込みの入口、出口
+#define TRACE_CAT_ETH			(3)		// Ethernetドライバ
+#define TRACE_CAT_NUM			(4)
+
+// イベントID (上位8bitがカテゴリ)
+#define TRACE_ID(cat, num)		(((cat) << 8) | (num))
+#define TRACE_CAT(id)			((id) >> 8)
+
+// OS (arg : タスク番号、キューはアドレスの下位16bit)
+#define TRACE_TASK_IN			TRACE_ID(TRACE_CAT_OS, 0)		// タスク実行開始
+#define TRACE_TASK_OUT			TRACE_ID(TRACE_CAT_OS, 1)		// タスク実行終了
+#define TRACE_QUEUE_SEND		TRACE_ID(TRACE_CAT_OS, 2)		// キュー送信 (セマフォ、ミューテックスの解放を含む)
+#define TRACE_QUEUE_RECV		TRACE_ID(TRACE_CAT_OS, 3)		// キュー受信 (セマフォ、ミューテックスの獲得を含む)
+#define TRACE_QUEUE_BLOCK_SEND	TRACE_ID(TRACE_CAT_OS, 4)		// キュー送信で待ちに入る
+#define TRACE_QUEUE_BLOCK_RECV	TRACE_ID(TRACE_CAT_OS, 5)		// キュー受信で待ちに入る
+#define TRACE_NOTIFY			TRACE_ID(TRACE_CAT_OS, 6)		// タスク通知 (arg : 通知先)
+#define TRACE_NOTIFY_BLOCK		TRACE_ID(TRACE_CAT_OS, 7)		// タスク通知待ちに入る
+#define TRACE_NOTIFY_TAKE		TRACE_ID(TRACE_CAT_OS, 8)		// タスク通知待ちから戻る
+// 割り込み (arg : OS_STAT_ISR_xxx)
+#define TRACE_ISR_ENTER			TRACE_ID(TRACE_CAT_ISR, 0)
+#define TRACE_ISR_EXIT			TRACE_ID(TRACE_CAT_ISR, 1)
+#define TRACE_TICK_ENTER		TRACE_ID(TRACE_CAT_TICK, 0)
+#define TRACE_TICK_EXIT			TRACE_ID(TRACE_CAT_TICK, 1)
+// Ethernet
+#define TRACE_ETH_CLEAN_START	TRACE_ID(TRACE_CAT_ETH, 0)		// 送信データのキャッシュクリーン開始 (arg : サイズ)
+#define TRACE_ETH_CLEAN_END		TRACE_ID(TRACE_CAT_ETH, 1)		// 送信データのキャッシュクリーン終了
+#define TRACE_ETH_TX_POST		TRACE_ID(TRACE_CAT_ETH, 2)		// 送信ディスクリプタ設定 (arg : 先頭ディスクリプタ | ディスクリプタ数 << 8)
+#define TRACE_ETH_WAIT_START	TRACE_ID(TRACE_CAT_ETH, 3)		// 送信完了待ち開始
+#define TRACE_ETH_WAIT_END		TRACE_ID(TRACE_CAT_ETH, 4)		// 送信完了待ち終了
+#define TRACE_ETH_TX_DONE		TRACE_ID(TRACE_CAT_ETH, 5)		// 送信ディスクリプタ回収 (arg : ディスクリプタ)
+#define TRACE_ETH_RX			TRACE_ID(TRACE_CAT_ETH, 6)		// 受信 (arg : フレーム長)
+
+// 記録するカテゴリのマスク (trace.c)
+extern volatile uint32_t trace_mask;
+
+// イベント記録 (割り込み、タスクどちらからでも呼べる)
+#define TRACE_EVT(id, arg) \
+	do { \
+		if ((trace_mask & (1UL << TRACE_CAT(id))) != 0) { \
+			trace_put((id), (uint32_t)(arg)); \
+		} \
+	} while (0)
+
+extern void trace_put(uint32_t id, uint32_t arg);
+extern void trace_set_cmd(void);
+
+#endif /* APL_TRACE_H_ */
@@ -0,0 +1,277 @@
+/*
+ * eth_hal.c
+ *
+ *  Created on: 2026/1/17
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "os_sig.h"
+#include "mem_plan.h"
+#include "trace.h"
+#include "os_stat.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "eth_if.h"
+
+// HAL ETH v2ドライバ (stm32f7xx_hal_eth.c) をeth_ifの操作テーブルに合わせる
+// (*) ETH_IF_USE_HAL定義時のみ有効 (割り込みハンドラがperi/eth.cと重複するため)
+#ifdef ETH_IF_USE_HAL
+
+// 状態
+#define ST_INIT		(0)		// 初期状態
+#define ST_OPEN		(2)		// オープン状態
+
+// マクロ
+#define TX_BUFF_NUM			(ETH_TX_DESC_CNT)	// 1フレームに使用できる送信バッファ数
+#define TX_BUFF_SIZE_MAX	(1504)				// 送信バッファ1つのサイズ
+#define SEND_TMOUT			(1000)				// 送信完了待ちタイムアウト[ms]
+
+// イベント
+#define EVT_SEND_DONE		(1 << 0)
+#define EVT_SEND_ERROR		(1 << 1)
+#define EVT_RECV_DONE		(1 << 2)
+
+// CubeMXが生成したハンドル、ディスクリプタ (main.c)
+extern ETH_HandleTypeDef heth;
+extern ETH_DMADescTypeDef DMARxDscrTab[ETH_RX_DESC_CNT];
+extern ETH_DMADescTypeDef DMATxDscrTab[ETH_TX_DESC_CNT];
+
+// 制御ブロック
+typedef struct {
+	uint32_t					status;						// 状態
+	OS_SIG_WAITER				*p_snd_waiter;				// 送信待ち
+	OS_SIG_WAITER				*p_rcv_waiter;				// 受信待ち
+	ETH_TxPacketConfigTypeDef	tx_cfg;						// 送信設定
+	ETH_BufferTypeDef			tx_buf[TX_BUFF_NUM];		// 送信バッファリスト
+} ETH_HAL_CB;
+static ETH_HAL_CB eth_hal_cb MEM_PLAN(eth);
+#define get_myself() (&eth_hal_cb)
+
+// MACアドレス (独自ドライバと同じアドレスをオープン時に設定)
+static uint8_t eth_hal_mac_address[6];
+
+// 受信バッファ確保 (パケットバッファを割り当てる)
+void HAL_ETH_RxAllocateCallback(uint8_t **buff)
+{
+	PKT_BUF *p_pkt;
+	
+	if ((p_pkt = pkt_alloc()) == NULL) {
+		*buff = NULL;
+		return;
+	}
+	
+	*buff = p_pkt->p_data;
+}
+
+// 受信データの連結 (フレームを構成するパケットバッファをp_nextでつなぐ)
+void HAL_ETH_RxLinkCallback(void **pStart, void **pEnd, uint8_t *buff, uint16_t Length)
+{
+	PKT_BUF *p_pkt;
+	
+	if ((p_pkt = pkt_get_from_addr(buff)) == NULL) {
+		return;
+	}
+	
+	SCB_InvalidateDCache_by_Addr((uint32_t*)buff, Length);
+	p_pkt->len = Length;
+	p_pkt->p_next = NULL;
+	
+	if (*pStart == NULL) {
+		*pStart = p_pkt;
+	} else {
+		((PKT_BUF*)*pEnd)->p_next = p_pkt;
+	}
+	*pEnd = p_pkt;
+}
+
+// 送信バッファ解放 (送信バッファは呼び出し元が所有するので何もしない)
+void HAL_ETH_TxFreeCallback(uint32_t *buff)
+{
+	
+}
+
+// 送信完了
+void HAL_ETH_TxCpltCallback(ETH_HandleTypeDef *p_heth)
+{
+	ETH_HAL_CB *this = get_myself();
+	
+	os_sig_set(this->p_snd_waiter, EVT_SEND_DONE);
+}
+
+// 受信完了
+void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *p_heth)
+{
+	ETH_HAL_CB *this = get_myself();
+	
+	os_sig_set(this->p_rcv_waiter, EVT_RECV_DONE);
+}
+
+// エラー
+void HAL_ETH_ErrorCallback(ETH_HandleTypeDef *p_heth)
+{
+	ETH_HAL_CB *this = get_myself();
+	
+	os_sig_set(this->p_snd_waiter, EVT_SEND_ERROR);
+}
+
+// 割り込みハンドラ
+void ETH_IRQHandler(void)
+{
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_ETH);
+	
+	HAL_ETH_IRQHandler(&heth);
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_ETH);
+}
+
+// オープン
+static osStatus eth_hal_open(void)
+{
+	ETH_HAL_CB *this = get_myself();
+	
+	// オープン済み
+	if (this->status == ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// 初期化 (MX_ETH_Init()と同じ設定、受信バッファはパケットバッファのデータ領域)
+	eth_get_mac_addr(eth_hal_mac_address);
+	heth.Instance = ETH;
+	heth.Init.MACAddr = &eth_hal_mac_address[0];
+	heth.Init.MediaInterface = HAL_ETH_RMII_MODE;
+	heth.Init.TxDesc = DMATxDscrTab;
+	heth.Init.RxDesc = DMARxDscrTab;
+	heth.Init.RxBuffLen = PKT_DATA_SIZE;
+	if (HAL_ETH_Init(&heth) != HAL_OK) {
+		return osErrorResource;
+	}
+	
+	// 送信設定
+	memset(&(this->tx_cfg), 0, sizeof(this->tx_cfg));
+	this->tx_cfg.Attributes = ETH_TX_PACKETS_FEATURES_CSUM | ETH_TX_PACKETS_FEATURES_CRCPAD;
+	this->tx_cfg.ChecksumCtrl = ETH_CHECKSUM_IPHDR_PAYLOAD_INSERT_PHDR_CALC;
+	this->tx_cfg.CRCPadCtrl = ETH_CRC_PAD_INSERT;
+	
+	// 開始
+	if (HAL_ETH_Start_IT(&heth) != HAL_OK) {
+		return osErrorResource;
+	}
+	
+	// 状態更新
+	this->status = ST_OPEN;
+	
+	return osOK;
+}
+
+// 送信 (送信完了まで待つ)
+static osStatus eth_hal_send(uint8_t *p_data, uint32_t size)
+{
+	ETH_HAL_CB *this = get_myself();
+	ETH_BufferTypeDef *p_buf;
+	uint32_t remain_size = size;
+	uint32_t i;
+	OS_SIG_WAITER waiter;
+	uint32_t bits;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if ((p_data == NULL) || (size == 0) || (size > (TX_BUFF_NUM * TX_BUFF_SIZE_MAX))) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// 送信バッファリスト作成
+	for (i = 0; remain_size != 0; i++) {
+		p_buf = &(this->tx_buf[i]);
+		p_buf->buffer = p_data;
+		p_buf->len = (remain_size > TX_BUFF_SIZE_MAX) ? TX_BUFF_SIZE_MAX : remain_size;
+		p_buf->next = NULL;
+		if (i != 0) {
+			this->tx_buf[i - 1].next = p_buf;
+		}
+		p_data += p_buf->len;
+		remain_size -= p_buf->len;
+	}
+	this->tx_cfg.Length = size;
+	this->tx_cfg.TxBuffer = &(this->tx_buf[0]);
+	this->tx_cfg.pData = this->tx_buf[0].buffer;
+	
+	// フラッシュ
+	SCB_CleanDCache_by_Addr((uint32_t*)this->tx_buf[0].buffer, size);
+	
+	// 送信
+	os_sig_prepare(&waiter);
+	this->p_snd_waiter = &waiter;
+	if (HAL_ETH_Transmit_IT(&heth, &(this->tx_cfg)) != HAL_OK) {
+		this->p_snd_waiter = NULL;
+		return osErrorResource;
+	}
+	
+	// 送信完了待ち
+	bits = os_sig_wait(&waiter, (EVT_SEND_DONE | EVT_SEND_ERROR), SEND_TMOUT);
+	if (bits == 0) {
+		ercd = osErrorTimeoutResource;
+	} else if ((bits & EVT_SEND_ERROR) != 0) {
+		ercd = osErrorISR;
+	} else {
+		ercd = osOK;
+	}
+	this->p_snd_waiter = NULL;
+	
+	// 送信済みディスクリプタの回収
+	HAL_ETH_ReleaseTxPacket(&heth);
+	
+	return ercd;
+}
+
+// 受信
+static PKT_BUF* eth_hal_recv(int32_t tmout)
+{
+	ETH_HAL_CB *this = get_myself();
+	PKT_BUF *p_pkt = NULL;
+	OS_SIG_WAITER waiter;
+	
+	// オープンしていない
+	if (this->status != ST_OPEN) {
+		return NULL;
+	}
+	
+	os_sig_prepare(&waiter);
+	this->p_rcv_waiter = &waiter;
+	
+	while (1) {
+		// 受信フレームがあれば取り出す (ディスクリプタへのバッファ補充もここで行われる)
+		if ((HAL_ETH_ReadData(&heth, (void**)&p_pkt) == HAL_OK) && (p_pkt != NULL)) {
+			break;
+		}
+		p_pkt = NULL;
+		// 待たない
+		if (tmout == 0) {
+			break;
+		}
+		// 受信待ち
+		if (os_sig_wait(&waiter, EVT_RECV_DONE, tmout) == 0) {
+			break;
+		}
+	}
+	
+	this->p_rcv_waiter = NULL;
+	
+	return p_pkt;
+}
+
+// HAL ETH v2ドライバ
+const ETH_IF_OPS eth_if_hal_ops = {
+	"hal",
+	eth_hal_open,
+	eth_hal_send,
+	eth_hal_recv,
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * eth_if.c
+ *
+ *  Created on: 2026/1/17
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "eth_if.h"
+
+// 独自ドライバのオープンパラメータ (HALドライバのデフォルトと同じDMA動作モード)
+static const ETH_OPEN eth_if_open_par = {
+	COM_MODE_FULL_DUPLEX,
+	// 送受信ストアアンドフォワード、OSFあり、32beatバースト (スレッショルドは未使用)
+	{1, 1, 1, 32, 0, 0},
+};
+
+// 独自ドライバのオープン
+static osStatus eth_if_custom_open(void)
+{
+	ETH_OPEN open_par = eth_if_open_par;
+	
+	return eth_open(&open_par);
+}
+
+// 独自ドライバ (peri/eth.c)
+const ETH_IF_OPS eth_if_custom_ops = {
+	"custom",
+	eth_if_custom_open,
+	eth_send,
+	eth_recv_pkt,
+};
+
+// 使用するドライバ
+#ifdef ETH_IF_USE_HAL
+#define get_ops()	(&eth_if_hal_ops)
+#else
+#define get_ops()	(&eth_if_custom_ops)
+#endif
+
+// ドライバ名取得
+const char* eth_if_get_name(void)
+{
+	return get_ops()->name;
+}
+
+// オープン
+osStatus eth_if_open(void)
+{
+	return get_ops()->open();
+}
+
+// 送信
+osStatus eth_if_send(uint8_t *p_data, uint32_t size)
+{
+	return get_ops()->send(p_data, size);
+}
+
+// 受信
+PKT_BUF* eth_if_recv(int32_t tmout)
+{
+	return get_ops()->recv(tmout);
+}
@@ -0,0 +1,32 @@
+/*
+ * eth_if.h
+ *
+ *  Created on: 2026/1/17
+ *      Author: user
+ */
+
+#ifndef DRV_ETH_IF_H_
+#define DRV_ETH_IF_H_
+
+// 使用するイーサネットドライバ (ビルド時に選択)
+// 未定義 : peri/eth.c (独自ドライバ)
+// 定義   : stm32f7xx_hal_eth.c (HAL ETH v2ドライバ、drv/eth_hal.c)
+//#define ETH_IF_USE_HAL
+
+// ドライバ操作テーブル
+typedef struct {
+	const char	*name;										// ドライバ名
+	osStatus	(*open)(void);								// オープン
+	osStatus	(*send)(uint8_t *p_data, uint32_t size);	// 送信 (送信完了まで待つ)
+	PKT_BUF*	(*recv)(int32_t tmout);						// 受信 (使用後はpkt_free()で解放)
+} ETH_IF_OPS;
+
+extern const ETH_IF_OPS eth_if_custom_ops;
+extern const ETH_IF_OPS eth_if_hal_ops;
+
+extern const char* eth_if_get_name(void);
+extern osStatus eth_if_open(void);
+extern osStatus eth_if_send(uint8_t *p_data, uint32_t size);
+extern PKT_BUF* eth_if_recv(int32_t tmout);
+
+#endif /* DRV_ETH_IF_H_ */
@@ -0,0 +1,189 @@
+/*
+ * eth_pat.c
+ *
+ *  Created on: 2026/2/14
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "eth_pat.h"
+
+// 試験ヘッダ (ETH_PAT_HDR_OFFSETからの位置)
+#define HDR_SEQ			(0)		// シーケンス番号 (4byte)
+#define HDR_LEN			(4)		// フレームサイズ (2byte)
+#define HDR_TYPE		(6)		// パターン種別 (1byte)
+
+// パターン生成の初期状態
+static uint32_t pat_seed(uint32_t type, uint32_t seq)
+{
+	uint32_t state;
+	
+	if (type == ETH_PAT_TYPE_CNT) {
+		return seq;
+	}
+	
+	// xorshiftは0を種にできない
+	state = (seq * 0x9E3779B9) ^ 0x6A09E667;
+	if (state == 0) {
+		state = 1;
+	}
+	
+	return state;
+}
+
+// パターンの次の1word
+static inline uint32_t pat_next(uint32_t type, uint32_t *p_state)
+{
+	uint32_t x = *p_state;
+	
+	if (type == ETH_PAT_TYPE_CNT) {
+		*p_state = x + 1;
+		return x;
+	}
+	
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*p_state = x;
+	
+	return x;
+}
+
+// パターン書き込み (4byteずつ生成、端数は最後の1wordの先頭から)
+static void pat_fill(uint8_t *p_data, uint32_t len, uint32_t type, uint32_t seq)
+{
+	uint32_t state = pat_seed(type, seq);
+	uint32_t word;
+	
+	while (len >= sizeof(word)) {
+		word = pat_next(type, &state);
+		memcpy(p_data, &word, sizeof(word));
+		p_data += sizeof(word);
+		len -= sizeof(word);
+	}
+	if (len != 0) {
+		word = pat_next(type, &state);
+		memcpy(p_data, &word, len);
+	}
+}
+
+// パターン比較 (戻り値 : 0 一致)
+static uint32_t pat_compare(const uint8_t *p_data, uint32_t len, uint32_t type, uint32_t seq)
+{
+	uint32_t state = pat_seed(type, seq);
+	uint32_t word, rcv;
+	
+	while (len >= sizeof(word)) {
+		word = pat_next(type, &state);
+		memcpy(&rcv, p_data, sizeof(rcv));
+		if (rcv != word) {
+			return 1;
+		}
+		p_data += sizeof(word);
+		len -= sizeof(word);
+	}
+	if (len != 0) {
+		word = pat_next(type, &state);
+		return (uint32_t)memcmp(p_data, &word, len);
+	}
+	
+	return 0;
+}
+
+// 試験フレーム作成
+// p_frame : sizeバイトのバッファ
+// p_dst   : 宛先MACアドレス (送信元は自MACアドレス)
+// type    : ETH_PAT_TYPE_xxx
+void eth_pat_build(uint8_t *p_frame, uint32_t size, const uint8_t *p_dst, uint32_t type, uint32_t seq)
+{
+	uint8_t *p_hdr = &p_frame[ETH_PAT_HDR_OFFSET];
+	uint16_t len = (uint16_t)size;
+	
+	// ETHヘッダ
+	memcpy(&p_frame[0], p_dst, 6);
+	eth_get_mac_addr(&p_frame[6]);
+	p_frame[12] = (uint8_t)(ETH_PAT_ETH_TYPE >> 8);
+	p_frame[13] = (uint8_t)ETH_PAT_ETH_TYPE;
+	
+	// 試験ヘッダ
+	memcpy(&p_hdr[HDR_SEQ], &seq, sizeof(seq));
+	memcpy(&p_hdr[HDR_LEN], &len, sizeof(len));
+	p_hdr[HDR_TYPE] = (uint8_t)type;
+	p_hdr[HDR_TYPE + 1] = 0;
+	
+	// パターン
+	pat_fill(&p_frame[ETH_PAT_DATA_OFFSET], size - ETH_PAT_DATA_OFFSET, type, seq);
+}
+
+// 検査情報の初期化
+void eth_pat_check_init(ETH_PAT_CHK *p_chk)
+{
+	memset(p_chk, 0, sizeof(ETH_PAT_CHK));
+}
+
+// 受信フレームの検査
+// 内容を再生成して比較し、seqから欠落、重複、順序入れ替わりを判定する (直近32フレームまで)
+// 戻り値 : ETH_PAT_RES_xxx
+uint32_t eth_pat_check(ETH_PAT_CHK *p_chk, const uint8_t *p_frame, uint32_t size)
+{
+	const uint8_t *p_hdr = &p_frame[ETH_PAT_HDR_OFFSET];
+	uint32_t seq;
+	uint16_t len;
+	uint32_t type;
+	int32_t diff;
+	uint32_t n;
+	
+	// 試験フレーム以外
+	if ((size < ETH_PAT_DATA_OFFSET) ||
+		(p_frame[12] != (uint8_t)(ETH_PAT_ETH_TYPE >> 8)) || (p_frame[13] != (uint8_t)ETH_PAT_ETH_TYPE)) {
+		p_chk->other_cnt++;
+		return ETH_PAT_RES_OTHER;
+	}
+	p_chk->rx_cnt++;
+	
+	// 内容 (壊れたフレームのseqは信用できないので順序判定には使わない)
+	memcpy(&seq, &p_hdr[HDR_SEQ], sizeof(seq));
+	memcpy(&len, &p_hdr[HDR_LEN], sizeof(len));
+	type = p_hdr[HDR_TYPE];
+	if ((len != size) || (type >= ETH_PAT_TYPE_NUM) ||
+		(pat_compare(&p_frame[ETH_PAT_DATA_OFFSET], size - ETH_PAT_DATA_OFFSET, type, seq) != 0)) {
+		p_chk->corrupt_cnt++;
+		return ETH_PAT_RES_CORRUPT;
+	}
+	
+	// 最初のフレーム
+	if (p_chk->started == 0) {
+		p_chk->started = 1;
+		p_chk->next_seq = seq;
+		p_chk->window = 0xFFFFFFFF;		// 開始前のフレームは重複扱い
+	}
+	
+	// 期待値以降 : 間のフレームは欠落
+	diff = (int32_t)(seq - p_chk->next_seq);
+	if (diff >= 0) {
+		p_chk->lost_cnt += diff;
+		p_chk->window = ((diff + 1) >= 32) ? 0 : (p_chk->window << (diff + 1));
+		p_chk->window |= 1;
+		p_chk->next_seq = seq + 1;
+		p_chk->ok_cnt++;
+		p_chk->byte_cnt += size;
+		return ETH_PAT_RES_OK;
+	}
+	
+	// 期待値より前 : 受信済みなら重複、未受信なら欠落扱いを取り消す
+	n = p_chk->next_seq - 1 - seq;
+	if ((n >= 32) || ((p_chk->window & (1UL << n)) != 0)) {
+		p_chk->dup_cnt++;
+		return ETH_PAT_RES_DUP;
+	}
+	p_chk->window |= (1UL << n);
+	p_chk->lost_cnt--;
+	p_chk->reorder_cnt++;
+	p_chk->ok_cnt++;
+	p_chk->byte_cnt += size;
+	
+	return ETH_PAT_RES_REORDER;
+}
@@ -0,0 +1,52 @@
+/*
+ * eth_pat.h
+ *
+ *  Created on: 2026/2/14
+ *      Author: user
+ */
+
+#ifndef DRV_ETH_PAT_H_
+#define DRV_ETH_PAT_H_
+
+// 試験フレーム
+// |<- 14 ->|<------- 8 ------->|<-- size - 22 -->|
+// | ETHヘッダ | seq | len | type | rsv | パターン           |
+// パターンはseqから生成するので受信側は送信側と同じ値を再生成して比較する
+#define ETH_PAT_ETH_TYPE	(0x88B5)	// EtherType (ローカル実験用)
+#define ETH_PAT_HDR_OFFSET	(14)		// 試験ヘッダの位置
+#define ETH_PAT_DATA_OFFSET	(22)		// パターンの位置
+#define ETH_PAT_SIZE_MIN	(60)		// 最小フレームサイズ (FCSなし)
+#define ETH_PAT_SIZE_MAX	(1514)		// 最大フレームサイズ (FCSなし)
+
+// パターン種別
+#define ETH_PAT_TYPE_CNT	(0)		// 32bitカウンタ (seqから1ずつ増える)
+#define ETH_PAT_TYPE_PRBS	(1)		// 疑似乱数 (seqを種にしたxorshift32)
+#define ETH_PAT_TYPE_NUM	(2)
+
+// 検査結果
+#define ETH_PAT_RES_OK		(0)		// 正常
+#define ETH_PAT_RES_OTHER	(1)		// 試験フレームではない
+#define ETH_PAT_RES_CORRUPT	(2)		// 内容不一致
+#define ETH_PAT_RES_DUP		(3)		// 重複
+#define ETH_PAT_RES_REORDER	(4)		// 順序入れ替わり (欠落扱いだったフレームが後から届いた)
+
+// 検査情報 (使用者が確保してeth_pat_check_init()で初期化する)
+typedef struct {
+	uint32_t	started;		// 最初のフレームを受信済み
+	uint32_t	next_seq;		// 次に期待するseq
+	uint32_t	window;			// next_seq-1-n のフレームを受信済みならbit n = 1
+	uint32_t	rx_cnt;			// 試験フレーム受信数
+	uint32_t	ok_cnt;			// 正常受信数
+	uint32_t	lost_cnt;		// 欠落数 (順序入れ替わりで届いたものは除く)
+	uint32_t	dup_cnt;		// 重複数
+	uint32_t	reorder_cnt;	// 順序入れ替わり数
+	uint32_t	corrupt_cnt;	// 内容不一致数
+	uint32_t	other_cnt;		// 試験フレーム以外の受信数
+	uint64_t	byte_cnt;		// 正常受信バイト数
+} ETH_PAT_CHK;
+
+extern void eth_pat_build(uint8_t *p_frame, uint32_t size, const uint8_t *p_dst, uint32_t type, uint32_t seq);
+extern void eth_pat_check_init(ETH_PAT_CHK *p_chk);
+extern uint32_t eth_pat_check(ETH_PAT_CHK *p_chk, const uint8_t *p_frame, uint32_t size);
+
+#endif /* DRV_ETH_PAT_H_ */
@@ -11,15 +11,105 @@
 #include "stm32f7xx.h"
 #include "cmsis_os.h"
 #include "console.h"
+#include "cpu_load.h"
+#include "mem_plan.h"
+#include "pkt_buf.h"
 
 #include "eth.h"
+#include "eth_if.h"
+#include "eth_pat.h"
 
-extern uint8_t eth_send_data[5000];
+#define TT_TEST_FRAME_SIZE	(64)	// タイムトリガ送信テストのフレームサイズ
+#define SEND_TEST_FRAME_SIZE	(1514)	// 送信テストのフレームサイズ
+#define TT_TEST_LOG_NUM		(16)	// 表示する周期ごとのオフセット数
+#define FILTER_TEST_NUM		(16)	// 表示する受信アドレス数
+#define RECV_TEST_TMOUT		(1000)	// 受信テストのタイムアウト[ms]
+#define VLAN_TEST_FRAME_SIZE	(1514)		// VLAN送信テストのフレームサイズ (タグなし)
+#define DMA_BENCH_SIZE_MAX		(1514)		// DMAベンチマークのフレームサイズ最大値
+#define IF_BENCH_RX_TMOUT		(10)		// 受信ベンチマークの受信待ち時間[ms]
+#define VLAN_TEST_TCI			(0xE001)	// VLAN送信テストのTCI (PCP=7, VID=1)
+#define PKTGEN_SIZE_MIN			(60)		// パケットジェネレータのフレームサイズ最小値 (FCSなし)
+#define PKTGEN_SIZE_MAX			(1514)		// パケットジェネレータのフレームサイズ最大値 (FCSなし)
+#define PKTGEN_STALL_MS			(1000)		// 送信ディスクリプタが空かないまま中止するまでの時間[ms]
+#define LAT_BENCH_NUM_MAX		(1000)		// ループバック遅延ベンチマークの1サイズあたりの最大送信数
+#define LAT_BENCH_TMOUT			(100)		// ループバック遅延ベンチマークの受信待ち時間[ms]
+#define TSO_TEST_SIZE_MAX		(8192)		// TSOテストのペイロードサイズ最大値
+#define LAT_BENCH_HIST_NUM		(10)		// ループバック遅延ヒストグラムの区間数 (1us未満～256us以上)
+
+static uint8_t eth_recv_data[1536] MEM_PLAN(test);
+static uint8_t eth_test_frame[ETH_PAT_SIZE_MAX] __attribute__((aligned(4))) MEM_PLAN(test);
+static uint32_t eth_test_seq MEM_PLAN(test);
+static ETH_PAT_CHK eth_test_chk MEM_PLAN(test);
+static uint8_t tso_test_data[TSO_TEST_SIZE_MAX] __attribute__((aligned(4))) MEM_PLAN(test);
+static const uint8_t eth_test_bcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint32_t lat_bench_sample[LAT_BENCH_NUM_MAX] MEM_PLAN(test);
 
 static const ETH_OPEN eth_open_par = {
 	COM_MODE_FULL_DUPLEX,
+	// 送受信ストアアンドフォワード、OSFあり、32beatバースト (スレッショルドは未使用)
+	{1, 1, 1, 32, 0, 0},
+};
+
+// DMAベンチマークで評価する動作モード
+typedef struct {
+	const char	*name;
+	ETH_DMA_PAR	dma;
+} DMA_BENCH_MODE;
+static const DMA_BENCH_MODE dma_bench_mode_tbl[] = {
+	// name			tx_sf	rx_sf	osf		pbl		tx_thresh	rx_thresh
+	{"ct16",		{0,		0,		0,		16,		16,			32}},
+	{"ct64",		{0,		0,		0,		16,		64,			64}},
+	{"ct256",		{0,		0,		0,		16,		256,		128}},
+	{"ct64_pbl4",	{0,		0,		0,		4,		64,			64}},
+	{"sf",			{1,		1,		0,		16,		0,			0}},
+	{"sf_osf",		{1,		1,		1,		16,		0,			0}},
+	{"sf_osf_pbl4",	{1,		1,		1,		4,		0,			0}},
+	{"sf_osf_pbl32",{1,		1,		1,		32,		0,			0}},
+};
+
+// パケットジェネレータのフレームサイズ
+#define PKTGEN_SIZE_FIXED	(0)		// 固定
+#define PKTGEN_SIZE_SWEEP	(1)		// min-maxをstepずつ増やす
+#define PKTGEN_SIZE_IMIX	(2)		// IMIX (64:594:1518を7:4:1、FCS込み)
+typedef struct {
+	uint32_t	mode;		// PKTGEN_SIZE_xxx
+	uint32_t	min;		// 最小値 (固定の場合はサイズ)
+	uint32_t	max;		// 最大値
+	uint32_t	step;		// 増分
+} PKTGEN_SIZE;
+static const uint16_t pktgen_imix_tbl[] = {
+	60, 60, 590, 60, 60, 590, 60, 590, 60, 60, 590, 1514,
+};
+
+// TSOテストのヘッダテンプレート
+// raw : ETH + 32bitシーケンス番号
+// udp : ETH + IPv4(192.168.0.10 → 255.255.255.255) + UDP(5001 → 5001)
+static const uint8_t tso_test_raw_hdr[18] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	(uint8_t)(ETH_PAT_ETH_TYPE >> 8), (uint8_t)ETH_PAT_ETH_TYPE,
+	0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t tso_test_udp_hdr[42] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x00,
+	0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11, 0x00, 0x00,
+	192, 168, 0, 10, 255, 255, 255, 255,
+	0x13, 0x89, 0x13, 0x89, 0x00, 0x00, 0x00, 0x00,
+};
+
+// ループバック遅延ベンチマークのフレームサイズ (FCSなし)
+static const uint16_t lat_bench_size_tbl[] = {
+	60, 128, 256, 512, 1024, 1514,
 };
 
+// 試験フレーム作成 (ブロードキャスト、カウンタパターン)
+static uint8_t* eth_test_make_frame(uint32_t size)
+{
+	eth_pat_build(eth_test_frame, size, eth_test_bcast, ETH_PAT_TYPE_CNT, eth_test_seq++);
+	
+	return eth_test_frame;
+}
+
 // オープン
 void eth_test_open(void)
 {
@@ -37,11 +127,54 @@ void eth_test_send(void)
 	osStatus ercd;
 	
 	// 送信
-	ercd = eth_send(eth_send_data, sizeof(eth_send_data));
+	ercd = eth_send(eth_test_make_frame(SEND_TEST_FRAME_SIZE), SEND_TEST_FRAME_SIZE);
 	console_printf("eth_send:ercd = %d\n", ercd);
 	
 }
 
+// 受信
+void eth_test_recv(void)
+{
+	int32_t len;
+	
+	// 受信
+	len = eth_recv(eth_recv_data, sizeof(eth_recv_data), RECV_TEST_TMOUT);
+	console_printf("eth_recv:len = %d\n", len);
+	
+}
+
+// VLANタグ付き送信
+void eth_test_send_vlan(void)
+{
+	osStatus ercd;
+	
+	// 送信
+	ercd = eth_send_vlan(eth_test_make_frame(VLAN_TEST_FRAME_SIZE), VLAN_TEST_FRAME_SIZE, VLAN_TEST_TCI);
+	console_printf("eth_send_vlan:ercd = %d\n", ercd);
+	
+}
+
+// パケットバッファ統計
+void eth_test_pkt_stat(void)
+{
+	PKT_BUF_STAT stat;
+	
+	pkt_get_stat(&stat);
+	console_printf("pkt_buf total:%u free:%u min:%u\n", stat.total_num, stat.free_num, stat.free_min);
+	console_printf("alloc:%u fail:%u\n", stat.alloc_cnt, stat.fail_cnt);
+	
+}
+
+// 共通インタフェースでオープン (ビルド時に選択したドライバ)
+void eth_test_if_open(void)
+{
+	osStatus ercd;
+	
+	ercd = eth_if_open();
+	console_printf("eth_if_open(%s):ercd = %d\n", eth_if_get_name(), ercd);
+	
+}
+
 // コマンド
 static void eth_test_cmd(int argc, char *argv[])
 {
@@ -52,6 +185,10 @@ static void eth_test_cmd(int argc, char *argv[])
 		console_printf("eth_cmd <idx>\n");
 		console_printf("eth_cmd 0 : eth_open\n");
 		console_printf("eth_cmd 1 : eth_send\n");
+		console_printf("eth_cmd 2 : eth_recv\n");
+		console_printf("eth_cmd 3 : eth_send_vlan\n");
+		console_printf("eth_cmd 4 : pkt_buf stat\n");
+		console_printf("eth_cmd 5 : eth_if_open\n");
 		return;
 	}
 	
@@ -62,11 +199,920 @@ static void eth_test_cmd(int argc, char *argv[])
 		eth_test_open();
 	} else if (idx == 1) {
 		eth_test_send();
+	} else if (idx == 2) {
+		eth_test_recv();
+	} else if (idx == 3) {
+		eth_test_send_vlan();
+	} else if (idx == 4) {
+		eth_test_pkt_stat();
+	} else if (idx == 5) {
+		eth_test_if_open();
+	} else {
+		
+	}
+}
+
+// タイムトリガ送信テスト
+static void eth_test_tt_cmd(int argc, char *argv[])
+{
+	ETH_TT_STAT stat;
+	int32_t log[TT_TEST_LOG_NUM];
+	uint32_t period_us;
+	uint32_t cycle;
+	uint32_t tmout;
+	uint32_t log_num;
+	uint32_t i;
+	osStatus ercd;
+	
+	// 引数チェック
+	if (argc < 3) {
+		console_printf("eth_tt <period_us> <cycle>\n");
+		return;
+	}
+	
+	// 値設定
+	period_us = atoi(argv[1]);
+	cycle = atoi(argv[2]);
+	
+	// 開始
+	if ((ercd = eth_tt_start(period_us * 1000)) != osOK) {
+		console_printf("eth_tt_start:ercd = %d\n", ercd);
+		return;
+	}
+	
+	// 指定周期分送信するまでキューを満たし続ける (ターゲット時刻割り込みが来ない場合に備えてタイムアウト[ms]を設ける)
+	eth_test_make_frame(TT_TEST_FRAME_SIZE);
+	tmout = (period_us * cycle) / 1000 + 1000;
+	while (tmout-- > 0) {
+		eth_tt_get_stat(&stat);
+		if ((stat.send_cnt + stat.miss_cnt) >= cycle) {
+			break;
+		}
+		while (eth_tt_queue(eth_test_frame, TT_TEST_FRAME_SIZE) == osOK);
+		osDelay(1);
+	}
+	
+	// 停止
+	eth_tt_stop();
+	eth_tt_get_stat(&stat);
+	
+	// 結果表示
+	console_printf("cycle:%u send:%u idle:%u miss:%u err:%u\n", stat.cycle_cnt, stat.send_cnt, stat.idle_cnt, stat.miss_cnt, stat.err_cnt);
+	console_printf("offset[ns] min:%d avg:%d max:%d jitter:%d\n", stat.offset_min, stat.offset_avg, stat.offset_max, stat.offset_max - stat.offset_min);
+	log_num = eth_tt_get_log(log, TT_TEST_LOG_NUM);
+	for (i = 0; i < log_num; i++) {
+		console_printf("  [%u] %d\n", i, log[i]);
+	}
+}
+
+// MACアドレス文字列(xx:xx:xx:xx:xx:xx)の変換
+static osStatus eth_test_parse_mac(char *str, uint8_t *p_addr)
+{
+	char *p_end;
+	uint8_t i;
+	
+	for (i = 0; i < 6; i++) {
+		p_addr[i] = (uint8_t)strtoul(str, &p_end, 16);
+		// 区切り文字チェック
+		if ((p_end == str) || ((i < 5) && (*p_end != ':'))) {
+			return osErrorParameter;
+		}
+		str = p_end + 1;
+	}
+	
+	return osOK;
+}
+
+// 受信アドレスフィルタテスト
+static void eth_test_filter_cmd(int argc, char *argv[])
+{
+	ETH_FILTER_INFO info[FILTER_TEST_NUM];
+	uint8_t addr[6];
+	uint32_t num;
+	uint32_t i;
+	osStatus ercd;
+	
+	// 一覧表示
+	if (argc < 3) {
+		console_printf("eth_filt <add|del> <xx:xx:xx:xx:xx:xx>\n");
+		num = eth_filter_get(info, FILTER_TEST_NUM);
+		for (i = 0; i < num; i++) {
+			console_printf("%x:%x:%x:%x:%x:%x ref:%u ", info[i].addr[0], info[i].addr[1], info[i].addr[2], info[i].addr[3], info[i].addr[4], info[i].addr[5], info[i].ref);
+			if (info[i].slot == ETH_FILTER_SLOT_HASH) {
+				console_printf("hash:%u\n", info[i].hash_bit);
+			} else {
+				console_printf("MACA%u\n", info[i].slot + 1);
+			}
+		}
+		return;
+	}
+	
+	// アドレス変換
+	if (eth_test_parse_mac(argv[2], addr) != osOK) {
+		console_printf("invalid address\n");
+		return;
+	}
+	
+	if (strcmp(argv[1], "add") == 0) {
+		ercd = eth_filter_add(addr);
+		console_printf("eth_filter_add:ercd = %d\n", ercd);
+	} else if (strcmp(argv[1], "del") == 0) {
+		ercd = eth_filter_del(addr);
+		console_printf("eth_filter_del:ercd = %d\n", ercd);
 	} else {
 		
 	}
 }
 
+// フロー制御テスト
+static void eth_test_fc_cmd(int argc, char *argv[])
+{
+	ETH_FC_PAR par;
+	ETH_FC_STAT stat;
+	osStatus ercd;
+	
+	// 統計表示
+	if (argc < 6) {
+		console_printf("eth_fc <tx> <rx> <pause_time> <high> <low>\n");
+		eth_fc_get_stat(&stat);
+		console_printf("xoff:%u xon:%u\n", stat.xoff_cnt, stat.xon_cnt);
+		console_printf("pause_us total:%u max:%u\n", stat.pause_us_total, stat.pause_us_max);
+		console_printf("rx_pause:%u quanta:%u\n", stat.rx_pause_cnt, stat.rx_pause_quanta);
+		console_printf("ring max:%u full:%u\n", stat.ring_max, stat.ring_full_cnt);
+		return;
+	}
+	
+	// 値設定
+	par.tx_enable = atoi(argv[1]);
+	par.rx_enable = atoi(argv[2]);
+	par.pause_time = atoi(argv[3]);
+	par.high_thresh = atoi(argv[4]);
+	par.low_thresh = atoi(argv[5]);
+	
+	ercd = eth_fc_config(&par);
+	console_printf("eth_fc_config:ercd = %d\n", ercd);
+}
+
+// VLANテスト
+static void eth_test_vlan_cmd(int argc, char *argv[])
+{
+	ETH_VLAN_PAR par;
+	ETH_VLAN_STAT stat;
+	uint32_t i;
+	osStatus ercd;
+	
+	// 統計表示
+	if (argc < 2) {
+		console_printf("eth_vlan <vid> [<pcp0 prio> ... <pcp7 prio>]\n");
+		eth_vlan_get_stat(&stat);
+		for (i = 0; i < ETH_PRIO_NUM; i++) {
+			console_printf("prio%u:%u\n", i, stat.rx_cnt[i]);
+		}
+		console_printf("tagged:%u vid_drop:%u\n", stat.tagged_cnt, stat.vid_drop_cnt);
+		return;
+	}
+	
+	// 値設定 (優先度の指定がなければIEEE 802.1Qの推奨値)
+	par.vid = atoi(argv[1]);
+	eth_vlan_get_default_map(par.prio_map);
+	if (argc >= (int)(2 + sizeof(par.prio_map))) {
+		for (i = 0; i < sizeof(par.prio_map); i++) {
+			par.prio_map[i] = atoi(argv[2 + i]);
+		}
+	}
+	
+	ercd = eth_vlan_config(&par);
+	console_printf("eth_vlan_config:ercd = %d\n", ercd);
+}
+
+// DMA動作モードのベンチマーク
+// 動作モードを切り替えながらnum回送信して、スループット、送信1回の時間、アンダーフロー回数を表示
+static void eth_test_dma_bench_cmd(int argc, char *argv[])
+{
+	const DMA_BENCH_MODE *p_mode;
+	ETH_DMA_PAR dma;
+	ETH_DMA_STAT stat;
+	uint32_t num;
+	uint32_t size;
+	uint32_t i, j;
+	uint32_t cyc_per_us;
+	uint32_t start, lat, total;
+	uint32_t lat_min, lat_max;
+	uint32_t err_cnt;
+	uint32_t total_us;
+	osStatus ercd;
+	
+	// 引数チェック
+	if (argc < 3) {
+		console_printf("eth_dma_bench <num> <size>\n");
+		return;
+	}
+	
+	// 値設定
+	num = atoi(argv[1]);
+	size = atoi(argv[2]);
+	if ((num == 0) || (size < 60) || (size > DMA_BENCH_SIZE_MAX)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	cyc_per_us = SystemCoreClock / 1000000;
+	eth_test_make_frame(size);
+	
+	for (i = 0; i < sizeof(dma_bench_mode_tbl)/sizeof(dma_bench_mode_tbl[0]); i++) {
+		p_mode = &dma_bench_mode_tbl[i];
+		
+		// 動作モード変更
+		dma = p_mode->dma;
+		if ((ercd = eth_dma_config(&dma)) != osOK) {
+			console_printf("eth_dma_config:ercd = %d\n", ercd);
+			return;
+		}
+		eth_dma_clear_stat();
+		
+		// 送信
+		lat_min = 0xFFFFFFFF;
+		lat_max = 0;
+		total = 0;
+		err_cnt = 0;
+		for (j = 0; j < num; j++) {
+			start = DWT->CYCCNT;
+			if (eth_send(eth_test_frame, size) != osOK) {
+				err_cnt++;
+			}
+			lat = DWT->CYCCNT - start;
+			total += lat;
+			if (lat < lat_min) {
+				lat_min = lat;
+			}
+			if (lat > lat_max) {
+				lat_max = lat;
+			}
+		}
+		eth_dma_get_stat(&stat);
+		
+		// 結果表示
+		total_us = total / cyc_per_us;
+		if (total_us == 0) {
+			total_us = 1;
+		}
+		console_printf("%s: %u Mbps underflow:%u err:%u\n", p_mode->name, (num * size * 8) / total_us, stat.tx_underflow_cnt, err_cnt);
+		console_printf("  latency[us] min:%u avg:%u max:%u\n", lat_min / cyc_per_us, total_us / num, lat_max / cyc_per_us);
+	}
+	
+	// デフォルトに戻す
+	dma = eth_open_par.dma;
+	eth_dma_config(&dma);
+}
+
+// ドライバ比較ベンチマーク
+// tx : num回送信してスループット、送信1回の時間、1フレームあたりのCPUサイクル数を表示
+// rx : time[ms]の間受信してフレーム数、スループット、1フレームあたりのCPUサイクル数を表示
+static void eth_test_if_bench_cmd(int argc, char *argv[])
+{
+	PKT_BUF *p_pkt;
+	CPU_LOAD_MEAS meas;
+	uint32_t cyc_per_us;
+	uint32_t num, size, time;
+	uint32_t i;
+	uint32_t start, lat, total;
+	uint32_t lat_min, lat_max;
+	uint64_t busy;
+	uint32_t frame_cnt, byte_cnt;
+	uint32_t err_cnt;
+	uint32_t total_us;
+	
+	// 引数チェック
+	if (argc < 3) {
+		console_printf("eth_if_bench tx <num> <size>\n");
+		console_printf("eth_if_bench rx <time_ms>\n");
+		return;
+	}
+	
+	cyc_per_us = SystemCoreClock / 1000000;
+	cpu_load_calibrate();
+	console_printf("driver:%s\n", eth_if_get_name());
+	
+	// 送信
+	if ((strcmp(argv[1], "tx") == 0) && (argc >= 4)) {
+		num = atoi(argv[2]);
+		size = atoi(argv[3]);
+		if ((num == 0) || (size < 60) || (size > DMA_BENCH_SIZE_MAX)) {
+			console_printf("invalid parameter\n");
+			return;
+		}
+		
+		eth_test_make_frame(size);
+		lat_min = 0xFFFFFFFF;
+		lat_max = 0;
+		err_cnt = 0;
+		cpu_load_start(&meas);
+		total = DWT->CYCCNT;
+		for (i = 0; i < num; i++) {
+			start = DWT->CYCCNT;
+			if (eth_if_send(eth_test_frame, size) != osOK) {
+				err_cnt++;
+			}
+			lat = DWT->CYCCNT - start;
+			if (lat < lat_min) {
+				lat_min = lat;
+			}
+			if (lat > lat_max) {
+				lat_max = lat;
+			}
+		}
+		total = DWT->CYCCNT - total;
+		cpu_load_stop(&meas, &busy);
+		
+		total_us = total / cyc_per_us;
+		if (total_us == 0) {
+			total_us = 1;
+		}
+		console_printf("tx: %u Mbps err:%u\n", (num * size * 8) / total_us, err_cnt);
+		console_printf("  latency[us] min:%u avg:%u max:%u\n", lat_min / cyc_per_us, total_us / num, lat_max / cyc_per_us);
+		console_printf("  cpu cycles/frame:%u\n", (uint32_t)(busy / num));
+		
+	// 受信
+	} else if (strcmp(argv[1], "rx") == 0) {
+		time = atoi(argv[2]);
+		if ((time == 0) || (time > 10000)) {
+			console_printf("invalid parameter\n");
+			return;
+		}
+		
+		frame_cnt = 0;
+		byte_cnt = 0;
+		cpu_load_start(&meas);
+		start = osKernelSysTick();
+		total = DWT->CYCCNT;
+		while ((osKernelSysTick() - start) < time) {
+			if ((p_pkt = eth_if_recv(IF_BENCH_RX_TMOUT)) != NULL) {
+				frame_cnt++;
+				byte_cnt += p_pkt->len;
+				pkt_free(p_pkt);
+			}
+		}
+		total = DWT->CYCCNT - total;
+		cpu_load_stop(&meas, &busy);
+		
+		total_us = total / cyc_per_us;
+		console_printf("rx: %u frames %u Mbps\n", frame_cnt, (byte_cnt * 8) / total_us);
+		console_printf("  cpu cycles/frame:%u\n", (frame_cnt != 0) ? (uint32_t)(busy / frame_cnt) : 0);
+		
+	} else {
+		console_printf("invalid parameter\n");
+	}
+}
+
+// パケットジェネレータのサイズ指定(size、min-max[:step]、imix)の変換
+static osStatus pktgen_parse_size(char *str, PKTGEN_SIZE *p_size)
+{
+	char *p_end;
+	
+	if (strcmp(str, "imix") == 0) {
+		p_size->mode = PKTGEN_SIZE_IMIX;
+		p_size->min = pktgen_imix_tbl[0];
+		p_size->max = PKTGEN_SIZE_MAX;
+		return osOK;
+	}
+	
+	p_size->min = strtoul(str, &p_end, 10);
+	p_size->max = p_size->min;
+	p_size->step = 1;
+	p_size->mode = PKTGEN_SIZE_FIXED;
+	if (*p_end == '-') {
+		p_size->mode = PKTGEN_SIZE_SWEEP;
+		str = p_end + 1;
+		p_size->max = strtoul(str, &p_end, 10);
+		if (*p_end == ':') {
+			str = p_end + 1;
+			p_size->step = strtoul(str, &p_end, 10);
+		}
+	}
+	
+	// 範囲チェック
+	if ((*p_end != '\0') || (p_size->min < PKTGEN_SIZE_MIN) || (p_size->max > PKTGEN_SIZE_MAX) ||
+		(p_size->min > p_size->max) || (p_size->step == 0)) {
+		return osErrorParameter;
+	}
+	
+	return osOK;
+}
+
+// パケットジェネレータ
+// テンプレートフレームを指定したレート(pps、Mbps)、サイズ、個数で送信する
+// 送信間隔はサイクルカウンタで計る (レート0は送信ディスクリプタが空き次第送信)
+// 結果として実レート、ディスクリプタ不足で待たされたフレーム数、1フレームあたりの送信処理サイクル数を表示
+static void eth_test_pktgen_cmd(int argc, char *argv[])
+{
+	PKTGEN_SIZE size;
+	ETH_DMA_STAT stat;
+	uint8_t dst[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	uint32_t num = 0;
+	uint32_t rate = 0;
+	uint32_t rate_mbps = 0;
+	uint32_t cyc_per_us;
+	uint32_t len, idx;
+	uint32_t interval;
+	uint32_t now, prev, next;
+	uint32_t start, lat, wait_start;
+	uint32_t sent, starve_cnt, drop_cnt;
+	uint32_t starved;
+	uint64_t byte_cnt;
+	uint64_t send_cyc;
+	uint64_t total_cyc;
+	uint64_t total_us;
+	char *p_end;
+	int i;
+	osStatus ercd;
+	
+	// 引数解析
+	size.mode = PKTGEN_SIZE_FIXED;
+	size.min = PKTGEN_SIZE_MIN;
+	size.max = PKTGEN_SIZE_MIN;
+	size.step = 1;
+	for (i = 1; i < argc - 1; i += 2) {
+		if (strcmp(argv[i], "-n") == 0) {
+			num = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-s") == 0) {
+			if (pktgen_parse_size(argv[i + 1], &size) != osOK) {
+				num = 0;
+				break;
+			}
+		} else if (strcmp(argv[i], "-r") == 0) {
+			rate = strtoul(argv[i + 1], &p_end, 10);
+			rate_mbps = (*p_end == 'm') ? 1 : 0;
+		} else if (strcmp(argv[i], "-d") == 0) {
+			if (eth_test_parse_mac(argv[i + 1], dst) != osOK) {
+				num = 0;
+				break;
+			}
+		} else {
+			num = 0;
+			break;
+		}
+	}
+	if ((num == 0) || (i != argc)) {
+		console_printf("pktgen -n <count> [-s <size>|<min>-<max>[:step]|imix] [-r <rate>[p|m]] [-d <mac>]\n");
+		return;
+	}
+	
+	// テンプレート作成 (宛先、送信元、EtherType、インクリメントデータ)
+	memcpy(&eth_test_frame[0], dst, 6);
+	eth_get_mac_addr(&eth_test_frame[6]);
+	eth_test_frame[12] = (uint8_t)(ETH_PAT_ETH_TYPE >> 8);
+	eth_test_frame[13] = (uint8_t)ETH_PAT_ETH_TYPE;
+	for (len = 14; len < PKTGEN_SIZE_MAX; len++) {
+		eth_test_frame[len] = (uint8_t)len;
+	}
+	
+	cyc_per_us = SystemCoreClock / 1000000;
+	
+	// 前回の送信が残っていれば待つ
+	eth_tx_flush(PKTGEN_STALL_MS);
+	eth_dma_clear_stat();
+	
+	sent = 0;
+	starve_cnt = 0;
+	drop_cnt = 0;
+	byte_cnt = 0;
+	send_cyc = 0;
+	total_cyc = 0;
+	idx = 0;
+	len = size.min;
+	interval = 0;
+	prev = DWT->CYCCNT;
+	next = prev;
+	while (sent < num) {
+		// 送信間隔 (Mbps指定はフレームサイズから計算する)
+		if (rate != 0) {
+			interval = rate_mbps ? ((len * 8 * cyc_per_us) / rate) : (SystemCoreClock / rate);
+		}
+		
+		// 送信時刻まで待つ (1ms以上先なら他のタスクに譲る)
+		while (1) {
+			now = DWT->CYCCNT;
+			total_cyc += now - prev;
+			prev = now;
+			if ((int32_t)(next - now) <= 0) {
+				break;
+			}
+			if ((next - now) > (cyc_per_us * 1000)) {
+				osDelay(1);
+			}
+		}
+		// 送信が間に合わなかった分をまとめて送らない
+		if ((now - next) > interval) {
+			next = now;
+		}
+		next += interval;
+		
+		// 送信 (ディスクリプタが空いていなければ他のタスクに譲ってから再送)
+		// 同じ優先度のタスクに譲り、1tick以上空かなければ低い優先度のタスクにも譲る
+		starved = 0;
+		wait_start = osKernelSysTick();
+		while (1) {
+			start = DWT->CYCCNT;
+			ercd = eth_send_nowait(eth_test_frame, len);
+			lat = DWT->CYCCNT - start;
+			if ((ercd != osErrorResource) || ((osKernelSysTick() - wait_start) >= PKTGEN_STALL_MS)) {
+				break;
+			}
+			starved = 1;
+			if (osKernelSysTick() == wait_start) {
+				osThreadYield();
+			} else {
+				osDelay(1);
+			}
+		}
+		if (ercd == osErrorResource) {
+			console_printf("tx stalled\n");
+			break;
+		}
+		// 送信処理のサイクル数は空き待ちを除いた最後の1回分
+		send_cyc += lat;
+		starve_cnt += starved;
+		if (ercd != osOK) {
+			drop_cnt++;
+		} else {
+			byte_cnt += len;
+		}
+		sent++;
+		
+		// 次のフレームサイズ
+		if (size.mode == PKTGEN_SIZE_SWEEP) {
+			len += size.step;
+			if (len > size.max) {
+				len = size.min;
+			}
+		} else if (size.mode == PKTGEN_SIZE_IMIX) {
+			idx = (idx + 1) % (sizeof(pktgen_imix_tbl)/sizeof(pktgen_imix_tbl[0]));
+			len = pktgen_imix_tbl[idx];
+		}
+	}
+	
+	// 送信完了待ち (テンプレートを書き換えないように)
+	eth_tx_flush(PKTGEN_STALL_MS);
+	total_cyc += DWT->CYCCNT - prev;
+	eth_dma_get_stat(&stat);
+	
+	// 結果表示
+	total_us = total_cyc / cyc_per_us;
+	if (total_us == 0) {
+		total_us = 1;
+	}
+	console_printf("pktgen: %u frames %u pps %u Mbps\n", sent - drop_cnt, (uint32_t)(((uint64_t)(sent - drop_cnt) * 1000000) / total_us), (uint32_t)((byte_cnt * 8) / total_us));
+	console_printf("  starve:%u err:%u underflow:%u tx_err:%u\n", starve_cnt, drop_cnt, stat.tx_underflow_cnt, stat.tx_err_cnt);
+	console_printf("  tx cycles/frame:%u\n", (sent != 0) ? (uint32_t)(send_cyc / sent) : 0);
+}
+
+// 昇順ソート用の比較関数
+static int lat_bench_compare(const void *p_a, const void *p_b)
+{
+	uint32_t a = *(const uint32_t*)p_a;
+	uint32_t b = *(const uint32_t*)p_b;
+	
+	return (a > b) - (a < b);
+}
+
+// ループバック遅延の計測 (1サイズ分)
+// eth_send()の呼び出し直前からeth_recv_pkt()で折り返しフレームを受け取るまでのサイクル数をnum回計測する
+// 戻り値 : 計測できた数
+static uint32_t lat_bench_run(uint32_t size, uint32_t num, uint32_t *p_lost)
+{
+	PKT_BUF *p_pkt;
+	uint32_t i;
+	uint32_t start;
+	uint32_t cnt = 0;
+	uint32_t seq;
+	
+	*p_lost = 0;
+	for (i = 0; i < num; i++) {
+		// 宛先と送信元は自MACアドレス、ペイロード先頭にシーケンス番号
+		memcpy(&eth_test_frame[14], &i, sizeof(i));
+		
+		start = DWT->CYCCNT;
+		if (eth_send(eth_test_frame, size) != osOK) {
+			(*p_lost)++;
+			continue;
+		}
+		// 自分のフレームが返ってくるまで待つ (他のフレームは捨てる)
+		while ((p_pkt = eth_recv_pkt(LAT_BENCH_TMOUT)) != NULL) {
+			memcpy(&seq, &(p_pkt->p_data[14]), sizeof(seq));
+			if ((p_pkt->len == size) && (seq == i)) {
+				lat_bench_sample[cnt++] = DWT->CYCCNT - start;
+				pkt_free(p_pkt);
+				break;
+			}
+			pkt_free(p_pkt);
+		}
+		if (p_pkt == NULL) {
+			(*p_lost)++;
+		}
+	}
+	
+	return cnt;
+}
+
+// サイクル数[cycle]をナノ秒[ns]に変換
+static uint32_t lat_bench_ns(uint32_t cyc)
+{
+	return (uint32_t)(((uint64_t)cyc * 1000) / (SystemCoreClock / 1000000));
+}
+
+// ループバック遅延ベンチマーク
+// MACループバック、PHYループバックでフレームサイズごとに送信から受信までの時間を計測して
+// min/avg/p50/p99/p99.9/max[ns]と2倍ごとの区間のヒストグラムを表示
+static void eth_test_lat_bench_cmd(int argc, char *argv[])
+{
+	PKT_BUF *p_pkt;
+	ETH_LOOPBACK mode;
+	ETH_LOOPBACK prev_mode;
+	uint32_t hist[LAT_BENCH_HIST_NUM];
+	uint32_t size;
+	uint32_t num, cnt, lost;
+	uint32_t i, j;
+	uint32_t cyc_per_us;
+	uint32_t us, bin;
+	uint64_t sum;
+	osStatus ercd;
+	
+	// 引数チェック
+	if (argc < 3) {
+		console_printf("eth_lat <mac|phy> <num> [size]\n");
+		return;
+	}
+	
+	// 値設定
+	if (strcmp(argv[1], "mac") == 0) {
+		mode = ETH_LOOPBACK_MAC;
+	} else if (strcmp(argv[1], "phy") == 0) {
+		mode = ETH_LOOPBACK_PHY;
+	} else {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	num = atoi(argv[2]);
+	size = (argc >= 4) ? atoi(argv[3]) : 0;
+	if ((num == 0) || (num > LAT_BENCH_NUM_MAX) ||
+		((size != 0) && ((size < PKTGEN_SIZE_MIN) || (size > PKTGEN_SIZE_MAX)))) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	// ループバック設定
+	prev_mode = eth_loopback_get();
+	if ((ercd = eth_loopback_config(mode)) != osOK) {
+		console_printf("eth_loopback_config:ercd = %d\n", ercd);
+		return;
+	}
+	// PHYの切り替え待ち
+	osDelay(10);
+	
+	// テンプレート作成 (自分宛て)
+	eth_get_mac_addr(&eth_test_frame[0]);
+	eth_get_mac_addr(&eth_test_frame[6]);
+	eth_test_frame[12] = (uint8_t)(ETH_PAT_ETH_TYPE >> 8);
+	eth_test_frame[13] = (uint8_t)ETH_PAT_ETH_TYPE;
+	
+	cyc_per_us = SystemCoreClock / 1000000;
+	
+	// 受信済みのフレームを捨てる
+	while ((p_pkt = eth_recv_pkt(0)) != NULL) {
+		pkt_free(p_pkt);
+	}
+	
+	console_printf("loopback:%s\n", argv[1]);
+	for (i = 0; i < sizeof(lat_bench_size_tbl)/sizeof(lat_bench_size_tbl[0]); i++) {
+		// サイズ指定がなければ全サイズ
+		if (argc < 4) {
+			size = lat_bench_size_tbl[i];
+		} else if (i != 0) {
+			break;
+		}
+		
+		// 計測
+		cnt = lat_bench_run(size, num, &lost);
+		if (cnt == 0) {
+			console_printf("%u byte: no frame received\n", size);
+			continue;
+		}
+		
+		// 集計 (ヒストグラムは1us未満、1us～、2us～、4us～、... 256us以上)
+		qsort(lat_bench_sample, cnt, sizeof(lat_bench_sample[0]), lat_bench_compare);
+		sum = 0;
+		memset(hist, 0, sizeof(hist));
+		for (j = 0; j < cnt; j++) {
+			sum += lat_bench_sample[j];
+			us = lat_bench_sample[j] / cyc_per_us;
+			bin = 0;
+			while ((us != 0) && (bin < (LAT_BENCH_HIST_NUM - 1))) {
+				us >>= 1;
+				bin++;
+			}
+			hist[bin]++;
+		}
+		
+		// 結果表示
+		console_printf("%u byte: %u frames lost:%u\n", size, cnt, lost);
+		console_printf("  latency[ns] min:%u avg:%u max:%u\n", lat_bench_ns(lat_bench_sample[0]), lat_bench_ns((uint32_t)(sum / cnt)), lat_bench_ns(lat_bench_sample[cnt - 1]));
+		console_printf("  p50:%u p99:%u p99.9:%u\n", lat_bench_ns(lat_bench_sample[(cnt * 500) / 1000]), lat_bench_ns(lat_bench_sample[(cnt * 990) / 1000]), lat_bench_ns(lat_bench_sample[(cnt * 999) / 1000]));
+		for (j = 0; j < LAT_BENCH_HIST_NUM; j++) {
+			if ((hist[j] != 0) && (j < (LAT_BENCH_HIST_NUM - 1))) {
+				console_printf("  <%uus: %u\n", 1 << j, hist[j]);
+			} else if (hist[j] != 0) {
+				console_printf("  >=%uus: %u\n", 1 << (j - 1), hist[j]);
+			}
+		}
+	}
+	
+	// ループバック設定を戻す
+	eth_loopback_config(prev_mode);
+}
+
+// 試験フレームを受信して検査 (戻り値 : 受信したフレーム数)
+static uint32_t eth_test_soak_recv(int32_t tmout)
+{
+	PKT_BUF *p_pkt;
+	uint32_t cnt = 0;
+	
+	while ((p_pkt = eth_recv_pkt(tmout)) != NULL) {
+		eth_pat_check(&eth_test_chk, p_pkt->p_data, p_pkt->len);
+		pkt_free(p_pkt);
+		cnt++;
+	}
+	
+	return cnt;
+}
+
+// 検査結果表示
+static void eth_test_soak_print(uint32_t time_ms)
+{
+	ETH_PAT_CHK *p_chk = &eth_test_chk;
+	
+	if (time_ms == 0) {
+		time_ms = 1;
+	}
+	console_printf("rx:%u ok:%u %u Mbps\n", p_chk->rx_cnt, p_chk->ok_cnt, (uint32_t)((p_chk->byte_cnt * 8) / (time_ms * 1000)));
+	console_printf("  lost:%u dup:%u reorder:%u corrupt:%u other:%u\n", p_chk->lost_cnt, p_chk->dup_cnt, p_chk->reorder_cnt, p_chk->corrupt_cnt, p_chk->other_cnt);
+}
+
+// データ整合性の耐久試験
+// tx : シーケンス番号付きの試験フレームをnum回送信 (size 0は60～1514byteを順に変える)
+// rx : time[ms]の間受信して欠落、重複、順序入れ替わり、内容不一致を検査
+// lb : ループバックで送信して折り返しフレームを検査
+static void eth_test_soak_cmd(int argc, char *argv[])
+{
+	const uint8_t *p_dst;
+	uint8_t own[6];
+	uint32_t num, size, len;
+	uint32_t type = ETH_PAT_TYPE_CNT;
+	uint32_t i;
+	uint32_t err_cnt;
+	uint32_t start, time;
+	uint32_t loopback;
+	
+	// 引数チェック
+	if (argc < 3) {
+		console_printf("eth_soak tx <num> <size> [cnt|prbs]\n");
+		console_printf("eth_soak rx <time_ms>\n");
+		console_printf("eth_soak lb <num> <size> [cnt|prbs]\n");
+		return;
+	}
+	
+	// 受信
+	if (strcmp(argv[1], "rx") == 0) {
+		time = atoi(argv[2]);
+		eth_pat_check_init(&eth_test_chk);
+		start = osKernelSysTick();
+		while ((osKernelSysTick() - start) < time) {
+			eth_test_soak_recv(IF_BENCH_RX_TMOUT);
+		}
+		eth_test_soak_print(time);
+		return;
+	}
+	
+	// 送信
+	loopback = (strcmp(argv[1], "lb") == 0) ? 1 : 0;
+	if (((loopback == 0) && (strcmp(argv[1], "tx") != 0)) || (argc < 4)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	num = atoi(argv[2]);
+	size = atoi(argv[3]);
+	if ((argc >= 5) && (strcmp(argv[4], "prbs") == 0)) {
+		type = ETH_PAT_TYPE_PRBS;
+	}
+	if ((num == 0) || ((size != 0) && ((size < ETH_PAT_SIZE_MIN) || (size > ETH_PAT_SIZE_MAX)))) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	// ループバックは自分宛て
+	p_dst = eth_test_bcast;
+	if (loopback) {
+		eth_get_mac_addr(own);
+		p_dst = own;
+		eth_test_soak_recv(0);
+		eth_pat_check_init(&eth_test_chk);
+	}
+	
+	err_cnt = 0;
+	start = osKernelSysTick();
+	for (i = 0; i < num; i++) {
+		len = (size != 0) ? size : (ETH_PAT_SIZE_MIN + (i % (ETH_PAT_SIZE_MAX - ETH_PAT_SIZE_MIN + 1)));
+		eth_pat_build(eth_test_frame, len, p_dst, type, eth_test_seq++);
+		if (eth_send(eth_test_frame, len) != osOK) {
+			err_cnt++;
+		}
+		// 折り返しフレームは溜めずに検査する
+		if (loopback) {
+			eth_test_soak_recv(0);
+		}
+	}
+	time = osKernelSysTick() - start;
+	
+	console_printf("tx:%u err:%u time:%u ms\n", num - err_cnt, err_cnt, time);
+	if (loopback) {
+		eth_test_soak_recv(IF_BENCH_RX_TMOUT);
+		eth_test_soak_print(time);
+	}
+}
+
+// セグメンテーションオフロードテスト
+// sizeバイトのペイロードを、セグメントごとにフレームを作ってeth_send()する場合とeth_send_tso()で1回に送る場合で
+// 時間とCPUサイクル数を比較する
+static void eth_test_tso_cmd(int argc, char *argv[])
+{
+	const uint8_t *p_tmpl;
+	uint8_t hdr[sizeof(tso_test_udp_hdr)];
+	ETH_TSO_PAR par;
+	CPU_LOAD_MEAS meas;
+	uint32_t hdr_size;
+	uint32_t size, seg, seg_num, len;
+	uint32_t i;
+	uint32_t total;
+	uint32_t cyc_per_us;
+	uint64_t busy;
+	osStatus ercd;
+	
+	// 引数チェック
+	if (argc < 2) {
+		console_printf("eth_tso <size> [raw|udp]\n");
+		return;
+	}
+	
+	// 値設定
+	size = atoi(argv[1]);
+	if ((size == 0) || (size > TSO_TEST_SIZE_MAX)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	memset(&par, 0, sizeof(par));
+	if ((argc >= 3) && (strcmp(argv[2], "udp") == 0)) {
+		par.type = ETH_TSO_UDP;
+		p_tmpl = tso_test_udp_hdr;
+		hdr_size = sizeof(tso_test_udp_hdr);
+	} else {
+		par.type = ETH_TSO_RAW;
+		par.seq_offset = 14;
+		p_tmpl = tso_test_raw_hdr;
+		hdr_size = sizeof(tso_test_raw_hdr);
+	}
+	memcpy(hdr, p_tmpl, hdr_size);
+	eth_get_mac_addr(&hdr[6]);
+	for (i = 0; i < size; i++) {
+		tso_test_data[i] = (uint8_t)i;
+	}
+	
+	cyc_per_us = SystemCoreClock / 1000000;
+	cpu_load_calibrate();
+	
+	// セグメントごとにフレームを作って送信 (ヘッダは書き換えない)
+	seg = ETH_PAT_SIZE_MAX - hdr_size;
+	seg_num = 0;
+	cpu_load_start(&meas);
+	total = DWT->CYCCNT;
+	for (i = 0; i < size; i += seg) {
+		len = ((size - i) > seg) ? seg : (size - i);
+		memcpy(&eth_test_frame[0], hdr, hdr_size);
+		memcpy(&eth_test_frame[hdr_size], &tso_test_data[i], len);
+		eth_send(eth_test_frame, hdr_size + len);
+		seg_num++;
+	}
+	total = DWT->CYCCNT - total;
+	cpu_load_stop(&meas, &busy);
+	console_printf("eth_send x%u: %u us cpu cycles/seg:%u\n", seg_num, total / cyc_per_us, (uint32_t)(busy / seg_num));
+	
+	// TSO
+	cpu_load_start(&meas);
+	total = DWT->CYCCNT;
+	ercd = eth_send_tso(hdr, hdr_size, tso_test_data, size, &par);
+	total = DWT->CYCCNT - total;
+	cpu_load_stop(&meas, &busy);
+	console_printf("eth_send_tso: %u us cpu cycles/seg:%u ercd = %d\n", total / cyc_per_us, (uint32_t)(busy / seg_num), ercd);
+}
+
 // コマンド設定関数
 void eth_test_set_cmd(void)
 {
@@ -76,5 +1122,45 @@ void eth_test_set_cmd(void)
 	cmd.input = "eth_cmd";
 	cmd.func = eth_test_cmd;
 	console_set_command(&cmd);
+	
+	cmd.input = "eth_tt";
+	cmd.func = eth_test_tt_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_filt";
+	cmd.func = eth_test_filter_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_fc";
+	cmd.func = eth_test_fc_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_vlan";
+	cmd.func = eth_test_vlan_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_dma_bench";
+	cmd.func = eth_test_dma_bench_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_if_bench";
+	cmd.func = eth_test_if_bench_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "pktgen";
+	cmd.func = eth_test_pktgen_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_lat";
+	cmd.func = eth_test_lat_bench_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_soak";
+	cmd.func = eth_test_soak_cmd;
+	console_set_command(&cmd);
+	
+	cmd.input = "eth_tso";
+	cmd.func = eth_test_tso_cmd;
+	console_set_command(&cmd);
 }
 
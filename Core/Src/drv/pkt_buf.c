@@ -0,0 +1,227 @@
+/*
+ * pkt_buf.c
+ *
+ *  Created on: 2026/1/10
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "pkt_buf.h"
+
+// 状態
+#define ST_INIT		(0)		// 初期状態
+#define ST_READY	(1)		// 使用可能
+
+// 制御ブロック
+typedef struct {
+	uint32_t			status;			// 状態
+	PKT_BUF * volatile	p_free;			// 空きリストの先頭
+	volatile uint32_t	free_num;		// 空きバッファ数
+	volatile uint32_t	free_min;		// 空きバッファ数の最小値
+	volatile uint32_t	alloc_cnt;		// 確保回数
+	volatile uint32_t	fail_cnt;		// 確保失敗回数
+} PKT_BUF_CB;
+static PKT_BUF_CB pkt_buf_cb;
+#define get_myself() (&pkt_buf_cb)
+
+// バッファ管理情報とバッファ本体
+// (*) バッファはDMAで直接読み書きするのでキャッシュラインにアラインして専用セクションに配置する
+static PKT_BUF pkt_tbl[PKT_BUF_NUM];
+static uint8_t pkt_mem[PKT_BUF_NUM][PKT_BUF_SIZE] __ALIGNED(32) __attribute__((section(".PktBufSection")));
+
+// 排他アクセスによる加算 (戻り値は加算後の値)
+static uint32_t pkt_atomic_add(volatile uint32_t *p_val, int32_t add)
+{
+	uint32_t val;
+	
+	do {
+		val = __LDREXW(p_val) + add;
+	} while (__STREXW(val, p_val) != 0);
+	
+	return val;
+}
+
+// 空きリストに戻す
+// (*) LDREX～STREXの間に割り込みが入るとSTREXが失敗するのでやり直す (ABAは起きない)
+static void pkt_push_free(PKT_BUF *p_pkt)
+{
+	PKT_BUF_CB *this = get_myself();
+	
+	do {
+		p_pkt->p_next = (PKT_BUF*)__LDREXW((volatile uint32_t*)&(this->p_free));
+	} while (__STREXW((uint32_t)p_pkt, (volatile uint32_t*)&(this->p_free)) != 0);
+	
+	pkt_atomic_add(&(this->free_num), 1);
+}
+
+// 初期化
+osStatus pkt_buf_init(void)
+{
+	PKT_BUF_CB *this = get_myself();
+	PKT_BUF *p_pkt;
+	uint32_t i;
+	
+	// コンテキストクリア
+	memset(this, 0, sizeof(PKT_BUF_CB));
+	
+	// 全バッファを空きリストに登録
+	for (i = 0; i < PKT_BUF_NUM; i++) {
+		p_pkt = &pkt_tbl[i];
+		p_pkt->p_buf = &(pkt_mem[i][0]);
+		p_pkt->p_data = p_pkt->p_buf + PKT_HEADROOM;
+		p_pkt->len = 0;
+		p_pkt->ref = 0;
+		pkt_push_free(p_pkt);
+	}
+	this->free_min = this->free_num;
+	
+	// 状態更新
+	this->status = ST_READY;
+	
+	return osOK;
+}
+
+// 確保 (割り込みコンテキストからも呼び出し可)
+// 戻り値 : バッファ (空きがない場合はNULL)
+PKT_BUF* pkt_alloc(void)
+{
+	PKT_BUF_CB *this = get_myself();
+	PKT_BUF *p_pkt;
+	PKT_BUF *p_next;
+	uint32_t free_num;
+	
+	// 初期化していない
+	if (this->status != ST_READY) {
+		return NULL;
+	}
+	
+	// 空きリストの先頭を取り出す
+	do {
+		p_pkt = (PKT_BUF*)__LDREXW((volatile uint32_t*)&(this->p_free));
+		if (p_pkt == NULL) {
+			__CLREX();
+			pkt_atomic_add(&(this->fail_cnt), 1);
+			return NULL;
+		}
+		p_next = p_pkt->p_next;
+	} while (__STREXW((uint32_t)p_next, (volatile uint32_t*)&(this->p_free)) != 0);
+	
+	// 統計
+	free_num = pkt_atomic_add(&(this->free_num), -1);
+	if (free_num < this->free_min) {
+		this->free_min = free_num;
+	}
+	pkt_atomic_add(&(this->alloc_cnt), 1);
+	
+	// 初期化 (データはヘッドルームの後ろから)
+	p_pkt->p_next = NULL;
+	p_pkt->p_data = p_pkt->p_buf + PKT_HEADROOM;
+	p_pkt->len = 0;
+	p_pkt->ref = 1;
+	p_pkt->flags = 0;
+	
+	return p_pkt;
+}
+
+// 解放 (参照数が0になったら空きリストに戻す、割り込みコンテキストからも呼び出し可)
+void pkt_free(PKT_BUF *p_pkt)
+{
+	if (p_pkt == NULL) {
+		return;
+	}
+	
+	if (pkt_atomic_add(&(p_pkt->ref), -1) == 0) {
+		pkt_push_free(p_pkt);
+	}
+}
+
+// 参照追加
+void pkt_ref(PKT_BUF *p_pkt)
+{
+	pkt_atomic_add(&(p_pkt->ref), 1);
+}
+
+// バッファ内のアドレスからパケットバッファを取得 (DMAドライバのコールバック用)
+// 戻り値 : パケットバッファ (プールのバッファでない場合はNULL)
+PKT_BUF* pkt_get_from_addr(void *p_addr)
+{
+	uint32_t offset;
+	
+	// プールの範囲外
+	if (((uint8_t*)p_addr < &(pkt_mem[0][0])) || ((uint8_t*)p_addr >= &(pkt_mem[PKT_BUF_NUM][0]))) {
+		return NULL;
+	}
+	
+	offset = (uint32_t)((uint8_t*)p_addr - &(pkt_mem[0][0]));
+	
+	return &pkt_tbl[offset / PKT_BUF_SIZE];
+}
+
+// 先頭にlenバイト追加 (ヘッドルームを使う)
+// 戻り値 : 追加後のデータ先頭 (ヘッドルームが足りない場合はNULL)
+uint8_t* pkt_push(PKT_BUF *p_pkt, uint32_t len)
+{
+	if (pkt_headroom(p_pkt) < len) {
+		return NULL;
+	}
+	
+	p_pkt->p_data -= len;
+	p_pkt->len += len;
+	
+	return p_pkt->p_data;
+}
+
+// 先頭からlenバイト取り除く
+// 戻り値 : 取り除いた後のデータ先頭 (データが足りない場合はNULL)
+uint8_t* pkt_pull(PKT_BUF *p_pkt, uint32_t len)
+{
+	if (p_pkt->len < len) {
+		return NULL;
+	}
+	
+	p_pkt->p_data += len;
+	p_pkt->len -= len;
+	
+	return p_pkt->p_data;
+}
+
+// 末尾にlenバイト追加 (テイルルームを使う)
+// 戻り値 : 追加した領域の先頭 (テイルルームが足りない場合はNULL)
+uint8_t* pkt_put(PKT_BUF *p_pkt, uint32_t len)
+{
+	uint8_t *p_tail;
+	
+	if (pkt_tailroom(p_pkt) < len) {
+		return NULL;
+	}
+	
+	p_tail = p_pkt->p_data + p_pkt->len;
+	p_pkt->len += len;
+	
+	return p_tail;
+}
+
+// ヘッドルームのサイズ
+uint32_t pkt_headroom(PKT_BUF *p_pkt)
+{
+	return (uint32_t)(p_pkt->p_data - p_pkt->p_buf);
+}
+
+// テイルルームのサイズ
+uint32_t pkt_tailroom(PKT_BUF *p_pkt)
+{
+	return PKT_BUF_SIZE - pkt_headroom(p_pkt) - p_pkt->len;
+}
+
+// 統計取得
+void pkt_get_stat(PKT_BUF_STAT *p_stat)
+{
+	PKT_BUF_CB *this = get_myself();
+	
+	p_stat->total_num = PKT_BUF_NUM;
+	p_stat->free_num = this->free_num;
+	p_stat->free_min = this->free_min;
+	p_stat->alloc_cnt = this->alloc_cnt;
+	p_stat->fail_cnt = this->fail_cnt;
+}
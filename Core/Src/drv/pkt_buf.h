@@ -0,0 +1,55 @@
+/*
+ * pkt_buf.h
+ *
+ *  Created on: 2026/1/10
+ *      Author: user
+ */
+
+#ifndef DRV_PKT_BUF_H_
+#define DRV_PKT_BUF_H_
+
+// バッファ構成
+// |<- PKT_HEADROOM ->|<----- PKT_DATA_SIZE ----->|<- PKT_TAILROOM ->|
+// p_buf              p_data (alloc直後)
+#define PKT_HEADROOM	(64)		// ヘッダ追加用の領域[byte]
+#define PKT_DATA_SIZE	(1536)		// データ領域[byte] (受信バッファサイズ)
+#define PKT_TAILROOM	(64)		// トレーラ追加用の領域[byte]
+#define PKT_BUF_SIZE	(PKT_HEADROOM + PKT_DATA_SIZE + PKT_TAILROOM)
+#define PKT_BUF_NUM		(32)		// バッファ数
+
+// パケットバッファ
+typedef struct pkt_buf {
+	struct pkt_buf		*p_next;	// 空きリスト、キューのリンク (使用者が自由に使ってよい)
+	uint8_t				*p_buf;		// バッファ先頭 (キャッシュラインアライン)
+	uint8_t				*p_data;	// データ先頭
+	uint32_t			len;		// データ長
+	volatile uint32_t	ref;		// 参照数
+	uint32_t			flags;		// フラグ (PKT_FLAG_xxx)
+} PKT_BUF;
+
+// フラグ
+#define PKT_FLAG_CSUM_OK	(1 << 0)	// 受信時にMACでIP、ペイロードのチェックサムを検証済み
+#define PKT_FLAG_CSUM_ERR	(1 << 1)	// 受信時にMACでチェックサムエラーを検出
+
+// 統計
+typedef struct {
+	uint32_t	total_num;		// バッファ数
+	uint32_t	free_num;		// 空きバッファ数
+	uint32_t	free_min;		// 空きバッファ数の最小値
+	uint32_t	alloc_cnt;		// 確保回数
+	uint32_t	fail_cnt;		// 確保失敗回数
+} PKT_BUF_STAT;
+
+extern osStatus pkt_buf_init(void);
+extern PKT_BUF* pkt_alloc(void);
+extern void pkt_free(PKT_BUF *p_pkt);
+extern void pkt_ref(PKT_BUF *p_pkt);
+extern PKT_BUF* pkt_get_from_addr(void *p_addr);
+extern uint8_t* pkt_push(PKT_BUF *p_pkt, uint32_t len);
+extern uint8_t* pkt_pull(PKT_BUF *p_pkt, uint32_t len);
+extern uint8_t* pkt_put(PKT_BUF *p_pkt, uint32_t len);
+extern uint32_t pkt_headroom(PKT_BUF *p_pkt);
+extern uint32_t pkt_tailroom(PKT_BUF *p_pkt);
+extern void pkt_get_stat(PKT_BUF_STAT *p_stat);
+
+#endif /* DRV_PKT_BUF_H_ */
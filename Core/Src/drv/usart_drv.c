@@ -6,6 +6,8 @@
  */
 #include <string.h>
 #include "cmsis_os.h"
+#include "os_sig.h"
+#include "hrt.h"
 #include "usart_drv.h"
 #include "usart.h"
 
@@ -15,7 +17,7 @@
 #define ST_OPEN		(2)		// オープン状態
 
 // マクロ
-#define SLEEP_TIME	(10)	// スリープ時間[ms]
+#define SLEEP_TIME	(10)	// スリープ時間[ms] (タイムアウトは実際の経過時間で判定する)
 
 // イベント
 #define UART_DRV_SEND_DONE	(0x00000001)
@@ -24,8 +26,8 @@
 // 制御ブロック
 typedef struct {
 	uint32_t		status;
-	osThreadId		snd_thread_id;
-	osThreadId		rcv_thread_id;
+	OS_SIG_WAITER	*p_snd_waiter;
+	OS_SIG_WAITER	*p_rcv_waiter;
 } USART_DRV_CB;
 static USART_DRV_CB usart_drv_cb[USART_DRV_DEV_MAX];
 #define get_myself(dev)	(&usart_drv_cb[dev])
@@ -45,10 +47,8 @@ void usart_recv_callback(USART_CH ch, void* p_ctx)
 {
 	USART_DRV_CB *this = (USART_DRV_CB*)p_ctx;
 	
-	if (this->rcv_thread_id != NULL) {
-		// イベント送信
-		osSignalSet(this->rcv_thread_id, UART_DRV_RECV_DONE);
-	}
+	// イベント送信
+	os_sig_set(this->p_rcv_waiter, UART_DRV_RECV_DONE);
 }
 
 // 送信コールバック
@@ -56,10 +56,8 @@ void usart_send_callback(USART_CH ch, void* p_ctx)
 {
 	USART_DRV_CB *this = (USART_DRV_CB*)p_ctx;
 	
-	if (this->snd_thread_id != NULL) {
-		// イベント送信
-		osSignalSet(this->snd_thread_id, UART_DRV_SEND_DONE);
-	}
+	// イベント送信
+	os_sig_set(this->p_snd_waiter, UART_DRV_SEND_DONE);
 }
 
 // エラーコールバック
@@ -128,8 +126,11 @@ int32_t usart_drv_send(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 {
 	USART_DRV_CB *this;
 	const USART_DEV_INFO *p_info;
+	OS_SIG_WAITER waiter;
 	uint32_t ercd;
 	uint32_t cnt = 0;
+	uint32_t start_us;
+	int32_t remain;
 	
 	// パラメータチェック
 	if (dev >= USART_DRV_DEV_MAX) {
@@ -147,12 +148,16 @@ int32_t usart_drv_send(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 		return -1;
 	}
 	
-	// タスク情報を取得
-	this->snd_thread_id = osThreadGetId();
+	// 待ち準備
+	os_sig_prepare(&waiter);
+	this->p_snd_waiter = &waiter;
 	
 	// USART情報取得
 	p_info = &usart_info_tbl[dev];
 	
+	// 開始時刻 (tmoutは約71分まで)
+	start_us = hrt_get_us();
+	
 	while(1) {
 		// 送信
 		if ((ercd = usart_send(p_info->ch, p_data, size)) < 0) {
@@ -175,14 +180,14 @@ int32_t usart_drv_send(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 				
 			// 全部送信できていないから待つ場合
 			} else if (tmout > 0) {
-				// いったんウェイト
-				osSignalWait(UART_DRV_SEND_DONE, SLEEP_TIME);
-				tmout -= SLEEP_TIME;
-				// タイムアウト発生
-				if (tmout < 0) {
+				// タイムアウト発生 (通知で早く起きた分も含めて経過時間で判定)
+				remain = tmout - (int32_t)(hrt_elapsed_us(start_us) / 1000);
+				if (remain <= 0) {
 					ercd = cnt;
 					break;
 				}
+				// いったんウェイト
+				os_sig_wait(&waiter, UART_DRV_SEND_DONE, (remain < SLEEP_TIME) ? remain : SLEEP_TIME);
 				
 			} else {
 				// 何もしない
@@ -192,7 +197,7 @@ int32_t usart_drv_send(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 	}
 	
 EXIT:
-	this->snd_thread_id = NULL;
+	this->p_snd_waiter = NULL;
 	
 	return ercd;
 }
@@ -202,8 +207,11 @@ int32_t usart_drv_recv(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 {
 	USART_DRV_CB *this;
 	const USART_DEV_INFO *p_info;
+	OS_SIG_WAITER waiter;
 	uint32_t ercd;
 	uint32_t cnt = 0;
+	uint32_t start_us;
+	int32_t remain;
 	
 	// パラメータチェック
 	if (dev >= USART_DRV_DEV_MAX) {
@@ -221,12 +229,16 @@ int32_t usart_drv_recv(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 		return -1;
 	}
 	
-	// タスク情報を取得
-	this->rcv_thread_id = osThreadGetId();
+	// 待ち準備
+	os_sig_prepare(&waiter);
+	this->p_rcv_waiter = &waiter;
 	
 	// USART情報取得
 	p_info = &usart_info_tbl[dev];
 	
+	// 開始時刻 (tmoutは約71分まで)
+	start_us = hrt_get_us();
+	
 	while(1) {
 		// 送信
 		if ((ercd = usart_recv(p_info->ch, p_data, size)) < 0) {
@@ -249,14 +261,14 @@ int32_t usart_drv_recv(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 				
 			// 全部送信できていないから待つ場合
 			} else if (tmout > 0) {
-				// いったんウェイト
-				osSignalWait(UART_DRV_RECV_DONE, SLEEP_TIME);
-				tmout -= SLEEP_TIME;
-				// タイムアウト発生
-				if (tmout < 0) {
+				// タイムアウト発生 (通知で早く起きた分も含めて経過時間で判定)
+				remain = tmout - (int32_t)(hrt_elapsed_us(start_us) / 1000);
+				if (remain <= 0) {
 					ercd = cnt;
 					break;
 				}
+				// いったんウェイト
+				os_sig_wait(&waiter, UART_DRV_RECV_DONE, (remain < SLEEP_TIME) ? remain : SLEEP_TIME);
 				
 			} else {
 				// 何もしない
@@ -266,7 +278,7 @@ int32_t usart_drv_recv(USART_DRV_DEV dev, uint8_t *p_data, uint32_t size, int32_
 	}
 	
 EXIT:
-	this->rcv_thread_id = NULL;
+	this->p_rcv_waiter = NULL;
 	
 	return ercd;
 	
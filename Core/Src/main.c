@@ -23,20 +23,45 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "pkt_buf.h"
 #include "eth.h"
 #include "eth_test.h"
+#include "net.h"
+#include "net_test.h"
+#include "iperf.h"
 #include "usart_drv.h"
 #include "console.h"
+#include "os_sig.h"
+#include "mem_plan.h"
+#include "os_stat.h"
+#include "trace.h"
+#include "prof.h"
+#include "hrt.h"
+#include "boot.h"
+#include "mem_alloc.h"
+#include "dma_cpy.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-typedef osStatus (*INIT_FUNC)(void);
 typedef void (*CMD_FUNC)(void);
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+// 初期化するモジュール (boot_modのインデックス)
+enum {
+	INIT_HRT = 0,
+	INIT_ETH,
+	INIT_DMA_CPY,
+	INIT_PKT_BUF,
+	INIT_USART_DRV,
+	INIT_NET,
+	INIT_CONSOLE,
+	INIT_CMD,
+	INIT_PHY,
+	INIT_NUM,
+};
 
 /* USER CODE END PD */
 
@@ -70,17 +95,39 @@ ETH_HandleTypeDef heth;
 UART_HandleTypeDef huart1;
 
 osThreadId defaultTaskHandle;
+uint32_t defaultTaskBuffer[ 256 ] MEM_PLAN_NOINIT(os);
+osStaticThreadDef_t defaultTaskControlBlock MEM_PLAN(os);
 /* USER CODE BEGIN PV */
-static const INIT_FUNC init_func[] = {
-	// peri
-	eth_init,
-	// drv
-	usart_drv_init,
-	// app
-	console_init,
-};
+static osStatus cmd_init(void);
 static const CMD_FUNC cmd_func[] = {
 	eth_test_set_cmd,
+	net_test_set_cmd,
+	iperf_set_cmd,
+	os_sig_set_cmd,
+	mem_plan_set_cmd,
+	os_stat_set_cmd,
+	trace_set_cmd,
+	prof_set_cmd,
+	hrt_set_cmd,
+	boot_set_cmd,
+	mem_alloc_set_cmd,
+	dma_cpy_set_cmd,
+};
+// 初期化するモジュール (依存関係の順に実行、earlyでないものはスケジューラ開始後に並行して実行)
+static const BOOT_MOD boot_mod[INIT_NUM] = {
+	// peri
+	{"hrt",			hrt_init,		0,											1},
+	{"eth",			eth_init,		BOOT_DEP(INIT_HRT),							1},
+	{"dma_cpy",		dma_cpy_init,	0,											1},
+	// drv
+	{"pkt_buf",		pkt_buf_init,	0,											1},
+	{"usart_drv",	usart_drv_init,	0,											1},
+	// net
+	{"net",			net_init,		BOOT_DEP(INIT_ETH) | BOOT_DEP(INIT_PKT_BUF),	1},
+	// app (PHYのオートネゴシエーションと並行して立ち上げる)
+	{"console",		console_init,	BOOT_DEP(INIT_USART_DRV),					0},
+	{"cmd",			cmd_init,		BOOT_DEP(INIT_CONSOLE),						0},
+	{"phy",			eth_phy_init,	BOOT_DEP(INIT_ETH) | BOOT_DEP(INIT_HRT),	0},
 };
 /* USER CODE END PV */
 
@@ -106,6 +153,18 @@ static void tmp_mx_eth_init(void)
 	
 	HAL_ETH_MspInit(&tmp_heth);
 }
+
+// コマンド登録
+static osStatus cmd_init(void)
+{
+	uint32_t i;
+	
+	for (i = 0; i < sizeof(cmd_func)/sizeof(cmd_func[0]); i++) {
+		cmd_func[i]();
+	}
+	
+	return osOK;
+}
 /* USER CODE END 0 */
 
 /**
@@ -116,7 +175,6 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-	uint8_t i, size;
   /* USER CODE END 1 */
 
   /* MPU Configuration--------------------------------------------------------*/
@@ -144,15 +202,10 @@ int main(void)
   //MX_ETH_Init();
   /* USER CODE BEGIN 2 */
 	tmp_mx_eth_init();
-	// 初期化
-	size = sizeof(init_func)/sizeof(init_func[0]);
-	for (i = 0; i < size; i++) {
-		init_func[i]();
-	}
-	// コマンド
-	size = sizeof(cmd_func)/sizeof(cmd_func[0]);
-	for (i = 0; i < size; i++) {
-		cmd_func[i]();
+	// 初期化 (スケジューラ開始前に必要なもの)
+	// 失敗した場合はコンソールも使えないので、スケジューラを開始せずに止まる
+	if (boot_run_early(boot_mod, INIT_NUM) != osOK) {
+		Error_Handler();
 	}
   /* USER CODE END 2 */
 
@@ -174,11 +227,13 @@ int main(void)
 
   /* Create the thread(s) */
   /* definition and creation of defaultTask */
-  osThreadDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 256);
+  osThreadStaticDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 256, defaultTaskBuffer, &defaultTaskControlBlock);
   defaultTaskHandle = osThreadCreate(osThread(defaultTask), NULL);
 
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
+	// 残りの初期化はスケジューラ開始後に並行して実行する
+	boot_start_late();
   /* USER CODE END RTOS_THREADS */
 
   /* Start scheduler */
@@ -368,6 +423,16 @@ static void MX_GPIO_Init(void)
 void StartDefaultTask(void const * argument)
 {
   /* USER CODE BEGIN 5 */
+	// 初期化完了待ち (これ以降のヒープ確保はmem_plan_report()で報告する)
+	boot_wait(osWaitForever);
+	mem_plan_lock();
+	
+	// 起動時間、RAM使用量を表示 (コンソールの初期化に失敗した場合は表示できない)
+	if (boot_is_done(INIT_CONSOLE)) {
+		boot_report();
+		mem_plan_report();
+	}
+	
   /* Infinite loop */
   for(;;)
   {
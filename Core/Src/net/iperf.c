@@ -0,0 +1,548 @@
+/*
+ * iperf.c
+ *
+ *  Created on: 2026/2/7
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "cpu_load.h"
+#include "mem_plan.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "net.h"
+#include "hrt.h"
+#ifdef NET_USE_LWIP
+#include "lwip/api.h"
+#endif
+
+#include "iperf.h"
+
+// iperf2互換のスループット測定
+// UDP : net.cのUDPソケットを使う (サーバ、クライアント)
+// TCP : lwIPのnetconnを使う (NET_USE_LWIP定義時のみ)
+// 終了時にスループット、ジッタ、ロス、CPU負荷を表示する
+
+// マクロ
+#define IPERF_PORT_DEFAULT		(5001)
+#define IPERF_TIME_DEFAULT		(10)		// 測定時間[s] (サーバは接続待ち時間)
+#define IPERF_UDP_LEN_DEFAULT	(1470)		// UDPのデータグラムサイズ
+#define IPERF_UDP_RATE_DEFAULT	(1)			// UDPの送信レート[Mbps] (iperf2のデフォルトと同じ)
+#define IPERF_UDP_HDR_SIZE		(12)		// id + tv_sec + tv_usec
+#define IPERF_CLIENT_HDR_SIZE	(24)		// クライアントヘッダ (0で送るとオプションなし)
+#define IPERF_UDP_LEN_MIN		(IPERF_UDP_HDR_SIZE + IPERF_CLIENT_HDR_SIZE)
+#define IPERF_REPORT_SIZE		(IPERF_UDP_HDR_SIZE + 40)	// サーバレポート (int32 x 10)
+#define IPERF_HEADER_VERSION1	(0x80000000)
+#define IPERF_FIN_RETRY			(10)		// 終了データグラムの再送回数
+#define IPERF_FIN_TMOUT			(250)		// サーバレポート待ち[ms]
+#define IPERF_RECV_TMOUT		(1000)		// 受信待ち[ms]
+#define IPERF_SERVER_IDLE		(5000)		// 測定開始後、受信が途切れたら終了する時間[ms]
+#define IPERF_SLEEP_MIN_US		(2000)		// 送信間隔がこれより長い場合はosDelayで待つ[us] (短い場合はhrt_delay_usで待つ)
+#define IPERF_TCP_LEN			(1460 * 4)	// TCPの1回の書き込みサイズ
+#define USEC_PER_SEC			(1000000)
+
+// パラメータ
+typedef struct {
+	uint32_t	client;		// 1:クライアント 0:サーバ
+	uint32_t	udp;		// 1:UDP 0:TCP
+	uint32_t	ip_addr;	// 接続先 (クライアント)
+	uint16_t	port;		// ポート番号
+	uint32_t	time;		// 測定時間[s]
+	uint32_t	len;		// データグラムサイズ
+	uint32_t	rate;		// UDPの送信レート[Mbps] (0は制限なし)
+} IPERF_PAR;
+
+// 結果
+typedef struct {
+	uint64_t	bytes;		// 転送バイト数
+	uint64_t	us;			// 測定時間[us]
+	uint32_t	datagrams;	// データグラム数
+	uint32_t	lost;		// ロス数
+	uint32_t	outorder;	// 順序入れ替わり数
+	uint32_t	jitter_us;	// ジッタ[us]
+	uint32_t	cpu_load;	// CPU負荷[0.1%]
+} IPERF_RESULT;
+
+// 制御ブロック
+typedef struct {
+	uint32_t	cyc_last;	// 前回のサイクルカウンタ
+	uint64_t	cyc_total;	// 64bitに拡張したサイクルカウンタ
+} IPERF_CB;
+static IPERF_CB iperf_cb MEM_PLAN(net);
+#define get_myself() (&iperf_cb)
+
+#ifdef NET_USE_LWIP
+// TCP送信データ (NETCONN_NOCOPYで送るので送信完了までこのバッファを参照する)
+static uint8_t iperf_tcp_buf[IPERF_TCP_LEN] MEM_PLAN(net);
+#endif
+
+// ビッグエンディアンの読み書き
+static uint32_t iperf_get32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void iperf_put32(uint8_t *p, uint32_t val)
+{
+	p[0] = (uint8_t)(val >> 24);
+	p[1] = (uint8_t)(val >> 16);
+	p[2] = (uint8_t)(val >> 8);
+	p[3] = (uint8_t)(val & 0xFF);
+}
+
+// 現在時刻[us]
+// (*) DWTのサイクルカウンタを64bitに拡張するので、一周(216MHzで約19秒)する前に呼び出すこと
+static uint64_t iperf_now_us(void)
+{
+	IPERF_CB *this = get_myself();
+	uint32_t cyc = DWT->CYCCNT;
+	
+	this->cyc_total += (uint32_t)(cyc - this->cyc_last);
+	this->cyc_last = cyc;
+	
+	return this->cyc_total / (SystemCoreClock / USEC_PER_SEC);
+}
+
+// 結果表示
+static void iperf_print(IPERF_RESULT *p_res)
+{
+	uint32_t ms = (uint32_t)(p_res->us / 1000);
+	uint32_t kbyte = (uint32_t)(p_res->bytes / 1024);
+	uint32_t kbps = 0;
+	uint32_t loss = 0;
+	
+	if (p_res->us != 0) {
+		kbps = (uint32_t)((p_res->bytes * 8 * 1000) / p_res->us);
+	}
+	console_printf("0.0-%u.%u sec %u KBytes %u.%u Mbits/sec\n", ms / 1000, (ms % 1000) / 100, kbyte, kbps / 1000, (kbps % 1000) / 100);
+	if (p_res->datagrams != 0) {
+		loss = (p_res->lost * 1000) / (p_res->datagrams + p_res->lost);
+		console_printf("jitter %u us lost %u/%u (%u.%u%%) out-of-order %u\n", p_res->jitter_us,
+			p_res->lost, p_res->datagrams + p_res->lost, loss / 10, loss % 10, p_res->outorder);
+	}
+	console_printf("cpu load %u.%u%%\n", p_res->cpu_load / 10, p_res->cpu_load % 10);
+}
+
+// UDPデータグラム送信
+// id : シーケンス番号 (負の値は終了)
+static osStatus iperf_udp_send(int32_t sock, IPERF_PAR *p_par, int32_t id, uint64_t now_us)
+{
+	PKT_BUF *p_pkt;
+	uint8_t *p;
+	
+	if ((p_pkt = net_udp_alloc()) == NULL) {
+		return osErrorNoMemory;
+	}
+	
+	// ペイロードは送信バッファに直接作る (クライアントヘッダは0でオプションなし)
+	p = pkt_put(p_pkt, p_par->len);
+	memset(p, 0, p_par->len);
+	iperf_put32(&p[0], (uint32_t)id);
+	iperf_put32(&p[4], (uint32_t)(now_us / USEC_PER_SEC));
+	iperf_put32(&p[8], (uint32_t)(now_us % USEC_PER_SEC));
+	
+	return net_udp_send(sock, p_pkt, p_par->ip_addr, p_par->port);
+}
+
+// サーバレポート送信 (受信した終了データグラムのバッファをそのまま使う)
+static void iperf_udp_report(int32_t sock, PKT_BUF *p_pkt, IPERF_RESULT *p_res, int32_t last_id, uint32_t ip_addr, uint16_t port)
+{
+	uint8_t *p;
+	
+	// id、送信時刻はそのまま返す
+	p_pkt->len = IPERF_UDP_HDR_SIZE;
+	p = pkt_put(p_pkt, IPERF_REPORT_SIZE - IPERF_UDP_HDR_SIZE);
+	iperf_put32(&p[0], IPERF_HEADER_VERSION1);
+	iperf_put32(&p[4], (uint32_t)(p_res->bytes >> 32));
+	iperf_put32(&p[8], (uint32_t)p_res->bytes);
+	iperf_put32(&p[12], (uint32_t)(p_res->us / USEC_PER_SEC));
+	iperf_put32(&p[16], (uint32_t)(p_res->us % USEC_PER_SEC));
+	iperf_put32(&p[20], p_res->lost);
+	iperf_put32(&p[24], p_res->outorder);
+	iperf_put32(&p[28], (uint32_t)(last_id + 1));
+	iperf_put32(&p[32], p_res->jitter_us / USEC_PER_SEC);
+	iperf_put32(&p[36], p_res->jitter_us % USEC_PER_SEC);
+	
+	net_udp_send(sock, p_pkt, ip_addr, port);
+}
+
+// UDPサーバ
+static void iperf_udp_server(IPERF_PAR *p_par)
+{
+	IPERF_RESULT res;
+	CPU_LOAD_MEAS meas;
+	PKT_BUF *p_pkt;
+	uint8_t *p;
+	uint32_t ip_addr;
+	uint16_t port;
+	int32_t sock;
+	int32_t id;
+	int32_t last_id = -1;
+	uint32_t started = 0;
+	uint32_t finished = 0;
+	uint32_t idle_tick;
+	uint32_t limit;
+	uint64_t now;
+	uint64_t start_us = 0;
+	int64_t transit;
+	int64_t last_transit = 0;
+	int64_t d;
+	int64_t jitter16 = 0;	// ジッタ[us] x16
+	
+	memset(&res, 0, sizeof(res));
+	
+	if ((sock = net_udp_open(p_par->port)) < 0) {
+		console_printf("net_udp_open error\n");
+		return;
+	}
+	console_printf("Server listening on UDP port %u\n", p_par->port);
+	
+	idle_tick = osKernelSysTick();
+	while (1) {
+		p_pkt = net_udp_recv(sock, IPERF_RECV_TMOUT, &ip_addr, &port);
+		now = iperf_now_us();
+		
+		// 受信なし (開始前は測定時間、開始後はIPERF_SERVER_IDLE、終了後はすぐ抜ける)
+		if (p_pkt == NULL) {
+			limit = (started == 0) ? (p_par->time * 1000) : IPERF_SERVER_IDLE;
+			if ((finished != 0) || ((osKernelSysTick() - idle_tick) >= limit)) {
+				break;
+			}
+			continue;
+		}
+		idle_tick = osKernelSysTick();
+		
+		if (p_pkt->len < IPERF_UDP_HDR_SIZE) {
+			pkt_free(p_pkt);
+			continue;
+		}
+		p = p_pkt->p_data;
+		id = (int32_t)iperf_get32(&p[0]);
+		
+		// 測定開始
+		if (started == 0) {
+			started = 1;
+			start_us = now;
+			cpu_load_start(&meas);
+			console_printf("connected with %u.%u.%u.%u port %u\n", (ip_addr >> 24) & 0xFF, (ip_addr >> 16) & 0xFF, (ip_addr >> 8) & 0xFF, ip_addr & 0xFF, port);
+		}
+		
+		// 終了 (クライアントはレポートを受け取るまで再送してくるので毎回返す)
+		if (id < 0) {
+			if (finished == 0) {
+				finished = 1;
+				res.us = now - start_us;
+				res.cpu_load = cpu_load_stop(&meas, NULL);
+				res.jitter_us = (uint32_t)(jitter16 / 16);
+			}
+			iperf_udp_report(sock, p_pkt, &res, last_id, ip_addr, port);
+			continue;
+		}
+		
+		// ロス、順序入れ替わり (iperf2と同じ判定)
+		res.bytes += p_pkt->len;
+		res.datagrams++;
+		if (id <= last_id) {
+			res.outorder++;
+		} else {
+			res.lost += (uint32_t)(id - last_id - 1);
+			last_id = id;
+		}
+		
+		// ジッタ (RFC1889、送信側と時計がずれていても差分なので問題ない)
+		transit = (int64_t)now - ((int64_t)iperf_get32(&p[4]) * USEC_PER_SEC + iperf_get32(&p[8]));
+		if (res.datagrams > 1) {
+			d = transit - last_transit;
+			if (d < 0) {
+				d = -d;
+			}
+			jitter16 += d - (jitter16 / 16);
+		}
+		last_transit = transit;
+		
+		pkt_free(p_pkt);
+	}
+	
+	net_udp_close(sock);
+	
+	if (started == 0) {
+		console_printf("timeout\n");
+		return;
+	}
+	// 終了データグラムが来なかった
+	if (finished == 0) {
+		res.us = now - start_us;
+		res.cpu_load = cpu_load_stop(&meas, NULL);
+		res.jitter_us = (uint32_t)(jitter16 / 16);
+	}
+	iperf_print(&res);
+}
+
+// UDPクライアント
+static void iperf_udp_client(IPERF_PAR *p_par)
+{
+	IPERF_RESULT res;
+	CPU_LOAD_MEAS meas;
+	PKT_BUF *p_pkt;
+	uint8_t *p;
+	int32_t sock;
+	int32_t id = 0;
+	uint32_t err_cnt = 0;
+	uint32_t interval_us = 0;
+	uint32_t i;
+	uint64_t now;
+	uint64_t start_us;
+	uint64_t end_us;
+	uint64_t next_us;
+	
+	memset(&res, 0, sizeof(res));
+	
+	if ((sock = net_udp_open(0)) < 0) {
+		console_printf("net_udp_open error\n");
+		return;
+	}
+	
+	// 送信間隔
+	if (p_par->rate != 0) {
+		interval_us = (p_par->len * 8) / p_par->rate;
+	}
+	console_printf("Client connecting to port %u, %u byte datagrams, interval %u us\n", p_par->port, p_par->len, interval_us);
+	
+	cpu_load_start(&meas);
+	start_us = iperf_now_us();
+	end_us = start_us + (uint64_t)p_par->time * USEC_PER_SEC;
+	next_us = start_us;
+	while ((now = iperf_now_us()) < end_us) {
+		// 送信時刻まで待つ
+		if (now < next_us) {
+			if ((next_us - now) >= IPERF_SLEEP_MIN_US) {
+				osDelay((uint32_t)((next_us - now) / 1000));
+			} else {
+				hrt_delay_us((uint32_t)(next_us - now));
+			}
+			continue;
+		}
+		next_us += interval_us;
+		
+		if (iperf_udp_send(sock, p_par, id, now) == osOK) {
+			res.bytes += p_par->len;
+			res.datagrams++;
+		} else {
+			err_cnt++;
+		}
+		id++;
+	}
+	res.us = now - start_us;
+	res.cpu_load = cpu_load_stop(&meas, NULL);
+	
+	// 送信側の結果
+	console_printf("sent (err %u)\n", err_cnt);
+	iperf_print(&res);
+	
+	// 終了を送ってサーバレポートを待つ (1つも送信していない場合も負の値になるように+1する)
+	for (i = 0; i < IPERF_FIN_RETRY; i++) {
+		iperf_udp_send(sock, p_par, -(id + 1), iperf_now_us());
+		if ((p_pkt = net_udp_recv(sock, IPERF_FIN_TMOUT, NULL, NULL)) == NULL) {
+			continue;
+		}
+		if (p_pkt->len >= IPERF_REPORT_SIZE) {
+			p = p_pkt->p_data + IPERF_UDP_HDR_SIZE;
+			memset(&res, 0, sizeof(res));
+			res.bytes = ((uint64_t)iperf_get32(&p[4]) << 32) | iperf_get32(&p[8]);
+			res.us = (uint64_t)iperf_get32(&p[12]) * USEC_PER_SEC + iperf_get32(&p[16]);
+			res.lost = iperf_get32(&p[20]);
+			res.outorder = iperf_get32(&p[24]);
+			res.datagrams = iperf_get32(&p[28]) - res.lost;
+			res.jitter_us = iperf_get32(&p[32]) * USEC_PER_SEC + iperf_get32(&p[36]);
+			console_printf("server report\n");
+			iperf_print(&res);
+			pkt_free(p_pkt);
+			break;
+		}
+		pkt_free(p_pkt);
+	}
+	if (i >= IPERF_FIN_RETRY) {
+		console_printf("did not receive ack of last datagram\n");
+	}
+	
+	net_udp_close(sock);
+}
+
+#ifdef NET_USE_LWIP
+// TCPサーバ
+static void iperf_tcp_server(IPERF_PAR *p_par)
+{
+	IPERF_RESULT res;
+	CPU_LOAD_MEAS meas;
+	struct netconn *p_listen;
+	struct netconn *p_conn;
+	struct netbuf *p_buf;
+	uint64_t start_us;
+	
+	memset(&res, 0, sizeof(res));
+	
+	if ((p_listen = netconn_new(NETCONN_TCP)) == NULL) {
+		console_printf("netconn_new error\n");
+		return;
+	}
+	if ((netconn_bind(p_listen, IP_ADDR_ANY, p_par->port) != ERR_OK) || (netconn_listen(p_listen) != ERR_OK)) {
+		console_printf("netconn_listen error\n");
+		goto EXIT;
+	}
+	console_printf("Server listening on TCP port %u\n", p_par->port);
+	
+	// 接続待ち (測定時間で打ち切る)
+	netconn_set_recvtimeout(p_listen, p_par->time * 1000);
+	if (netconn_accept(p_listen, &p_conn) != ERR_OK) {
+		console_printf("timeout\n");
+		goto EXIT;
+	}
+	netconn_set_recvtimeout(p_conn, IPERF_SERVER_IDLE);
+	
+	// 切断されるまで受信
+	cpu_load_start(&meas);
+	start_us = iperf_now_us();
+	while (netconn_recv(p_conn, &p_buf) == ERR_OK) {
+		res.bytes += netbuf_len(p_buf);
+		netbuf_delete(p_buf);
+		iperf_now_us();
+	}
+	res.us = iperf_now_us() - start_us;
+	res.cpu_load = cpu_load_stop(&meas, NULL);
+	
+	netconn_close(p_conn);
+	netconn_delete(p_conn);
+	iperf_print(&res);
+	
+EXIT:
+	netconn_delete(p_listen);
+}
+
+// TCPクライアント
+static void iperf_tcp_client(IPERF_PAR *p_par)
+{
+	IPERF_RESULT res;
+	CPU_LOAD_MEAS meas;
+	struct netconn *p_conn;
+	ip_addr_t ip_addr;
+	uint64_t now;
+	uint64_t start_us;
+	uint64_t end_us;
+	
+	memset(&res, 0, sizeof(res));
+	
+	if ((p_conn = netconn_new(NETCONN_TCP)) == NULL) {
+		console_printf("netconn_new error\n");
+		return;
+	}
+	ip4_addr_set_u32(ip_2_ip4(&ip_addr), lwip_htonl(p_par->ip_addr));
+	if (netconn_connect(p_conn, &ip_addr, p_par->port) != ERR_OK) {
+		console_printf("connect failed\n");
+		netconn_delete(p_conn);
+		return;
+	}
+	console_printf("Client connecting to TCP port %u\n", p_par->port);
+	
+	// 測定時間の間送信し続ける
+	cpu_load_start(&meas);
+	start_us = iperf_now_us();
+	end_us = start_us + (uint64_t)p_par->time * USEC_PER_SEC;
+	while ((now = iperf_now_us()) < end_us) {
+		if (netconn_write(p_conn, iperf_tcp_buf, IPERF_TCP_LEN, NETCONN_NOCOPY) != ERR_OK) {
+			break;
+		}
+		res.bytes += IPERF_TCP_LEN;
+	}
+	res.us = now - start_us;
+	res.cpu_load = cpu_load_stop(&meas, NULL);
+	
+	netconn_close(p_conn);
+	netconn_delete(p_conn);
+	iperf_print(&res);
+}
+#endif
+
+// コマンド
+// iperf -s [-u] [-p port] [-t sec]
+// iperf -c <ip> [-u] [-p port] [-t sec] [-l len] [-b Mbps]
+static void iperf_cmd(int argc, char *argv[])
+{
+	IPERF_PAR par;
+	int32_t mode = -1;
+	int32_t i;
+	
+	// デフォルト値
+	memset(&par, 0, sizeof(par));
+	par.port = IPERF_PORT_DEFAULT;
+	par.time = IPERF_TIME_DEFAULT;
+	par.len = IPERF_UDP_LEN_DEFAULT;
+	par.rate = IPERF_UDP_RATE_DEFAULT;
+	
+	// 引数解析
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-s") == 0) {
+			mode = 0;
+		} else if ((strcmp(argv[i], "-c") == 0) && ((i + 1) < argc)) {
+			mode = 1;
+			par.ip_addr = net_aton(argv[++i]);
+		} else if (strcmp(argv[i], "-u") == 0) {
+			par.udp = 1;
+		} else if ((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc)) {
+			par.port = atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-t") == 0) && ((i + 1) < argc)) {
+			par.time = atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-l") == 0) && ((i + 1) < argc)) {
+			par.len = atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-b") == 0) && ((i + 1) < argc)) {
+			par.rate = atoi(argv[++i]);
+		} else {
+			mode = -1;
+			break;
+		}
+	}
+	
+	// 引数チェック
+	if ((mode < 0) || ((mode == 1) && (par.ip_addr == 0)) || (par.time == 0) ||
+	    (par.len < IPERF_UDP_LEN_MIN) || (par.len > NET_UDP_PAYLOAD_MAX)) {
+		console_printf("iperf -s [-u] [-p port] [-t sec]\n");
+		console_printf("iperf -c <ip> [-u] [-p port] [-t sec] [-l len] [-b Mbps]\n");
+		return;
+	}
+	par.client = (uint32_t)mode;
+	
+	// CPU負荷計測の校正、時刻の基準
+	cpu_load_calibrate();
+	iperf_now_us();
+	
+	if (par.udp != 0) {
+		if (par.client != 0) {
+			iperf_udp_client(&par);
+		} else {
+			iperf_udp_server(&par);
+		}
+	} else {
+#ifdef NET_USE_LWIP
+		if (par.client != 0) {
+			iperf_tcp_client(&par);
+		} else {
+			iperf_tcp_server(&par);
+		}
+#else
+		console_printf("TCP requires lwIP (NET_USE_LWIP)\n");
+#endif
+	}
+}
+
+// コマンド設定関数
+void iperf_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "iperf";
+	cmd.func = iperf_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,13 @@
+/*
+ * iperf.h
+ *
+ *  Created on: 2026/2/7
+ *      Author: user
+ */
+
+#ifndef SRC_NET_IPERF_H_
+#define SRC_NET_IPERF_H_
+
+extern void iperf_set_cmd(void);
+
+#endif /* SRC_NET_IPERF_H_ */
@@ -0,0 +1,928 @@
+/*
+ * net.c
+ *
+ *  Created on: 2026/1/24
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "mem_plan.h"
+#include "pkt_buf.h"
+#include "eth.h"
+
+#include "net.h"
+
+// テレメトリ送信とping応答だけを行う最小限のIPv4スタック
+// ・受信したパケットバッファをそのまま応答に使い、UDPのペイロードもバッファごと貸し出す (コピーしない)
+// ・動的メモリは使わない (バッファはすべてパケットバッファプールから借りる)
+// ・チェックサムは受信、送信ともMACのチェックサムオフロードを使う
+// ・フラグメント、IPオプション付きの送信、TCPは未対応
+
+// 状態定義
+#define ST_INIT		(0)		// 初期状態
+#define ST_CLOSE	(1)		// クローズ状態
+#define ST_OPEN		(2)		// オープン状態
+
+// マクロ
+#define ETH_TYPE_IPV4		(0x0800)
+#define ETH_TYPE_ARP		(0x0806)
+#define IP_VERSION_IHL		(0x45)		// IPv4、ヘッダ長20byte
+#define IP_PROTO_ICMP		(1)
+#define IP_PROTO_UDP		(17)
+#define IP_TTL				(64)
+#define IP_FLAG_DF			(0x4000)	// Don't Fragment
+#define IP_FRAG_MASK		(0x3FFF)	// MF + フラグメントオフセット
+#define IP_BROADCAST		(0xFFFFFFFF)
+#define ICMP_ECHO_REPLY		(0)
+#define ICMP_ECHO_REQUEST	(8)
+#define ICMP_HDR_SIZE		(8)
+#define ARP_HDR_SIZE		(28)
+#define ARP_HW_ETHER		(1)
+#define ARP_OP_REQUEST		(1)
+#define ARP_OP_REPLY		(2)
+#define ARP_TIMEOUT			(300000)	// ARPキャッシュの有効期間[ms]
+#define ARP_RESOLVE_TMOUT	(1000)		// アドレス解決の待ち時間[ms]
+#define ARP_RETRY_INTERVAL	(250)		// ARP要求の再送間隔[ms]
+#define ARP_POLL_INTERVAL	(5)			// ARP応答の確認間隔[ms]
+#define UDP_QUE_NUM			(8)			// ソケットごとの受信キュー段数 (2のべき乗)
+#define UDP_QUE_MASK		(UDP_QUE_NUM - 1)
+#define UDP_PORT_EPHEMERAL	(49152)		// 自動割り当てポートの先頭
+
+// イベントグループのビット (ソケットごとに1ビット)
+#define EVT_UDP_RECV(sock)	(1UL << (sock))
+
+// ARPキャッシュ
+typedef struct {
+	uint32_t	ip_addr;		// IPアドレス (0は未使用)
+	uint8_t		mac_addr[6];	// MACアドレス
+	uint32_t	time;			// 登録時刻[ms]
+} ARP_ENTRY;
+
+// UDPソケット
+typedef struct {
+	uint16_t			port;				// ポート番号 (0は未使用)
+	PKT_BUF				*que[UDP_QUE_NUM];	// 受信キュー
+	volatile uint32_t	w_idx;				// 書き込み位置 (受信スレッドのみ更新)
+	volatile uint32_t	r_idx;				// 読み出し位置 (受信タスクのみ更新)
+} UDP_CB;
+
+// 制御ブロック
+typedef struct {
+	uint32_t	status;					// 状態
+	NET_PAR		par;					// オープンパラメータ
+	uint8_t		mac_addr[6];			// 自MACアドレス
+	uint16_t	ip_id;					// IPヘッダのID
+	uint16_t	ephemeral;				// 次に割り当てるポート番号
+	osThreadId	rx_thread_id;			// 受信スレッド
+	osMutexId	tx_mutex;				// 送信の排他
+	osMutexId	tbl_mutex;				// ARPキャッシュ、UDPソケット表の排他
+	EventGroupHandle_t	udp_evt;		// UDP受信通知 (受信スレッド→受信タスク)
+	ARP_ENTRY	arp[NET_ARP_NUM];		// ARPキャッシュ
+	UDP_CB		udp[NET_UDP_NUM];		// UDPソケット
+	NET_STAT	stat;					// 統計
+} NET_CB;
+static NET_CB net_cb MEM_PLAN(net);
+#define get_myself() (&net_cb)
+
+// ブロードキャストMACアドレス
+static const uint8_t mac_broadcast[6] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+// ビッグエンディアンの読み書き (ヘッダはアラインされていないのでバイト単位でアクセスする)
+static uint16_t net_get16(const uint8_t *p)
+{
+	return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+static uint32_t net_get32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void net_put16(uint8_t *p, uint16_t val)
+{
+	p[0] = (uint8_t)(val >> 8);
+	p[1] = (uint8_t)(val & 0xFF);
+}
+
+static void net_put32(uint8_t *p, uint32_t val)
+{
+	p[0] = (uint8_t)(val >> 24);
+	p[1] = (uint8_t)(val >> 16);
+	p[2] = (uint8_t)(val >> 8);
+	p[3] = (uint8_t)(val & 0xFF);
+}
+
+// 1の補数和の加算 (16bit単位、奇数長の最後は上位バイト扱い)
+static uint32_t net_csum_add(uint32_t sum, const uint8_t *p, uint32_t len)
+{
+	while (len > 1) {
+		sum += ((uint32_t)p[0] << 8) | p[1];
+		p += 2;
+		len -= 2;
+	}
+	if (len != 0) {
+		sum += (uint32_t)p[0] << 8;
+	}
+	
+	return sum;
+}
+
+// 1の補数和を16bitに畳み込んで反転
+static uint16_t net_csum_fold(uint32_t sum)
+{
+	while ((sum >> 16) != 0) {
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	}
+	
+	return (uint16_t)~sum;
+}
+
+// UDPチェックサム計算 (疑似ヘッダ込み)
+static uint16_t net_udp_csum(const uint8_t *p_ip, const uint8_t *p_udp, uint32_t udp_len)
+{
+	uint32_t sum;
+	
+	sum = net_csum_add(0, &p_ip[12], 8);	// 送信元、宛先IPアドレス
+	sum += IP_PROTO_UDP + udp_len;
+	sum = net_csum_add(sum, p_udp, udp_len);
+	
+	return net_csum_fold(sum);
+}
+
+// 自分宛てか (ユニキャスト、ブロードキャスト、サブネットブロードキャスト)
+static uint32_t net_ip_is_mine(uint32_t ip_addr)
+{
+	NET_CB *this = get_myself();
+	
+	if ((ip_addr == this->par.ip_addr) || (ip_addr == IP_BROADCAST) ||
+	    (ip_addr == (this->par.ip_addr | ~this->par.netmask))) {
+		return 1;
+	}
+	return 0;
+}
+
+// Ethernetヘッダ作成
+static void net_eth_hdr(uint8_t *p_eth, const uint8_t *p_dst, uint16_t type)
+{
+	NET_CB *this = get_myself();
+	
+	memcpy(&p_eth[0], p_dst, 6);
+	memcpy(&p_eth[6], this->mac_addr, 6);
+	net_put16(&p_eth[12], type);
+}
+
+// 送信チェックサム設定
+// MACで挿入する場合はチェックサムフィールドを0にしておく
+static void net_ip_csum(uint8_t *p_ip, uint32_t hdr_len)
+{
+	uint8_t *p_l4 = p_ip + hdr_len;
+	uint8_t *p_csum;
+	uint32_t l4_len = net_get16(&p_ip[2]) - hdr_len;
+	uint16_t csum;
+	
+	p_csum = (p_ip[9] == IP_PROTO_UDP) ? &p_l4[6] : &p_l4[2];
+	net_put16(&p_ip[10], 0);
+	net_put16(p_csum, 0);
+	
+	// MACで挿入する
+	if (eth_tx_csum_offload() != 0) {
+		return;
+	}
+	
+	// ソフトウェアで計算
+	net_put16(&p_ip[10], net_csum_fold(net_csum_add(0, p_ip, hdr_len)));
+	if (p_ip[9] == IP_PROTO_UDP) {
+		csum = net_udp_csum(p_ip, p_l4, l4_len);
+		// 0はチェックサムなしの意味になるので反転して送る
+		if (csum == 0) {
+			csum = 0xFFFF;
+		}
+	} else {
+		csum = net_csum_fold(net_csum_add(0, p_l4, l4_len));
+	}
+	net_put16(p_csum, csum);
+}
+
+// フレーム送信 (送信後にバッファを解放する)
+// (*) eth_send()は呼び出しタスクで完了を待つので複数タスクからの送信を排他する
+static osStatus net_output(PKT_BUF *p_pkt)
+{
+	NET_CB *this = get_myself();
+	osStatus ercd;
+	
+	osMutexWait(this->tx_mutex, osWaitForever);
+	ercd = eth_send_pkt(p_pkt);
+	osMutexRelease(this->tx_mutex);
+	
+	if (ercd == osOK) {
+		this->stat.tx_cnt++;
+	}
+	pkt_free(p_pkt);
+	
+	return ercd;
+}
+
+// ARPキャッシュ検索
+// 戻り値 : 1 見つかった
+static uint32_t net_arp_lookup(uint32_t ip_addr, uint8_t *p_mac)
+{
+	NET_CB *this = get_myself();
+	ARP_ENTRY *p_entry;
+	uint32_t now = osKernelSysTick();
+	uint32_t found = 0;
+	uint32_t i;
+	
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	for (i = 0; i < NET_ARP_NUM; i++) {
+		p_entry = &(this->arp[i]);
+		if ((p_entry->ip_addr == ip_addr) && ((now - p_entry->time) < ARP_TIMEOUT)) {
+			memcpy(p_mac, p_entry->mac_addr, 6);
+			found = 1;
+			break;
+		}
+	}
+	osMutexRelease(this->tbl_mutex);
+	
+	return found;
+}
+
+// ARPキャッシュ更新
+// create : 1 エントリがなければ作成する (空きがない場合は一番古いエントリを置き換える)
+static void net_arp_update(uint32_t ip_addr, const uint8_t *p_mac, uint32_t create)
+{
+	NET_CB *this = get_myself();
+	ARP_ENTRY *p_entry = NULL;
+	ARP_ENTRY *p_oldest = NULL;
+	uint32_t now = osKernelSysTick();
+	uint32_t i;
+	
+	if (ip_addr == 0) {
+		return;
+	}
+	
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	for (i = 0; i < NET_ARP_NUM; i++) {
+		// 登録済み
+		if (this->arp[i].ip_addr == ip_addr) {
+			p_entry = &(this->arp[i]);
+			break;
+		}
+		// 置き換え候補 (空きを優先、なければ一番古いエントリ)
+		if ((p_oldest == NULL) || (p_oldest->ip_addr == 0)) {
+			if (p_oldest == NULL) {
+				p_oldest = &(this->arp[i]);
+			}
+		} else if ((this->arp[i].ip_addr == 0) || ((now - this->arp[i].time) > (now - p_oldest->time))) {
+			p_oldest = &(this->arp[i]);
+		}
+	}
+	if ((p_entry == NULL) && (create != 0)) {
+		p_entry = p_oldest;
+	}
+	if (p_entry != NULL) {
+		p_entry->ip_addr = ip_addr;
+		memcpy(p_entry->mac_addr, p_mac, 6);
+		p_entry->time = now;
+	}
+	osMutexRelease(this->tbl_mutex);
+}
+
+// ARP要求送信
+static osStatus net_arp_request(uint32_t ip_addr)
+{
+	NET_CB *this = get_myself();
+	PKT_BUF *p_pkt;
+	uint8_t *p_arp;
+	
+	if ((p_pkt = pkt_alloc()) == NULL) {
+		return osErrorNoMemory;
+	}
+	
+	p_arp = pkt_put(p_pkt, ARP_HDR_SIZE);
+	net_put16(&p_arp[0], ARP_HW_ETHER);
+	net_put16(&p_arp[2], ETH_TYPE_IPV4);
+	p_arp[4] = 6;
+	p_arp[5] = 4;
+	net_put16(&p_arp[6], ARP_OP_REQUEST);
+	memcpy(&p_arp[8], this->mac_addr, 6);
+	net_put32(&p_arp[14], this->par.ip_addr);
+	memset(&p_arp[18], 0, 6);
+	net_put32(&p_arp[24], ip_addr);
+	net_eth_hdr(pkt_push(p_pkt, NET_ETH_HDR_SIZE), mac_broadcast, ETH_TYPE_ARP);
+	
+	this->stat.arp_req_cnt++;
+	
+	return net_output(p_pkt);
+}
+
+// アドレス解決 (キャッシュにない場合はARP要求を送って応答を待つ)
+// (*) 受信スレッドから呼び出してはいけない (応答を受信できなくなる)
+static osStatus net_arp_resolve(uint32_t ip_addr, uint8_t *p_mac)
+{
+	NET_CB *this = get_myself();
+	uint32_t start;
+	uint32_t last;
+	uint32_t now;
+	
+	// ブロードキャスト
+	if ((ip_addr == IP_BROADCAST) || (ip_addr == (this->par.ip_addr | ~this->par.netmask))) {
+		memcpy(p_mac, mac_broadcast, 6);
+		return osOK;
+	}
+	
+	// サブネット外はゲートウェイに送る
+	if (((ip_addr ^ this->par.ip_addr) & this->par.netmask) != 0) {
+		if (this->par.gateway == 0) {
+			return osErrorParameter;
+		}
+		ip_addr = this->par.gateway;
+	}
+	
+	start = osKernelSysTick();
+	last = start - ARP_RETRY_INTERVAL;
+	while (1) {
+		// キャッシュにある
+		if (net_arp_lookup(ip_addr, p_mac) != 0) {
+			return osOK;
+		}
+		now = osKernelSysTick();
+		if ((now - start) >= ARP_RESOLVE_TMOUT) {
+			break;
+		}
+		// ARP要求 (再送)
+		if ((now - last) >= ARP_RETRY_INTERVAL) {
+			net_arp_request(ip_addr);
+			last = now;
+		}
+		osDelay(ARP_POLL_INTERVAL);
+	}
+	
+	this->stat.arp_fail_cnt++;
+	
+	return osErrorTimeoutResource;
+}
+
+// ARP受信
+static void net_arp_input(PKT_BUF *p_pkt, uint8_t *p_eth)
+{
+	NET_CB *this = get_myself();
+	uint8_t *p_arp = p_eth + NET_ETH_HDR_SIZE;
+	uint32_t sender_ip;
+	uint32_t target_ip;
+	
+	// Ethernet/IPv4以外は破棄
+	if ((p_pkt->len < (NET_ETH_HDR_SIZE + ARP_HDR_SIZE)) ||
+	    (net_get16(&p_arp[0]) != ARP_HW_ETHER) || (net_get16(&p_arp[2]) != ETH_TYPE_IPV4) ||
+	    (p_arp[4] != 6) || (p_arp[5] != 4)) {
+		this->stat.drop_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	sender_ip = net_get32(&p_arp[14]);
+	target_ip = net_get32(&p_arp[24]);
+	
+	// 送信元を登録 (自分宛ての場合のみ新規作成する)
+	net_arp_update(sender_ip, &p_arp[8], (target_ip == this->par.ip_addr));
+	
+	// 自分宛ての要求は受信バッファをそのまま応答にする
+	if ((net_get16(&p_arp[6]) == ARP_OP_REQUEST) && (target_ip == this->par.ip_addr)) {
+		net_put16(&p_arp[6], ARP_OP_REPLY);
+		memcpy(&p_arp[18], &p_arp[8], 10);		// 要求元を宛先に
+		memcpy(&p_arp[8], this->mac_addr, 6);
+		net_put32(&p_arp[14], this->par.ip_addr);
+		net_eth_hdr(p_eth, &p_arp[18], ETH_TYPE_ARP);
+		p_pkt->len = NET_ETH_HDR_SIZE + ARP_HDR_SIZE;
+		this->stat.arp_reply_cnt++;
+		net_output(p_pkt);
+		return;
+	}
+	
+	pkt_free(p_pkt);
+}
+
+// ICMP受信 (エコー要求のみ応答する)
+static void net_icmp_input(PKT_BUF *p_pkt, uint8_t *p_eth, uint32_t hdr_len)
+{
+	NET_CB *this = get_myself();
+	uint8_t *p_ip = p_eth + NET_ETH_HDR_SIZE;
+	uint8_t *p_icmp = p_ip + hdr_len;
+	uint32_t icmp_len = net_get16(&p_ip[2]) - hdr_len;
+	
+	// エコー要求以外、ブロードキャスト宛ては応答しない
+	if ((icmp_len < ICMP_HDR_SIZE) || (p_icmp[0] != ICMP_ECHO_REQUEST) || (net_get32(&p_ip[16]) != this->par.ip_addr)) {
+		this->stat.drop_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	// チェックサム確認 (MACで検証済みなら省略)
+	if (((p_pkt->flags & PKT_FLAG_CSUM_OK) == 0) && (net_csum_fold(net_csum_add(0, p_icmp, icmp_len)) != 0)) {
+		this->stat.csum_err_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	// 要求をそのまま応答にする (ペイロードはコピーしない)
+	p_icmp[0] = ICMP_ECHO_REPLY;
+	memcpy(&p_ip[16], &p_ip[12], 4);
+	net_put32(&p_ip[12], this->par.ip_addr);
+	p_ip[8] = IP_TTL;
+	net_ip_csum(p_ip, hdr_len);
+	net_eth_hdr(p_eth, &p_eth[6], ETH_TYPE_IPV4);
+	
+	this->stat.icmp_echo_cnt++;
+	net_output(p_pkt);
+}
+
+// UDP受信 (ソケットの受信キューにバッファごと渡す)
+static void net_udp_input(PKT_BUF *p_pkt, uint8_t *p_eth, uint32_t hdr_len)
+{
+	NET_CB *this = get_myself();
+	uint8_t *p_ip = p_eth + NET_ETH_HDR_SIZE;
+	uint8_t *p_udp = p_ip + hdr_len;
+	uint32_t udp_len;
+	uint16_t port;
+	UDP_CB *p_udp_cb = NULL;
+	uint32_t i;
+	
+	// 長さチェック
+	udp_len = net_get16(&p_udp[4]);
+	if ((udp_len < NET_UDP_HDR_SIZE) || (udp_len > (net_get16(&p_ip[2]) - hdr_len))) {
+		this->stat.drop_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	// チェックサム確認 (MACで検証済み、チェックサムなしの場合は省略)
+	if (((p_pkt->flags & PKT_FLAG_CSUM_OK) == 0) && (net_get16(&p_udp[6]) != 0) &&
+	    (net_udp_csum(p_ip, p_udp, udp_len) != 0)) {
+		this->stat.csum_err_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	// ヘッダを外してペイロードを渡す (ヘッダはヘッドルーム側に残る)
+	pkt_pull(p_pkt, NET_ETH_HDR_SIZE + hdr_len + NET_UDP_HDR_SIZE);
+	p_pkt->len = udp_len - NET_UDP_HDR_SIZE;
+	
+	// ソケット検索してキューに登録 (クローズと競合しないように排他)
+	port = net_get16(&p_udp[2]);
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	for (i = 0; i < NET_UDP_NUM; i++) {
+		if (this->udp[i].port == port) {
+			p_udp_cb = &(this->udp[i]);
+			break;
+		}
+	}
+	if ((p_udp_cb != NULL) && ((p_udp_cb->w_idx - p_udp_cb->r_idx) < UDP_QUE_NUM)) {
+		p_udp_cb->que[p_udp_cb->w_idx & UDP_QUE_MASK] = p_pkt;
+		p_udp_cb->w_idx++;
+		p_pkt = NULL;
+	}
+	osMutexRelease(this->tbl_mutex);
+	
+	// ソケットがない、キューが一杯
+	if (p_pkt != NULL) {
+		this->stat.udp_drop_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	this->stat.udp_rx_cnt++;
+	
+	// 受信スレッド(タスクコンテキスト)から通知するのでイベントグループを使う
+	// 待っているタスクがいなくてもビットが残るので取りこぼさない
+	xEventGroupSetBits(this->udp_evt, EVT_UDP_RECV(i));
+}
+
+// IPv4受信
+static void net_ip_input(PKT_BUF *p_pkt, uint8_t *p_eth)
+{
+	NET_CB *this = get_myself();
+	uint8_t *p_ip = p_eth + NET_ETH_HDR_SIZE;
+	uint32_t hdr_len;
+	uint32_t total_len;
+	
+	// ヘッダチェック (フラグメントは未対応)
+	if (p_pkt->len < (NET_ETH_HDR_SIZE + NET_IP_HDR_SIZE)) {
+		goto DROP;
+	}
+	hdr_len = (uint32_t)(p_ip[0] & 0x0F) * 4;
+	total_len = net_get16(&p_ip[2]);
+	if (((p_ip[0] >> 4) != 4) || (hdr_len < NET_IP_HDR_SIZE) ||
+	    (total_len < hdr_len) || (total_len > (p_pkt->len - NET_ETH_HDR_SIZE)) ||
+	    ((net_get16(&p_ip[6]) & IP_FRAG_MASK) != 0) || (net_ip_is_mine(net_get32(&p_ip[16])) == 0)) {
+		goto DROP;
+	}
+	
+	// ヘッダチェックサム確認 (MACで検証済みなら省略)
+	if ((p_pkt->flags & PKT_FLAG_CSUM_OK) != 0) {
+		this->stat.csum_hw_cnt++;
+	} else if (net_csum_fold(net_csum_add(0, p_ip, hdr_len)) != 0) {
+		this->stat.csum_err_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	// 最小フレーム長のパディングを除く
+	p_pkt->len = NET_ETH_HDR_SIZE + total_len;
+	
+	switch (p_ip[9]) {
+		case IP_PROTO_ICMP:
+			net_icmp_input(p_pkt, p_eth, hdr_len);
+			return;
+		case IP_PROTO_UDP:
+			net_udp_input(p_pkt, p_eth, hdr_len);
+			return;
+		default:
+			break;
+	}
+	
+DROP:
+	this->stat.drop_cnt++;
+	pkt_free(p_pkt);
+}
+
+// 受信フレームの振り分け
+static void net_input(PKT_BUF *p_pkt)
+{
+	NET_CB *this = get_myself();
+	uint8_t *p_eth = p_pkt->p_data;
+	
+	this->stat.rx_cnt++;
+	
+	if (p_pkt->len < NET_ETH_HDR_SIZE) {
+		this->stat.drop_cnt++;
+		pkt_free(p_pkt);
+		return;
+	}
+	
+	switch (net_get16(&p_eth[12])) {
+		case ETH_TYPE_ARP:
+			net_arp_input(p_pkt, p_eth);
+			break;
+		case ETH_TYPE_IPV4:
+			net_ip_input(p_pkt, p_eth);
+			break;
+		default:
+			this->stat.drop_cnt++;
+			pkt_free(p_pkt);
+			break;
+	}
+}
+
+// 受信スレッド
+static void net_rx_thread(void const *argument)
+{
+	PKT_BUF *p_pkt;
+	
+	while (1) {
+		// ETHがオープンされていない場合は待つ
+		if ((p_pkt = eth_recv_pkt(-1)) == NULL) {
+			osDelay(10);
+			continue;
+		}
+		net_input(p_pkt);
+	}
+}
+
+// 初期化
+osStatus net_init(void)
+{
+	NET_CB *this = get_myself();
+	
+	// コンテキストクリア
+	memset(this, 0, sizeof(NET_CB));
+	
+	// 送信の排他
+	MEM_PLAN_MUTEX(net, net_tx);
+	if ((this->tx_mutex = osMutexCreate(osMutex(net_tx))) == NULL) {
+		return osErrorOS;
+	}
+	
+	// ARPキャッシュ、UDPソケット表の排他
+	MEM_PLAN_MUTEX(net, net_tbl);
+	if ((this->tbl_mutex = osMutexCreate(osMutex(net_tbl))) == NULL) {
+		return osErrorOS;
+	}
+	
+	// UDP受信通知
+	static StaticEventGroup_t udp_evt_cb MEM_PLAN(net);
+	if ((this->udp_evt = xEventGroupCreateStatic(&udp_evt_cb)) == NULL) {
+		return osErrorOS;
+	}
+	
+	// 状態更新
+	this->status = ST_CLOSE;
+	
+	return osOK;
+}
+
+// オープン
+// (*) 事前にeth_open()しておくこと (チェックサム挿入はストア&フォワード送信時のみ有効)
+osStatus net_open(NET_PAR *p_par)
+{
+	NET_CB *this = get_myself();
+	
+	// パラメータチェック
+	if ((p_par == NULL) || (p_par->ip_addr == 0)) {
+		return osErrorParameter;
+	}
+	
+	// クローズ状態でない
+	if (this->status != ST_CLOSE) {
+		return osErrorResource;
+	}
+	
+	// パラメータ設定
+	this->par = *p_par;
+	eth_get_mac_addr(this->mac_addr);
+	this->ephemeral = UDP_PORT_EPHEMERAL;
+	
+	// 受信スレッド作成
+	MEM_PLAN_THREAD(net, net_rx, net_rx_thread, osPriorityAboveNormal, 256);
+	if ((this->rx_thread_id = osThreadCreate(osThread(net_rx), NULL)) == NULL) {
+		return osErrorOS;
+	}
+	
+	// 状態更新
+	this->status = ST_OPEN;
+	
+	return osOK;
+}
+
+// UDPソケットオープン
+// port : 受信ポート番号 (0は自動割り当て)
+// 戻り値 : ソケット番号 (エラーの場合は-1)
+int32_t net_udp_open(uint16_t port)
+{
+	NET_CB *this = get_myself();
+	int32_t sock = -1;
+	uint32_t i;
+	
+	// オープンしていない
+	if (this->status != ST_OPEN) {
+		return -1;
+	}
+	
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	
+	// 自動割り当て (同時にオープンしたソケットが同じポートにならないように排他中に行う)
+	if (port == 0) {
+		port = this->ephemeral;
+		this->ephemeral = (this->ephemeral == 0xFFFF) ? UDP_PORT_EPHEMERAL : (this->ephemeral + 1);
+	}
+	
+	for (i = 0; i < NET_UDP_NUM; i++) {
+		// 使用中のポート
+		if (this->udp[i].port == port) {
+			sock = -1;
+			break;
+		}
+		if ((sock < 0) && (this->udp[i].port == 0)) {
+			sock = (int32_t)i;
+		}
+	}
+	if (sock >= 0) {
+		this->udp[sock].w_idx = 0;
+		this->udp[sock].r_idx = 0;
+		this->udp[sock].port = port;
+	}
+	osMutexRelease(this->tbl_mutex);
+	
+	// 前のソケットの通知が残っていればクリア
+	if (sock >= 0) {
+		xEventGroupClearBits(this->udp_evt, EVT_UDP_RECV(sock));
+	}
+	
+	return sock;
+}
+
+// UDPソケットクローズ (受信キューに残っているバッファは解放する)
+osStatus net_udp_close(int32_t sock)
+{
+	NET_CB *this = get_myself();
+	UDP_CB *p_udp_cb;
+	
+	// パラメータチェック
+	if ((sock < 0) || (sock >= NET_UDP_NUM)) {
+		return osErrorParameter;
+	}
+	p_udp_cb = &(this->udp[sock]);
+	
+	// オープンしていない
+	if (p_udp_cb->port == 0) {
+		return osErrorResource;
+	}
+	
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	p_udp_cb->port = 0;
+	osMutexRelease(this->tbl_mutex);
+	
+	while (p_udp_cb->w_idx != p_udp_cb->r_idx) {
+		pkt_free(p_udp_cb->que[p_udp_cb->r_idx & UDP_QUE_MASK]);
+		p_udp_cb->r_idx++;
+	}
+	
+	return osOK;
+}
+
+// UDP送信バッファ確保
+// ペイロードはpkt_put()で書き込む (ヘッダはnet_udp_send()でヘッドルームに作成する)
+PKT_BUF* net_udp_alloc(void)
+{
+	return pkt_alloc();
+}
+
+// UDP送信
+// バッファの所有権は移る (送信の成否にかかわらず解放する)
+osStatus net_udp_send(int32_t sock, PKT_BUF *p_pkt, uint32_t ip_addr, uint16_t port)
+{
+	NET_CB *this = get_myself();
+	uint8_t mac_addr[6];
+	uint8_t *p_udp;
+	uint8_t *p_ip;
+	uint32_t udp_len;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if (p_pkt == NULL) {
+		return osErrorParameter;
+	}
+	if ((sock < 0) || (sock >= NET_UDP_NUM) || (p_pkt->len > NET_UDP_PAYLOAD_MAX) || (port == 0)) {
+		ercd = osErrorParameter;
+		goto ERR;
+	}
+	
+	// オープンしていない
+	if ((this->status != ST_OPEN) || (this->udp[sock].port == 0)) {
+		ercd = osErrorResource;
+		goto ERR;
+	}
+	
+	// アドレス解決
+	if ((ercd = net_arp_resolve(ip_addr, mac_addr)) != osOK) {
+		goto ERR;
+	}
+	
+	// UDPヘッダ
+	udp_len = p_pkt->len + NET_UDP_HDR_SIZE;
+	if ((p_udp = pkt_push(p_pkt, NET_UDP_HDR_SIZE)) == NULL) {
+		ercd = osErrorParameter;
+		goto ERR;
+	}
+	net_put16(&p_udp[0], this->udp[sock].port);
+	net_put16(&p_udp[2], port);
+	net_put16(&p_udp[4], (uint16_t)udp_len);
+	
+	// IPヘッダ
+	if ((p_ip = pkt_push(p_pkt, NET_IP_HDR_SIZE)) == NULL) {
+		ercd = osErrorParameter;
+		goto ERR;
+	}
+	p_ip[0] = IP_VERSION_IHL;
+	p_ip[1] = 0;
+	net_put16(&p_ip[2], (uint16_t)(udp_len + NET_IP_HDR_SIZE));
+	net_put16(&p_ip[4], this->ip_id++);
+	net_put16(&p_ip[6], IP_FLAG_DF);
+	p_ip[8] = IP_TTL;
+	p_ip[9] = IP_PROTO_UDP;
+	net_put32(&p_ip[12], this->par.ip_addr);
+	net_put32(&p_ip[16], ip_addr);
+	net_ip_csum(p_ip, NET_IP_HDR_SIZE);
+	
+	// Ethernetヘッダ
+	net_eth_hdr(pkt_push(p_pkt, NET_ETH_HDR_SIZE), mac_addr, ETH_TYPE_IPV4);
+	
+	this->stat.udp_tx_cnt++;
+	
+	return net_output(p_pkt);
+	
+ERR:
+	pkt_free(p_pkt);
+	return ercd;
+}
+
+// UDP受信
+// tmout : タイムアウト[ms] (0は待たない、負の値は永久待ち)
+// p_ip_addr, p_port : 送信元 (NULL可)
+// 戻り値 : ペイロードを指すパケットバッファ (使用後はpkt_free()で解放すること、タイムアウト、エラーの場合はNULL)
+PKT_BUF* net_udp_recv(int32_t sock, int32_t tmout, uint32_t *p_ip_addr, uint16_t *p_port)
+{
+	NET_CB *this = get_myself();
+	UDP_CB *p_udp_cb;
+	PKT_BUF *p_pkt = NULL;
+	uint8_t *p_ip;
+	EventBits_t bits;
+	
+	// パラメータチェック
+	if ((sock < 0) || (sock >= NET_UDP_NUM)) {
+		return NULL;
+	}
+	p_udp_cb = &(this->udp[sock]);
+	
+	// オープンしていない
+	if ((this->status != ST_OPEN) || (p_udp_cb->port == 0)) {
+		return NULL;
+	}
+	
+	while (1) {
+		// 受信済みがあれば取り出す
+		if (p_udp_cb->w_idx != p_udp_cb->r_idx) {
+			p_pkt = p_udp_cb->que[p_udp_cb->r_idx & UDP_QUE_MASK];
+			p_udp_cb->r_idx++;
+			break;
+		}
+		// 待たない
+		if (tmout == 0) {
+			break;
+		}
+		// 受信待ち
+		// (キュー確認後に登録された場合もビットが残っているのですぐに戻る)
+		bits = xEventGroupWaitBits(this->udp_evt, EVT_UDP_RECV(sock), pdTRUE, pdFALSE,
+		                           (tmout < 0) ? portMAX_DELAY : pdMS_TO_TICKS((uint32_t)tmout));
+		if ((bits & EVT_UDP_RECV(sock)) == 0) {
+			break;
+		}
+	}
+	
+	// 送信元 (受信フレームはヘッドルームの直後から格納されている)
+	if (p_pkt != NULL) {
+		p_ip = p_pkt->p_buf + PKT_HEADROOM + NET_ETH_HDR_SIZE;
+		if (p_ip_addr != NULL) {
+			*p_ip_addr = net_get32(&p_ip[12]);
+		}
+		if (p_port != NULL) {
+			*p_port = net_get16(p_pkt->p_data - NET_UDP_HDR_SIZE);
+		}
+	}
+	
+	return p_pkt;
+}
+
+// ARPキャッシュ取得
+// 戻り値 : 取得したエントリ数
+uint32_t net_arp_get(NET_ARP_INFO *p_info, uint32_t num)
+{
+	NET_CB *this = get_myself();
+	uint32_t now = osKernelSysTick();
+	uint32_t cnt = 0;
+	uint32_t i;
+	
+	osMutexWait(this->tbl_mutex, osWaitForever);
+	for (i = 0; (i < NET_ARP_NUM) && (cnt < num); i++) {
+		if (this->arp[i].ip_addr != 0) {
+			p_info[cnt].ip_addr = this->arp[i].ip_addr;
+			memcpy(p_info[cnt].mac_addr, this->arp[i].mac_addr, 6);
+			p_info[cnt].age = now - this->arp[i].time;
+			cnt++;
+		}
+	}
+	osMutexRelease(this->tbl_mutex);
+	
+	return cnt;
+}
+
+// "a.b.c.d"形式の文字列をIPアドレスに変換
+// 戻り値 : IPアドレス (形式が不正な場合は0)
+uint32_t net_aton(const char *p_str)
+{
+	uint32_t ip_addr = 0;
+	uint32_t val;
+	uint32_t i;
+	
+	for (i = 0; i < 4; i++) {
+		if ((*p_str < '0') || (*p_str > '9')) {
+			return 0;
+		}
+		val = 0;
+		while ((*p_str >= '0') && (*p_str <= '9')) {
+			val = val * 10 + (*p_str - '0');
+			p_str++;
+		}
+		if (val > 255) {
+			return 0;
+		}
+		ip_addr = (ip_addr << 8) | val;
+		if (i < 3) {
+			if (*p_str != '.') {
+				return 0;
+			}
+			p_str++;
+		}
+	}
+	
+	return ip_addr;
+}
+
+// 統計取得
+void net_get_stat(NET_STAT *p_stat)
+{
+	NET_CB *this = get_myself();
+	
+	*p_stat = this->stat;
+}
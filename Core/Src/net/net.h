@@ -0,0 +1,70 @@
+/*
+ * net.h
+ *
+ *  Created on: 2026/1/24
+ *      Author: user
+ */
+
+#ifndef SRC_NET_NET_H_
+#define SRC_NET_NET_H_
+
+// lwIPを使う場合は定義する (Middlewares/Third_Party/LwIPが必要)
+// 定義した場合はnet_cmd 0でLWIP/App/lwip.cのlwip_app_open()を使い、本スタックの受信スレッドは起動しない
+// (*) lwIPのtcpipスレッドとmboxはヒープから確保するので、mem_alloc.cのMEM_ALLOC_HEAP_SIZE(必要ならプールのサイズクラス)と_mem_budget_osを増やすこと
+//#define NET_USE_LWIP
+
+// IPアドレス作成 (ホストバイトオーダー)
+#define NET_IP_ADDR(a, b, c, d)	(((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+// ヘッダサイズ
+#define NET_ETH_HDR_SIZE	(14)
+#define NET_IP_HDR_SIZE		(20)
+#define NET_UDP_HDR_SIZE	(8)
+#define NET_UDP_PAYLOAD_MAX	(1500 - NET_IP_HDR_SIZE - NET_UDP_HDR_SIZE)
+
+// 数
+#define NET_UDP_NUM			(4)		// UDPソケット数
+#define NET_ARP_NUM			(8)		// ARPキャッシュのエントリ数
+
+// オープンパラメータ
+typedef struct {
+	uint32_t	ip_addr;	// 自IPアドレス
+	uint32_t	netmask;	// サブネットマスク
+	uint32_t	gateway;	// デフォルトゲートウェイ (0はなし)
+} NET_PAR;
+
+// ARPキャッシュ情報
+typedef struct {
+	uint32_t	ip_addr;		// IPアドレス
+	uint8_t		mac_addr[6];	// MACアドレス
+	uint32_t	age;			// 登録からの経過時間[ms]
+} NET_ARP_INFO;
+
+// 統計
+typedef struct {
+	uint32_t	rx_cnt;			// 受信フレーム数
+	uint32_t	tx_cnt;			// 送信フレーム数
+	uint32_t	drop_cnt;		// 破棄したフレーム数 (未対応プロトコル、宛先違い)
+	uint32_t	csum_err_cnt;	// チェックサムエラー数
+	uint32_t	csum_hw_cnt;	// MACで検証済みだったフレーム数
+	uint32_t	arp_req_cnt;	// ARP要求送信数
+	uint32_t	arp_reply_cnt;	// ARP応答送信数
+	uint32_t	arp_fail_cnt;	// アドレス解決失敗数
+	uint32_t	icmp_echo_cnt;	// ping応答数
+	uint32_t	udp_rx_cnt;		// UDP受信数
+	uint32_t	udp_tx_cnt;		// UDP送信数
+	uint32_t	udp_drop_cnt;	// UDP破棄数 (ソケットなし、キュー満杯)
+} NET_STAT;
+
+extern osStatus net_init(void);
+extern osStatus net_open(NET_PAR *p_par);
+extern int32_t net_udp_open(uint16_t port);
+extern osStatus net_udp_close(int32_t sock);
+extern PKT_BUF* net_udp_alloc(void);
+extern osStatus net_udp_send(int32_t sock, PKT_BUF *p_pkt, uint32_t ip_addr, uint16_t port);
+extern PKT_BUF* net_udp_recv(int32_t sock, int32_t tmout, uint32_t *p_ip_addr, uint16_t *p_port);
+extern uint32_t net_arp_get(NET_ARP_INFO *p_info, uint32_t num);
+extern void net_get_stat(NET_STAT *p_stat);
+extern uint32_t net_aton(const char *p_str);
+
+#endif /* SRC_NET_NET_H_ */
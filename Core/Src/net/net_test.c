@@ -0,0 +1,230 @@
+/*
+ * net_test.c
+ *
+ *  Created on: 2026/1/24
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "pkt_buf.h"
+#include "eth.h"
+
+#include "net.h"
+#include "net_test.h"
+#ifdef NET_USE_LWIP
+#include "lwip.h"
+#endif
+
+#define UDP_TEST_TMOUT		(5000)	// UDPエコーテストの受信タイムアウト[ms]
+
+// ETHのオープンパラメータ (チェックサム挿入のため送信はストア&フォワード)
+static const ETH_OPEN net_test_eth_par = {
+	COM_MODE_FULL_DUPLEX,
+	{1, 1, 0, 0, 0, 0},
+};
+
+// IPアドレス表示
+static void net_test_print_ip(const char *p_name, uint32_t ip_addr)
+{
+	console_printf("%s%d.%d.%d.%d\n", p_name, (ip_addr >> 24) & 0xFF, (ip_addr >> 16) & 0xFF, (ip_addr >> 8) & 0xFF, ip_addr & 0xFF);
+}
+
+// MACアドレスを"xx:xx:xx:xx:xx:xx"形式の文字列に変換 (console_printfは桁指定できないため)
+static char* net_test_mac_str(const uint8_t *p_mac, char *p_str)
+{
+	static const char hex[] = "0123456789abcdef";
+	uint32_t i;
+	
+	for (i = 0; i < 6; i++) {
+		p_str[i * 3 + 0] = hex[p_mac[i] >> 4];
+		p_str[i * 3 + 1] = hex[p_mac[i] & 0x0F];
+		p_str[i * 3 + 2] = (i < 5) ? ':' : '\0';
+	}
+	
+	return p_str;
+}
+
+// オープン
+static void net_test_open(int argc, char *argv[])
+{
+	ETH_OPEN eth_par = net_test_eth_par;
+	NET_PAR par;
+	osStatus ercd;
+	
+	if (argc < 4) {
+		console_printf("net_cmd 0 <ip> <netmask> [gateway]\n");
+		return;
+	}
+	par.ip_addr = net_aton(argv[2]);
+	par.netmask = net_aton(argv[3]);
+	par.gateway = (argc >= 5) ? net_aton(argv[4]) : 0;
+	
+	// ETHがオープン済みの場合はエラーになるがそのまま使う
+	ercd = eth_open(&eth_par);
+	console_printf("eth_open:ercd = %d\n", ercd);
+#ifdef NET_USE_LWIP
+	ercd = lwip_app_open(&par);
+	console_printf("lwip_app_open:ercd = %d\n", ercd);
+#else
+	ercd = net_open(&par);
+	console_printf("net_open:ercd = %d\n", ercd);
+#endif
+	net_test_print_ip("ip:", par.ip_addr);
+	console_printf("tx csum offload:%d\n", eth_tx_csum_offload());
+}
+
+// 統計表示
+static void net_test_stat(void)
+{
+	NET_STAT stat;
+	
+	net_get_stat(&stat);
+	console_printf("rx:%u tx:%u drop:%u\n", stat.rx_cnt, stat.tx_cnt, stat.drop_cnt);
+	console_printf("csum err:%u hw:%u\n", stat.csum_err_cnt, stat.csum_hw_cnt);
+	console_printf("arp req:%u reply:%u fail:%u\n", stat.arp_req_cnt, stat.arp_reply_cnt, stat.arp_fail_cnt);
+	console_printf("icmp echo:%u\n", stat.icmp_echo_cnt);
+	console_printf("udp rx:%u tx:%u drop:%u\n", stat.udp_rx_cnt, stat.udp_tx_cnt, stat.udp_drop_cnt);
+}
+
+// ARPキャッシュ表示
+static void net_test_arp(void)
+{
+	NET_ARP_INFO info[NET_ARP_NUM];
+	char str[18];
+	uint32_t num;
+	uint32_t i;
+	
+	num = net_arp_get(info, NET_ARP_NUM);
+	for (i = 0; i < num; i++) {
+		console_printf("%d.%d.%d.%d ", (info[i].ip_addr >> 24) & 0xFF, (info[i].ip_addr >> 16) & 0xFF, (info[i].ip_addr >> 8) & 0xFF, info[i].ip_addr & 0xFF);
+		console_printf("%s age:%u\n", net_test_mac_str(info[i].mac_addr, str), info[i].age / 1000);
+	}
+}
+
+// UDP送信テスト (テレメトリ想定)
+static void net_test_udp_send(int argc, char *argv[])
+{
+	PKT_BUF *p_pkt;
+	uint32_t ip_addr;
+	uint16_t port;
+	uint32_t num, size;
+	uint32_t i;
+	uint32_t err_cnt = 0;
+	uint8_t *p_payload;
+	int32_t sock;
+	
+	if (argc < 6) {
+		console_printf("net_cmd 3 <ip> <port> <num> <size>\n");
+		return;
+	}
+	ip_addr = net_aton(argv[2]);
+	port = atoi(argv[3]);
+	num = atoi(argv[4]);
+	size = atoi(argv[5]);
+	if ((ip_addr == 0) || (size > NET_UDP_PAYLOAD_MAX)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	if ((sock = net_udp_open(0)) < 0) {
+		console_printf("net_udp_open error\n");
+		return;
+	}
+	
+	for (i = 0; i < num; i++) {
+		if ((p_pkt = net_udp_alloc()) == NULL) {
+			err_cnt++;
+			continue;
+		}
+		// ペイロードは送信バッファに直接書く
+		p_payload = pkt_put(p_pkt, size);
+		memset(p_payload, (uint8_t)i, size);
+		if (net_udp_send(sock, p_pkt, ip_addr, port) != osOK) {
+			err_cnt++;
+		}
+	}
+	net_udp_close(sock);
+	
+	console_printf("udp send:%u err:%u\n", num, err_cnt);
+}
+
+// UDPエコーテスト (受信したバッファをそのまま送り返す)
+static void net_test_udp_echo(int argc, char *argv[])
+{
+	PKT_BUF *p_pkt;
+	uint32_t ip_addr;
+	uint16_t port;
+	uint32_t num;
+	uint32_t i;
+	int32_t sock;
+	
+	if (argc < 4) {
+		console_printf("net_cmd 4 <port> <num>\n");
+		return;
+	}
+	num = atoi(argv[3]);
+	
+	if ((sock = net_udp_open(atoi(argv[2]))) < 0) {
+		console_printf("net_udp_open error\n");
+		return;
+	}
+	
+	for (i = 0; i < num; i++) {
+		if ((p_pkt = net_udp_recv(sock, UDP_TEST_TMOUT, &ip_addr, &port)) == NULL) {
+			console_printf("timeout\n");
+			break;
+		}
+		net_udp_send(sock, p_pkt, ip_addr, port);
+	}
+	net_udp_close(sock);
+	
+	console_printf("udp echo:%u\n", i);
+}
+
+// コマンド
+static void net_test_cmd(int argc, char *argv[])
+{
+	uint8_t idx;
+	
+	// 引数チェック
+	if (argc < 2) {
+		console_printf("net_cmd <idx>\n");
+		console_printf("net_cmd 0 : net_open\n");
+		console_printf("net_cmd 1 : stat\n");
+		console_printf("net_cmd 2 : arp\n");
+		console_printf("net_cmd 3 : udp send\n");
+		console_printf("net_cmd 4 : udp echo\n");
+		return;
+	}
+	
+	// 値設定
+	idx = atoi(argv[1]);
+	
+	if (idx == 0) {
+		net_test_open(argc, argv);
+	} else if (idx == 1) {
+		net_test_stat();
+	} else if (idx == 2) {
+		net_test_arp();
+	} else if (idx == 3) {
+		net_test_udp_send(argc, argv);
+	} else if (idx == 4) {
+		net_test_udp_echo(argc, argv);
+	} else {
+		
+	}
+}
+
+// コマンド設定関数
+void net_test_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "net_cmd";
+	cmd.func = net_test_cmd;
+	console_set_command(&cmd);
+}
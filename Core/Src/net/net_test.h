@@ -0,0 +1,13 @@
+/*
+ * net_test.h
+ *
+ *  Created on: 2026/1/24
+ *      Author: user
+ */
+
+#ifndef SRC_NET_NET_TEST_H_
+#define SRC_NET_NET_TEST_H_
+
+extern void net_test_set_cmd(void);
+
+#endif /* SRC_NET_NET_TEST_H_ */
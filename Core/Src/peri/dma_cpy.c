@@ -0,0 +1,551 @@
+/*
+ * dma_cpy.c
+ *
+ *  Created on: 2026/4/18
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "stm32f7xx_hal_rcc.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "os_sig.h"
+#include "trace.h"
+#include "os_stat.h"
+#include "dma_cpy.h"
+
+// DMA2のメモリ間転送によるコピー
+// ・DMA2 Stream0を使い、要求(転送リスト)をキューに積んで順に転送する。転送中もCPUはほかの処理を進められる
+// ・コピー先はキャッシュライン単位(32byte)の範囲だけDMAで転送し、前後の端数は要求時にCPUでコピーする
+//   (DMAの転送範囲とキャッシュラインを共有するデータがないので、完了時の無効化でほかのデータを壊さない)
+// ・キャッシュは要求時にコピー元をクリーン、コピー先をクリーン+無効化し、完了時にコピー先を無効化する
+// ・閾値より小さいコピーはDMAの設定とキャッシュ操作のほうが高くつくのでCPUでコピーする
+// (*) コピー元とコピー先が重なっていないこと (memcpy()と同じ)
+// (*) 転送リストは完了コールバックまで書き換えないこと (1件のdma_cpy_async()は内部にコピーするので不要)
+
+// マクロ
+#define DMA_CPY_STREAM			DMA2_Stream0
+#define DMA_CPY_IRQ				DMA2_Stream0_IRQn
+#define DMA_CPY_IRQ_PRIORITY	(5)				// 割り込み優先度 (FreeRTOSのAPIを呼べる範囲)
+#define DMA_CPY_THRESHOLD		(1024)			// これより小さいコピーはCPUで行う[byte] (64以上にすること)
+#define DMA_CPY_LINE			(32)			// キャッシュラインサイズ[byte]
+#define DMA_CPY_CHUNK_MAX		(0xFFE0)		// 1回のDMA転送の最大[byte] (NDTRは16bit、ライン単位)
+#define DMA_CPY_REQ_NUM			(8)				// キューに積める要求数 (2のべき乗)
+#define DMA_CPY_REQ_MASK		(DMA_CPY_REQ_NUM - 1)
+#define DMA_CPY_BENCH_SIZE_MAX	(8192)			// ベンチマークの最大サイズ[byte]
+#define DMA_CPY_BENCH_EVT		(1UL << 0)
+
+// Stream0の割り込み要因
+#define DMA_CPY_ISR_TC			DMA_LISR_TCIF0
+#define DMA_CPY_ISR_TE			DMA_LISR_TEIF0
+#define DMA_CPY_IFCR_ALL		(DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0)
+
+// 要求
+typedef struct {
+	const DMA_CPY_SG	*p_sg;		// 転送リスト
+	uint32_t			num;		// 転送リストの件数
+	DMA_CPY_SG			single;		// 1件のときの転送リスト
+	DMA_CPY_CALLBACK	cb;			// 完了コールバック
+	void				*p_ctx;		// コールバックのコンテキスト
+} DMA_CPY_REQ;
+
+// 制御ブロック
+typedef struct {
+	uint32_t			init;					// 初期化済み
+	DMA_CPY_REQ			req[DMA_CPY_REQ_NUM];	// 要求のキュー
+	volatile uint32_t	w_idx;					// 書き込み位置
+	volatile uint32_t	r_idx;					// 転送中の要求
+	volatile uint32_t	busy;					// DMA動作中
+	uint32_t			sg_idx;					// 転送中の転送リストの位置
+	uint8_t				*p_dst;					// 次に転送するコピー先
+	const uint8_t		*p_src;					// 次に転送するコピー元
+	uint32_t			remain;					// 転送リストの1件の残り[byte]
+	uint32_t			chunk;					// 転送中のサイズ[byte]
+	uint8_t				*p_inv;					// 完了時に無効化する範囲
+	uint32_t			inv_len;				// 完了時に無効化する範囲のサイズ[byte]
+	// 統計
+	uint32_t			req_cnt;				// DMAで転送した要求数
+	uint32_t			dma_bytes;				// DMAで転送したサイズ[byte]
+	uint32_t			cpu_bytes;				// CPUでコピーしたサイズ[byte]
+	uint32_t			full_cnt;				// キューがいっぱいだった回数
+	uint32_t			err_cnt;				// 転送エラー回数
+} DMA_CPY_CB;
+static DMA_CPY_CB dma_cpy_cb MEM_PLAN(app);
+#define get_myself() (&dma_cpy_cb)
+
+// ベンチマーク制御ブロック
+typedef struct {
+	OS_SIG_WAITER		waiter;		// 待ち合わせ情報
+	volatile uint32_t	done_cyc;	// 完了時のサイクルカウンタ
+} DMA_CPY_BENCH_CB;
+static DMA_CPY_BENCH_CB dma_cpy_bench_cb MEM_PLAN(app);
+#define get_bench() (&dma_cpy_bench_cb)
+
+// CPUでコピー (newlibのmemcpy()はサイズ優先のバイトコピーなので置き換え用)
+// ・コピー元とコピー先の4byte境界からのずれが同じなら、合わせてから32byteずつ(LDM/STM)コピーする
+// ・ずれが違うならコピー先を合わせて、コピー元は非整列アクセスでワード単位に読む
+// (*) ループがmemcpy()の呼び出しに置き換えられないようにloop-distribute-patternsを止める
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+void MEM_PLAN_ITCM dma_cpy_cpu(void *p_dst, const void *p_src, uint32_t size)
+{
+	uint8_t *d = (uint8_t*)p_dst;
+	const uint8_t *s = (const uint8_t*)p_src;
+	uint32_t *dw;
+	const uint32_t *sw;
+	uint32_t w0, w1, w2, w3, w4, w5, w6, w7;
+	
+	if (size >= 8) {
+		// コピー先を4byte境界に合わせる
+		while (((uint32_t)d & 3) != 0) {
+			*d++ = *s++;
+			size--;
+		}
+		dw = (uint32_t*)d;
+		if (((uint32_t)s & 3) == 0) {
+			sw = (const uint32_t*)s;
+			while (size >= 32) {
+				w0 = sw[0]; w1 = sw[1]; w2 = sw[2]; w3 = sw[3];
+				w4 = sw[4]; w5 = sw[5]; w6 = sw[6]; w7 = sw[7];
+				dw[0] = w0; dw[1] = w1; dw[2] = w2; dw[3] = w3;
+				dw[4] = w4; dw[5] = w5; dw[6] = w6; dw[7] = w7;
+				dw += 8;
+				sw += 8;
+				size -= 32;
+			}
+			while (size >= 4) {
+				*dw++ = *sw++;
+				size -= 4;
+			}
+			s = (const uint8_t*)sw;
+		} else {
+			while (size >= 4) {
+				*dw++ = __UNALIGNED_UINT32_READ(s);
+				s += 4;
+				size -= 4;
+			}
+		}
+		d = (uint8_t*)dw;
+	}
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+}
+
+// 転送リストの1件のうちDMAで転送する範囲 (コピー先のキャッシュライン単位、0はすべてCPUでコピー)
+static uint32_t dma_cpy_middle(const DMA_CPY_SG *p_sg, uint8_t **pp_dst, const uint8_t **pp_src)
+{
+	uint32_t head;
+	
+	if (p_sg->size < DMA_CPY_THRESHOLD) {
+		return 0;
+	}
+	
+	head = (DMA_CPY_LINE - ((uint32_t)p_sg->p_dst & (DMA_CPY_LINE - 1))) & (DMA_CPY_LINE - 1);
+	*pp_dst = (uint8_t*)p_sg->p_dst + head;
+	*pp_src = (const uint8_t*)p_sg->p_src + head;
+	
+	return ((p_sg->size - head) & ~(DMA_CPY_LINE - 1));
+}
+
+// 転送リストの1件の準備 (端数のCPUコピーとキャッシュ操作、戻り値はDMAで転送するサイズ)
+static uint32_t dma_cpy_prepare(const DMA_CPY_SG *p_sg)
+{
+	uint8_t *p_dst;
+	const uint8_t *p_src;
+	uint32_t head, len;
+	
+	len = dma_cpy_middle(p_sg, &p_dst, &p_src);
+	if (len == 0) {
+		dma_cpy_cpu(p_sg->p_dst, p_sg->p_src, p_sg->size);
+		return 0;
+	}
+	
+	// 前後の端数
+	head = (uint32_t)(p_dst - (uint8_t*)p_sg->p_dst);
+	dma_cpy_cpu(p_sg->p_dst, p_sg->p_src, head);
+	dma_cpy_cpu(p_dst + len, p_src + len, p_sg->size - head - len);
+	
+	// コピー元はメモリに書き出し、コピー先は転送中に書き戻されないように捨てる
+	SCB_CleanDCache_by_Addr((uint32_t*)((uint32_t)p_src & ~(DMA_CPY_LINE - 1)), (int32_t)(((uint32_t)p_src & (DMA_CPY_LINE - 1)) + len));
+	SCB_CleanInvalidateDCache_by_Addr((uint32_t*)p_dst, (int32_t)len);
+	
+	return len;
+}
+
+// DMA転送開始 (コピー先はキャッシュライン境界、サイズはライン単位)
+static void dma_cpy_start(uint8_t *p_dst, const uint8_t *p_src, uint32_t len)
+{
+	DMA_Stream_TypeDef *p_st = DMA_CPY_STREAM;
+	uint32_t cr;
+	
+	// メモリ間転送はペリフェラル側がコピー元、NDTRはコピー元の転送単位で数える
+	cr = DMA_SxCR_DIR_1 | DMA_SxCR_PINC | DMA_SxCR_MINC | DMA_SxCR_MSIZE_1 | DMA_SxCR_MBURST_0 |
+	     DMA_SxCR_PL_1 | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	if (((uint32_t)p_src & 3) == 0) {
+		cr |= DMA_SxCR_PSIZE_1;		// ワード
+		p_st->NDTR = len / 4;
+	} else {
+		p_st->NDTR = len;			// バイト (FIFOでワードにまとめる)
+	}
+	DMA2->LIFCR = DMA_CPY_IFCR_ALL;
+	p_st->PAR = (uint32_t)p_src;
+	p_st->M0AR = (uint32_t)p_dst;
+	p_st->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;	// FIFO使用、しきい値はフル (コピー先は4ワードのバースト)
+	p_st->CR = cr;
+	p_st->CR = cr | DMA_SxCR_EN;
+}
+
+// 要求の転送リストから次にDMAで転送するものを探す (なければ0)
+static uint32_t dma_cpy_load(DMA_CPY_CB *this, DMA_CPY_REQ *p_req)
+{
+	uint32_t len;
+	
+	while (this->sg_idx < p_req->num) {
+		len = dma_cpy_middle(&(p_req->p_sg[this->sg_idx]), &(this->p_dst), &(this->p_src));
+		if (len != 0) {
+			this->remain = len;
+			this->p_inv = this->p_dst;
+			this->inv_len = len;
+			return 1;
+		}
+		this->sg_idx++;
+	}
+	
+	return 0;
+}
+
+// 次の転送を開始する (割り込み禁止中か割り込みから呼ぶ)
+static void dma_cpy_next(DMA_CPY_CB *this)
+{
+	DMA_CPY_REQ *p_req;
+	DMA_CPY_CALLBACK cb;
+	void *p_ctx;
+	
+	while (this->r_idx != this->w_idx) {
+		p_req = &(this->req[this->r_idx & DMA_CPY_REQ_MASK]);
+		if ((this->remain != 0) || dma_cpy_load(this, p_req)) {
+			this->chunk = (this->remain > DMA_CPY_CHUNK_MAX) ? DMA_CPY_CHUNK_MAX : this->remain;
+			dma_cpy_start(this->p_dst, this->p_src, this->chunk);
+			return;
+		}
+		
+		// 要求の転送がすべて終わった
+		cb = p_req->cb;
+		p_ctx = p_req->p_ctx;
+		this->sg_idx = 0;
+		this->req_cnt++;
+		this->r_idx++;
+		if (cb != NULL) {
+			cb(osOK, p_ctx);
+		}
+	}
+	this->busy = 0;
+}
+
+// 割り込み処理
+static void dma_cpy_irq_handler(void)
+{
+	DMA_CPY_CB *this = get_myself();
+	DMA_CPY_REQ *p_req;
+	uint32_t isr;
+	
+	isr = DMA2->LISR & (DMA_CPY_ISR_TC | DMA_CPY_ISR_TE);
+	DMA2->LIFCR = DMA_CPY_IFCR_ALL;
+	if (isr == 0) {
+		return;
+	}
+	
+	if (isr & DMA_CPY_ISR_TE) {
+		// 転送エラー (ストリームはハードウェアで停止している)、この要求は打ち切る
+		SCB_InvalidateDCache_by_Addr((uint32_t*)this->p_inv, (int32_t)this->inv_len);
+		p_req = &(this->req[this->r_idx & DMA_CPY_REQ_MASK]);
+		this->err_cnt++;
+		this->remain = 0;
+		this->sg_idx = 0;
+		this->r_idx++;
+		if (p_req->cb != NULL) {
+			p_req->cb(osErrorOS, p_req->p_ctx);
+		}
+	} else {
+		this->dma_bytes += this->chunk;
+		this->p_dst += this->chunk;
+		this->p_src += this->chunk;
+		this->remain -= this->chunk;
+		if (this->remain == 0) {
+			// 転送リストの1件が終わった (転送中に投機的に読まれたラインを捨てる)
+			SCB_InvalidateDCache_by_Addr((uint32_t*)this->p_inv, (int32_t)this->inv_len);
+			this->sg_idx++;
+		}
+	}
+	
+	dma_cpy_next(this);
+}
+
+// DMA2 Stream0割り込みハンドラ
+void DMA2_Stream0_IRQHandler(void)
+{
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_DMA);
+	
+	dma_cpy_irq_handler();
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_DMA);
+}
+
+// 初期化
+osStatus dma_cpy_init(void)
+{
+	DMA_CPY_CB *this = get_myself();
+	DMA_Stream_TypeDef *p_st = DMA_CPY_STREAM;
+	
+	memset(this, 0, sizeof(DMA_CPY_CB));
+	
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	p_st->CR = 0;
+	while (p_st->CR & DMA_SxCR_EN) {
+		;
+	}
+	DMA2->LIFCR = DMA_CPY_IFCR_ALL;
+	
+	// 割り込み有効
+	HAL_NVIC_SetPriority(DMA_CPY_IRQ, DMA_CPY_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(DMA_CPY_IRQ);
+	
+	this->init = 1;
+	
+	return osOK;
+}
+
+// 要求をキューに積む (p_singleがNULLでなければ転送リストを要求にコピーする)
+static osStatus dma_cpy_submit(const DMA_CPY_SG *p_sg, uint32_t num, const DMA_CPY_SG *p_single, DMA_CPY_CALLBACK cb, void* p_ctx)
+{
+	DMA_CPY_CB *this = get_myself();
+	DMA_CPY_REQ *p_req;
+	uint32_t primask;
+	uint32_t dma_len = 0;
+	uint32_t i;
+	
+	if (!this->init) {
+		return osErrorResource;
+	}
+	if ((this->w_idx - this->r_idx) >= DMA_CPY_REQ_NUM) {
+		this->full_cnt++;
+		return osErrorResource;
+	}
+	
+	// 端数と閾値未満はここでコピーし、キャッシュを操作する
+	for (i = 0; i < num; i++) {
+		dma_len += dma_cpy_prepare(&(p_sg[i]));
+	}
+	if (dma_len == 0) {
+		for (i = 0; i < num; i++) {
+			this->cpu_bytes += p_sg[i].size;
+		}
+		if (cb != NULL) {
+			cb(osOK, p_ctx);
+		}
+		return osOK;
+	}
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	// 準備中にほかのタスクが積んでいっぱいになった (端数はもう一度コピーすればよい)
+	if ((this->w_idx - this->r_idx) >= DMA_CPY_REQ_NUM) {
+		this->full_cnt++;
+		__set_PRIMASK(primask);
+		return osErrorResource;
+	}
+	p_req = &(this->req[this->w_idx & DMA_CPY_REQ_MASK]);
+	if (p_single != NULL) {
+		p_req->single = *p_single;
+		p_sg = &(p_req->single);
+	}
+	p_req->p_sg = p_sg;
+	p_req->num = num;
+	p_req->cb = cb;
+	p_req->p_ctx = p_ctx;
+	this->w_idx++;
+	if (!this->busy) {
+		this->busy = 1;
+		dma_cpy_next(this);
+	}
+	__set_PRIMASK(primask);
+	
+	return osOK;
+}
+
+// 非同期コピー (完了したらcbを呼ぶ)
+osStatus dma_cpy_async(void *p_dst, const void *p_src, uint32_t size, DMA_CPY_CALLBACK cb, void* p_ctx)
+{
+	DMA_CPY_SG sg;
+	
+	// パラメータチェック
+	if ((p_dst == NULL) || (p_src == NULL) || (size == 0)) {
+		return osErrorParameter;
+	}
+	
+	sg.p_dst = p_dst;
+	sg.p_src = p_src;
+	sg.size = size;
+	
+	return dma_cpy_submit(&sg, 1, &sg, cb, p_ctx);
+}
+
+// 転送リストの非同期コピー (全部終わったらcbを呼ぶ)
+osStatus dma_cpy_async_sg(const DMA_CPY_SG *p_sg, uint32_t num, DMA_CPY_CALLBACK cb, void* p_ctx)
+{
+	uint32_t i;
+	
+	// パラメータチェック
+	if ((p_sg == NULL) || (num == 0)) {
+		return osErrorParameter;
+	}
+	for (i = 0; i < num; i++) {
+		if ((p_sg[i].p_dst == NULL) || (p_sg[i].p_src == NULL)) {
+			return osErrorParameter;
+		}
+	}
+	
+	return dma_cpy_submit(p_sg, num, NULL, cb, p_ctx);
+}
+
+// 完了をOS_SIG_WAITERに通知するコールバック (p_ctxに待ち合わせ情報を渡す)
+void dma_cpy_notify(osStatus result, void* p_ctx)
+{
+	os_sig_set((OS_SIG_WAITER*)p_ctx, (result == osOK) ? DMA_CPY_EVT_DONE : DMA_CPY_EVT_ERR);
+}
+
+// 同期コピー (memcpy()の置き換え、DMAの転送中は寝て待つ)
+// 閾値未満、割り込み中、スケジューラ開始前、キューがいっぱいのときはCPUでコピーする
+void *dma_cpy(void *p_dst, const void *p_src, uint32_t size)
+{
+	DMA_CPY_CB *this = get_myself();
+	OS_SIG_WAITER waiter;
+	uint32_t bits;
+	
+	if ((size < DMA_CPY_THRESHOLD) || (!this->init) || (__get_IPSR() != 0) || (osKernelRunning() == 0)) {
+		dma_cpy_cpu(p_dst, p_src, size);
+		return p_dst;
+	}
+	
+	os_sig_prepare(&waiter);
+	if (dma_cpy_async(p_dst, p_src, size, dma_cpy_notify, &waiter) != osOK) {
+		dma_cpy_cpu(p_dst, p_src, size);
+		return p_dst;
+	}
+	
+	// 待ち合わせ情報はスタックにあるので、タイムアウトせずに必ず完了を待つ
+	bits = os_sig_wait(&waiter, DMA_CPY_EVT_DONE | DMA_CPY_EVT_ERR, -1);
+	if (bits & DMA_CPY_EVT_ERR) {
+		dma_cpy_cpu(p_dst, p_src, size);
+	}
+	
+	return p_dst;
+}
+
+// ベンチマークのコールバック (完了時刻を記録)
+static void dma_cpy_bench_callback(osStatus result, void* p_ctx)
+{
+	DMA_CPY_BENCH_CB *p_bench = (DMA_CPY_BENCH_CB*)p_ctx;
+	
+	p_bench->done_cyc = DWT->CYCCNT;
+	os_sig_set(&(p_bench->waiter), DMA_CPY_BENCH_EVT);
+}
+
+// コピー方式ごとのサイクル数を測るコマンド
+// dma_cpy <size> [offset]
+static void dma_cpy_cmd(int argc, char *argv[])
+{
+	DMA_CPY_CB *this = get_myself();
+	DMA_CPY_BENCH_CB *p_bench = get_bench();
+	uint8_t *p_src_buf, *p_dst_buf;
+	uint8_t *p_src, *p_dst;
+	uint32_t size, offset = 0;
+	uint32_t start, cyc_memcpy, cyc_cpu, cyc_dma, cyc_submit, cyc_done;
+	uint32_t i;
+	osStatus ercd;
+	
+	if (argc < 2) {
+		console_printf("dma_cpy <size(1-%u)> [dst offset(0-31)]\n", DMA_CPY_BENCH_SIZE_MAX);
+		console_printf(" dma %u req %u byte, cpu %u byte, full %u, err %u\n",
+		               this->req_cnt, this->dma_bytes, this->cpu_bytes, this->full_cnt, this->err_cnt);
+		return;
+	}
+	size = atoi(argv[1]);
+	if (argc >= 3) {
+		offset = atoi(argv[2]);
+	}
+	if ((size == 0) || (size > DMA_CPY_BENCH_SIZE_MAX) || (offset >= DMA_CPY_LINE)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	// バッファはヒープから取る
+	p_src_buf = malloc(size);
+	p_dst_buf = malloc(size + DMA_CPY_LINE);
+	if ((p_src_buf == NULL) || (p_dst_buf == NULL)) {
+		console_printf("no memory\n");
+		goto EXIT;
+	}
+	p_src = p_src_buf;
+	p_dst = p_dst_buf + offset;
+	for (i = 0; i < size; i++) {
+		p_src[i] = (uint8_t)(i * 7 + 1);
+	}
+	
+	// newlibのmemcpy()
+	start = DWT->CYCCNT;
+	memcpy(p_dst, p_src, size);
+	cyc_memcpy = DWT->CYCCNT - start;
+	
+	// CPU (ワード/ブロック単位)
+	start = DWT->CYCCNT;
+	dma_cpy_cpu(p_dst, p_src, size);
+	cyc_cpu = DWT->CYCCNT - start;
+	
+	// 同期 (閾値未満はCPU)
+	memset(p_dst, 0, size);
+	start = DWT->CYCCNT;
+	dma_cpy(p_dst, p_src, size);
+	cyc_dma = DWT->CYCCNT - start;
+	if (memcmp(p_dst, p_src, size) != 0) {
+		console_printf("dma_cpy : data NG\n");
+	}
+	
+	// 非同期 (要求から戻るまでがCPUの使用分、残りはほかの処理に使える)
+	memset(p_dst, 0, size);
+	os_sig_prepare(&(p_bench->waiter));
+	p_bench->done_cyc = 0;
+	start = DWT->CYCCNT;
+	ercd = dma_cpy_async(p_dst, p_src, size, dma_cpy_bench_callback, p_bench);
+	cyc_submit = DWT->CYCCNT - start;
+	if (ercd != osOK) {
+		console_printf("dma_cpy_async error %d\n", ercd);
+		goto EXIT;
+	}
+	os_sig_wait(&(p_bench->waiter), DMA_CPY_BENCH_EVT, -1);
+	cyc_done = p_bench->done_cyc - start;
+	if (memcmp(p_dst, p_src, size) != 0) {
+		console_printf("dma_cpy_async : data NG\n");
+	}
+	
+	console_printf("size %u offset %u [cycles] : memcpy %u, cpu %u, dma_cpy %u\n", size, offset, cyc_memcpy, cyc_cpu, cyc_dma);
+	console_printf(" async : submit %u, done %u\n", cyc_submit, cyc_done);
+	
+EXIT:
+	free(p_src_buf);
+	free(p_dst_buf);
+}
+
+// コマンド設定関数
+void dma_cpy_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "dma_cpy";
+	cmd.func = dma_cpy_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,34 @@
+/*
+ * dma_cpy.h
+ *
+ *  Created on: 2026/4/18
+ *      Author: user
+ */
+
+#ifndef PERI_DMA_CPY_H_
+#define PERI_DMA_CPY_H_
+
+// 転送リストの1件
+typedef struct {
+	void		*p_dst;		// コピー先
+	const void	*p_src;		// コピー元
+	uint32_t	size;		// サイズ[byte]
+} DMA_CPY_SG;
+
+// 完了コールバック (DMAで転送したときは割り込みコンテキスト、全部CPUでコピーしたときは要求したコンテキストで呼ばれる)
+// result : osOK or osErrorOS (転送エラー、コピー先の内容は不定)
+typedef void (*DMA_CPY_CALLBACK)(osStatus result, void* p_ctx);
+
+// dma_cpy_notify()で通知するイベント (p_ctxにOS_SIG_WAITERを渡す)
+#define DMA_CPY_EVT_DONE		(1UL << 0)		// 完了
+#define DMA_CPY_EVT_ERR			(1UL << 1)		// 転送エラー
+
+extern osStatus dma_cpy_init(void);
+extern void dma_cpy_cpu(void *p_dst, const void *p_src, uint32_t size);
+extern void *dma_cpy(void *p_dst, const void *p_src, uint32_t size);
+extern osStatus dma_cpy_async(void *p_dst, const void *p_src, uint32_t size, DMA_CPY_CALLBACK cb, void* p_ctx);
+extern osStatus dma_cpy_async_sg(const DMA_CPY_SG *p_sg, uint32_t num, DMA_CPY_CALLBACK cb, void* p_ctx);
+extern void dma_cpy_notify(osStatus result, void* p_ctx);
+extern void dma_cpy_set_cmd(void);
+
+#endif /* PERI_DMA_CPY_H_ */
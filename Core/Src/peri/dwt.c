@@ -0,0 +1,23 @@
+/*
+ * dwt.c
+ *
+ *  Created on: 2026/3/7
+ *      Author: user
+ */
+#include "stm32f7xx.h"
+#include "dwt.h"
+
+// マクロ
+#define DWT_LAR_KEY		(0xC5ACCE55)	// ロック解除のキー
+
+// サイクルカウンタ有効
+// ・Cortex-M7のDWTはソフトウェアからの書き込みがロックされているので、LARにキーを書いて解除してから有効にする
+//   (デバッガ接続中はデバッガが解除しているので、解除しないと接続していないときだけカウンタが0のまま)
+// (*) .data/.bssの初期化前にReset_Handlerから呼ぶので、グローバル変数を使わないこと
+void dwt_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->LAR = DWT_LAR_KEY;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
@@ -0,0 +1,17 @@
+/*
+ * dwt.h
+ *
+ *  Created on: 2026/3/7
+ *      Author: user
+ */
+
+#ifndef PERI_DWT_H_
+#define PERI_DWT_H_
+
+// DWTのサイクルカウンタ (CYCCNT)
+// ・リセット直後にReset_Handlerからdwt_init()を1回だけ呼んで有効にする
+// ・ほかのモジュールはDWT->CYCCNTを読むだけにすること (実行時間統計の差分が壊れる)
+
+extern void dwt_init(void);
+
+#endif /* PERI_DWT_H_ */
@@ -10,18 +10,71 @@
 #include "cmsis_os.h"
 #include "iodefine.h"
 #include "console.h"
+#include "os_sig.h"
+#include "mem_plan.h"
+#include "trace.h"
+#include "os_stat.h"
+#include "pkt_buf.h"
+#include "eth_if.h"
+#include "hrt.h"
+#include "boot.h"
 
 #include "eth.h"
 
 // マクロ
 #define DATA_BUFF_SIZE_MAX		(1504)
-#define BUFF_SISE_K				(64)
 #define PHY_ADDRESS				(0)
 #define TX_DISCRIPTOR_NUM		(6)
+#define RX_DISCRIPTOR_NUM		(8)
+#define RX_BUFF_SIZE			(PKT_DATA_SIZE)	// 受信バッファサイズ (パケットバッファのデータ領域)
+#define RX_QUE_NUM				(16)		// 優先度キューの段数 (2のべき乗)
+#define RX_QUE_MASK				(RX_QUE_NUM - 1)
+#define RX_PENDING_MAX			(RX_DISCRIPTOR_NUM + RX_QUE_NUM * ETH_PRIO_NUM)	// 受信待ちフレーム数の最大
+#define TX_HDR_SIZE				(64)		// 送信ヘッダ作成バッファサイズ (キャッシュライン x2、TSOのETH+IPv4+UDPヘッダが入る)
+#define NSEC_PER_SEC			(1000000000UL)
+#define PTP_CLOCK_HZ			(50000000UL)					// PTPカウンタの更新周波数 (ファイン補正でHCLKから生成)
+#define PTP_SUBSEC_INC			(NSEC_PER_SEC / PTP_CLOCK_HZ)	// 1更新あたりのサブ秒加算値[ns]
+#define TT_QUEUE_NUM			(16)		// タイムトリガ送信キューの段数 (2のべき乗)
+#define TT_LOG_NUM				(64)		// 周期ごとの送信オフセット記録数 (2のべき乗)
+#define TT_PERIOD_MIN			(20000)		// タイムトリガ送信の最小周期[ns]
+#define TT_START_DELAY			(1000000)	// タイムトリガ送信開始までの猶予[ns]
+#define DMA_RESET_TMOUT_US		(1000)		// DMAリセット完了待ち[us]
+#define TSO_STALL_TMOUT			(100)		// TSOのセグメントの送信が進まない場合のタイムアウト[ms]
+#define DMA_TX_DRAIN_TMOUT		(100)		// DMA設定変更時の送信完了待ち[ms]
+#define DMA_FLUSH_TMOUT_US		(1000)		// 送信FIFOフラッシュ完了待ち[us]
+#define FC_PAUSE_TMOUT_US		(2000)		// PAUSEフレーム送信完了待ち[us] (10Mbpsで1フレーム約70us)
+#define PTP_UPDATE_TMOUT_US		(1000)		// タイムスタンプのaddend更新、時刻初期化の完了待ち[us]
+#define PHY_MDIO_TMOUT_US		(1000)		// MDIOアクセス完了待ち[us] (MDC 2.5MHzで1フレーム約26us)
+#define PHY_AUTONEG_TMOUT		(5000)		// オートネゴシエーション完了待ち[ms]
+#define PHY_AUTONEG_POLL		(10)		// オートネゴシエーションの完了確認間隔[ms]
+#define REG_WRITE_DELAY_US		(10)		// DMAOMR書き込み後の待ち[us] (10Mbpsで送受信クロック4周期以上)
+#define FILTER_ADDR_NUM			(16)		// 登録できる受信アドレス数
+#define FILTER_PERFECT_NUM		(3)			// 完全一致フィルタ数 (MACA1～3)
+#define FILTER_HASH_BITS		(64)		// ハッシュテーブルのビット数
+#define ETH_TYPE_MAC_CONTROL	(0x8808)	// MAC制御フレームのEtherType
+#define MAC_CONTROL_PAUSE		(0x0001)	// PAUSEのオペコード
+#define ETH_TYPE_VLAN			(0x8100)	// VLANタグのTPID
+#define ETH_TYPE_IPV4			(0x0800)	// IPv4のEtherType
+#define ETH_FRAME_SIZE_MAX		(1514)		// 最大フレームサイズ (FCSなし、タグなし)
+#define IP_PROTO_UDP			(17)		// UDPのプロトコル番号
+#define ETH_ADDR_AREA_SIZE		(12)		// 宛先 + 送信元MACアドレスのサイズ
+#define VLAN_TAG_SIZE			(4)			// VLANタグのサイズ
+#define VLAN_VID(tci)			((tci) & 0x0FFF)
 
 // 機能マクロ
 #define MMC_ENABLE
 #define LOOPBACK_TEST_ENABLE
+#define TX_RING_MODE_ENABLE		// 送信ディスクリプタをリングモードで使用する (1ディスクリプタにバッファ2つ)
+
+// 送信ディスクリプタあたりのバッファ数
+#ifdef TX_RING_MODE_ENABLE
+#define TX_BUFF_PER_DESC		(2)
+#define TX_DESC_SKIP_WORD		(4)		// ディスクリプタ間の空き[word] (1ディスクリプタを1キャッシュラインに配置)
+#else
+#define TX_BUFF_PER_DESC		(1)
+#define TX_DESC_SKIP_WORD		(0)
+#endif
+#define TX_SEG_NUM_MAX			(TX_DISCRIPTOR_NUM * TX_BUFF_PER_DESC)
 
 // 状態定義
 #define ST_INIT		(0)		// 初期状態
@@ -33,6 +86,25 @@
 #define EVT_SEND_SUCCESS	(1UL << 0)
 #define EVT_RECV_SUCCESS	(1UL << 1)
 #define EVT_SEND_FAIL		(1UL << 2)
+#define EVT_TSO_DONE		(1UL << 3)		// TSOのセグメント送信完了 (ディスクリプタが空いた)
+
+// 送信ディスクリプタの使用者
+#define TX_KIND_NONE		(0)		// 未使用
+#define TX_KIND_SEND		(1)		// eth_send
+#define TX_KIND_TT			(2)		// タイムトリガ送信
+#define TX_KIND_ASYNC		(3)		// eth_send_nowait (完了を待たない)
+#define TX_KIND_TSO			(4)		// eth_send_tso (セグメントごとに完了を通知)
+
+// DMA設定のデフォルト
+#define DMA_PBL_DEFAULT		(16)	// バースト長[beat]
+
+// フロー制御状態
+#define FC_ST_XON			(0)		// 相手の送信を止めていない
+#define FC_ST_XOFF			(1)		// PAUSE送信済み
+
+// タイムトリガ送信状態
+#define TT_ST_STOP			(0)		// 停止
+#define TT_ST_RUN			(1)		// 動作中
 
 // 送信ディスクリプタ
 #define TDES0_OWN		(1 << 31)
@@ -42,7 +114,8 @@
 #define TDES0_DC		(1 << 27)
 #define TDES0_DP		(1 << 26)
 #define TDES0_TTSE		(1 << 25)
-#define TDES0_CIC		(((v) & 0x3) << 22)
+#define TDES0_CIC(v)	(((v) & 0x3) << 22)
+#define TDES0_CIC_FULL	(3)		// IPヘッダ、ペイロード(疑似ヘッダ含む)のチェックサムを挿入
 #define TDES0_TER		(1 << 21)
 #define TDES0_TCH		(1 << 20)
 #define TDES0_TTSS		(1 << 17)
@@ -63,6 +136,32 @@
 #define TDES1_TBS1(v)	(((v) & 0x0FFF) << 0)
 #define TDES1_TBS2(v)	(((v) & 0x0FFF) << 16)
 
+// 受信ディスクリプタ
+#define RDES0_OWN		(1UL << 31)
+#define RDES0_AFM		(1 << 30)
+#define RDES0_FL(v)		(((v) >> 16) & 0x3FFF)
+#define RDES0_ES		(1 << 15)
+#define RDES0_DE		(1 << 14)
+#define RDES0_SAF		(1 << 13)
+#define RDES0_LE		(1 << 12)
+#define RDES0_OE		(1 << 11)
+#define RDES0_VLAN		(1 << 10)
+#define RDES0_FS		(1 << 9)
+#define RDES0_LS		(1 << 8)
+#define RDES0_IPHCE		(1 << 7)
+#define RDES0_LCO		(1 << 6)
+#define RDES0_FT		(1 << 5)
+#define RDES0_RWT		(1 << 4)
+#define RDES0_RE		(1 << 3)
+#define RDES0_DBE		(1 << 2)
+#define RDES0_CE		(1 << 1)
+#define RDES0_PCE		(1 << 0)
+#define RDES1_DIC		(1UL << 31)
+#define RDES1_RBS2(v)	(((v) & 0x1FFF) << 16)
+#define RDES1_RER		(1 << 15)
+#define RDES1_RCH		(1 << 14)
+#define RDES1_RBS1(v)	(((v) & 0x1FFF) << 0)
+
 // PHYレジスタ
 #define PHY_REG_BASIC_CONTROL										(0)
 #define PHY_REG_BASIC_STATUS										(1)
@@ -92,6 +191,7 @@
 #define BASIC_CONTROL_LOOP_BACK										(1 << 14)
 #define BASIC_CONTROL_SPEED_SELECT_10MBPS							(0 << 13)
 #define BASIC_CONTROL_SPEED_SELECT_100MBPS							(1 << 13)
+#define BASIC_CONTROL_AUTO_NEGOTIATE_ENABLE							(1 << 12)
 #define BASIC_CONTROL_POWER_DOWN									(1 << 11)
 #define BASIC_CONTROL_ISOLATE										(1 << 10)
 #define BASIC_CONTROL_RESTART_AUTO_NEGOTIATE						(1 << 9)
@@ -161,6 +261,12 @@
 #define EDPD_NLP_CROSSOVER_TIME_RX_SINGLE_NLP_WAKE_ENABLE			(1 << 12)
 #define EDPD_NLP_CROSSOVER_TIME_RX_NLP_MAX_INTERVAL_DETECT_SELECT	(0x3 << 14)
 
+// PHY_SPECIAL_CONTROL_STATUS
+#define PHY_SPECIAL_CONTROL_STATUS_AUTODONE							(1 << 12)
+#define PHY_SPECIAL_CONTROL_STATUS_FULL_DUPLEX						(1 << 4)	// 速度表示 (オートネゴシエーションの結果)
+#define PHY_SPECIAL_CONTROL_STATUS_100MBPS							(1 << 3)
+#define PHY_SPECIAL_CONTROL_STATUS_10MBPS							(1 << 2)
+
 // MMD
 #define MMD_DEVICE_ADDRESS_PCS										(3)
 #define MMD_DEVICE_ADDRESS_VENDOR									(30)
@@ -211,13 +317,102 @@ typedef enum {
 #define MACMIIAR_CR(v)							(((v) & 0x7)  << ETH_MACMIIAR_CR_Pos)	// 
 #define WUCSR_LED_FUNCTION_SELECT(idx,func)		(idx == LED_IDX_1) ? (((func) & 0x3)  << 13) : (((func) & 0x3)  << 11)
 
-// 制御ブロック
+// タイムトリガ送信フレーム
+typedef struct {
+	uint8_t			*p_data;		// 送信データ
+	uint32_t		size;			// 送信サイズ
+} TT_FRAME;
+
+// タイムトリガ送信制御ブロック
+typedef struct {
+	uint32_t		status;					// 状態
+	uint32_t		period;					// 送信周期[ns]
+	uint32_t		tgt_sec;				// 次のターゲット時刻(秒)
+	uint32_t		tgt_nsec;				// 次のターゲット時刻(ナノ秒)
+	TT_FRAME		que[TT_QUEUE_NUM];		// 送信待ちフレーム
+	uint32_t		w_idx;					// ライトインデックス
+	uint32_t		r_idx;					// リードインデックス
+	ETH_TT_STAT		stat;					// 統計
+	uint64_t		offset_sum;				// 送信オフセットの合計[ns]
+	int32_t			log[TT_LOG_NUM];		// 周期ごとの送信オフセット[ns]
+	uint32_t		log_idx;				// 送信オフセット記録インデックス
+} TT_CB;
+
+// アドレスフィルタ登録情報
+typedef struct {
+	uint8_t			addr[6];		// MACアドレス
+	uint8_t			slot;			// 完全一致フィルタ番号 or ETH_FILTER_SLOT_HASH
+	uint8_t			ref;			// 参照カウント (0なら未使用)
+} FILTER_ENTRY;
+
+// アドレスフィルタ制御ブロック
+typedef struct {
+	FILTER_ENTRY	entry[FILTER_ADDR_NUM];				// 登録アドレス
+	uint8_t			perfect_used[FILTER_PERFECT_NUM];	// 完全一致フィルタ使用中
+	uint8_t			hash_ref[FILTER_HASH_BITS];			// ハッシュビットごとの参照数
+	uint32_t		hash_uc_num;						// ハッシュに登録したユニキャストアドレス数
+	uint32_t		hash_mc_num;						// ハッシュに登録したマルチキャストアドレス数
+	osMutexId		mutex;								// 登録とレジスタ反映の排他
+} FILTER_CB;
+
+// フロー制御制御ブロック
 typedef struct {
+	ETH_FC_PAR		par;			// 設定
 	uint32_t		status;			// 状態
-	osMailQId		mail_handle;	// メールハンドル
-	osThreadId		thread_id;		// タスクID
+	uint32_t		xoff_sec;		// PAUSE送信時刻(秒)
+	uint32_t		xoff_nsec;		// PAUSE送信時刻(ナノ秒)
+	ETH_FC_STAT		stat;			// 統計
+} FC_CB;
+
+// 受信制御ブロック
+typedef struct {
+	PKT_BUF			*que[ETH_PRIO_NUM][RX_QUE_NUM];	// 優先度キュー
+	uint32_t		w_idx[ETH_PRIO_NUM];			// 書き込み位置
+	uint32_t		r_idx[ETH_PRIO_NUM];			// 読み出し位置
+	uint32_t		que_num;						// 全優先度キューのフレーム数
+	PKT_BUF			*desc_pkt[RX_DISCRIPTOR_NUM];	// ディスクリプタに割り当て中のバッファ
+	ETH_VLAN_PAR	vlan;							// VLAN設定
+	ETH_VLAN_STAT	stat;							// 統計
+} RX_CB;
+
+// TSOの要求 (eth_send_tso()の呼び出しごとに呼び出し元のスタックに置く)
+// 待ち合わせ情報を先頭に置き、tx_waiter[]から要求を引けるようにする
+typedef struct {
+	OS_SIG_WAITER		waiter;			// 待ち合わせ情報
+	volatile uint32_t	pending_num;	// 送信中のセグメント数
+	volatile uint32_t	err_cnt;		// 送信エラーになったセグメント数
+} TSO_REQ;
+#define TSO_REQ_OF(p_waiter)	((TSO_REQ*)(p_waiter))
+
+// 受信待ち (eth_recv_pkt()の呼び出しごとに呼び出し元のスタックに置き、受信待ちリストにつなぐ)
+typedef struct rx_waiter {
+	OS_SIG_WAITER		waiter;		// 待ち合わせ情報
+	struct rx_waiter	*next;		// 受信待ちリストの次
+} RX_WAITER;
+
+// 制御ブロック
+typedef struct {
+	uint32_t		status;							// 状態
+	RX_WAITER		*p_rx_waiter;					// 受信待ちリスト (受信したら全員に通知する)
+	osMutexId		mdio_mutex;						// MDIO(PHYレジスタアクセス)の排他
+	uint32_t		link_up;						// オートネゴシエーション完了 (link_maccrが有効)
+	uint32_t		link_maccr;						// オートネゴシエーション結果のMACCRの速度と全二重 (FES、DM)
+	ETH_OPEN		open_par;						// オープンパラメータ
+	uint32_t		tx_put_idx;						// 次に使用する送信ディスクリプタ
+	uint32_t		tx_clean_idx;					// 次に回収する送信ディスクリプタ
+	uint32_t		tx_free_num;					// 空き送信ディスクリプタ数
+	uint8_t			tx_kind[TX_DISCRIPTOR_NUM];		// 送信ディスクリプタの使用者
+	OS_SIG_WAITER	*tx_waiter[TX_DISCRIPTOR_NUM];	// 送信完了を待つ要求 (フレームの最終ディスクリプタ)
+	uint32_t		rx_idx;							// 次に読み出す受信ディスクリプタ
+	RX_CB			rx;								// 受信
+	TT_CB			tt;								// タイムトリガ送信
+	FILTER_CB		filter;							// アドレスフィルタ
+	FC_CB			fc;								// フロー制御
+	ETH_LOOPBACK	loopback;						// ループバック
+	uint32_t		loopback_maccr;					// PHYループバック前のMACCRの速度と全二重 (FES、DM)
+	ETH_DMA_STAT	dma_stat;						// DMA統計
 } ETH_CB;
-static ETH_CB eth_cb;
+static ETH_CB eth_cb MEM_PLAN(eth);
 #define get_myself() (&eth_cb)
 
 // チャネル情報
@@ -239,6 +434,10 @@ static const uint8_t mac_address[6] = {
 	0x02, 0x00, 0x00, 0x00, 0x00, 0x01
 };
 
+// 完全一致フィルタレジスタ (MACA1～3)
+#define get_perfect_hr(p_reg, slot)	(&((p_reg)->MACA1HR) + ((slot) * 2))
+#define get_perfect_lr(p_reg, slot)	(&((p_reg)->MACA1LR) + ((slot) * 2))
+
 // MMDレジスタ情報
 typedef struct {
 	uint16_t	index;
@@ -268,11 +467,485 @@ static const MMD_INFO mmd_info_tbl[] = {
 // テスト用のためディスクリプタはペリフェラルドライバで持つ
 typedef struct {
 	uint32_t TDES[4];
+#ifdef TX_RING_MODE_ENABLE
+	uint32_t rsv[TX_DESC_SKIP_WORD];	// DSLでスキップする領域
+#endif
 } TX_DESCRIPTOR;
-static TX_DESCRIPTOR tx_descriptor[TX_DISCRIPTOR_NUM] __ALIGNED(32);
+static TX_DESCRIPTOR tx_descriptor[TX_DISCRIPTOR_NUM] __ALIGNED(32) MEM_PLAN(eth);
+typedef struct {
+	uint32_t RDES[4];
+} RX_DESCRIPTOR;
+static RX_DESCRIPTOR rx_descriptor[RX_DISCRIPTOR_NUM] __ALIGNED(32) MEM_PLAN(eth);
+static uint8_t tx_hdr[TX_DISCRIPTOR_NUM][TX_HDR_SIZE] __ALIGNED(32) MEM_PLAN(eth);
+
+// PCPから優先度キューへの変換 (IEEE 802.1Q 4トラフィッククラスの推奨値)
+static const uint8_t vlan_prio_map_default[8] = {
+	1, 0, 0, 1, 2, 2, 3, 3,
+};
+
+// 送信スレッショルド[byte]からTTCへの変換テーブル (インデックスがTTCの設定値)
+static const uint16_t dma_ttc_tbl[] = {
+	64, 128, 192, 256, 40, 32, 24, 16,
+};
+
+// 受信スレッショルド[byte]からRTCへの変換テーブル (インデックスがRTCの設定値)
+static const uint16_t dma_rtc_tbl[] = {
+	64, 32, 96, 128,
+};
+
+// ディスクリプタの接続方法 (TDES0に設定)
+// チェインモード : TCH (TDES3が次のディスクリプタ)
+// リングモード   : 最後のディスクリプタのみTER (TDES3はバッファ2)
+static uint32_t tx_tdes0_mode(uint32_t idx)
+{
+#ifdef TX_RING_MODE_ENABLE
+	if (idx == (TX_DISCRIPTOR_NUM - 1)) {
+		return TDES0_TER;
+	}
+	return 0;
+#else
+	return TDES0_TCH;
+#endif
+}
+
+// 送信開始要求
+static void tx_kick(ETH_TypeDef *p_reg)
+{
+	// 送信DMAが停止していれば開始
+	if ((p_reg->DMAOMR & ETH_DMAOMR_ST) == 0) {
+		p_reg->DMAOMR |= ETH_DMAOMR_ST;
+	}
+	
+	// サスペンド中のDMAにディスクリプタを再読み込みさせる
+	p_reg->DMATPDR = 0;
+}
+
+// 送信ディスクリプタ1つの完了処理と回収 (tx_clean_idxのディスクリプタ、割り込み禁止か割り込みから呼ぶ)
+// tdes0 : 完了時のTDES0 (LSのディスクリプタなら要求元に結果を通知する)
+static void tx_complete(uint32_t tdes0)
+{
+	ETH_CB *this = get_myself();
+	uint32_t idx = this->tx_clean_idx;
+	TSO_REQ *p_req;
+	
+	if ((tdes0 & TDES0_LS) != 0) {
+		// eth_send()のフレームは完了を通知
+		if (this->tx_kind[idx] == TX_KIND_SEND) {
+			os_sig_set(this->tx_waiter[idx], ((tdes0 & TDES0_ES) != 0) ? EVT_SEND_FAIL : EVT_SEND_SUCCESS);
+		}
+		// eth_send_nowait()のフレームはエラーを数えるだけ
+		if ((this->tx_kind[idx] == TX_KIND_ASYNC) && ((tdes0 & TDES0_ES) != 0)) {
+			this->dma_stat.tx_err_cnt++;
+		}
+		// タイムトリガ送信のフレームはエラー(アンダーフロー、遅延など)を数える
+		if ((this->tx_kind[idx] == TX_KIND_TT) && ((tdes0 & TDES0_ES) != 0)) {
+			this->tt.stat.err_cnt++;
+		}
+		// eth_send_tso()のセグメントは要求のセグメント数を減らして空きができたことを通知
+		// (待ちをやめた要求はtx_waiter[]がNULL)
+		if (this->tx_kind[idx] == TX_KIND_TSO) {
+			if ((tdes0 & TDES0_ES) != 0) {
+				this->dma_stat.tx_err_cnt++;
+			}
+			if (this->tx_waiter[idx] != NULL) {
+				p_req = TSO_REQ_OF(this->tx_waiter[idx]);
+				if ((tdes0 & TDES0_ES) != 0) {
+					p_req->err_cnt++;
+				}
+				p_req->pending_num--;
+				os_sig_set(&(p_req->waiter), EVT_TSO_DONE);
+			}
+		}
+	}
+	
+	// 回収
+	TRACE_EVT(TRACE_ETH_TX_DONE, idx);
+	this->tx_kind[idx] = TX_KIND_NONE;
+	this->tx_waiter[idx] = NULL;
+	this->tx_clean_idx = (idx + 1) % TX_DISCRIPTOR_NUM;
+	this->tx_free_num++;
+}
+
+// 送信完了ディスクリプタの回収 (割り込みコンテキスト)
+// eth_send()、eth_send_tso()で送信したフレームは要求元に完了を通知する
+static void tx_reclaim(void)
+{
+	ETH_CB *this = get_myself();
+	TX_DESCRIPTOR *p_desc;
+	
+	while (this->tx_free_num < TX_DISCRIPTOR_NUM) {
+		p_desc = &(tx_descriptor[this->tx_clean_idx]);
+		// まだDMAが所有している
+		if ((p_desc->TDES[0] & TDES0_OWN) != 0) {
+			break;
+		}
+		tx_complete(p_desc->TDES[0]);
+	}
+}
+
+// 送信リングのリセット (バスエラーで送信DMAが止まった場合、割り込みコンテキスト)
+// 送信中のフレームはすべて失敗として要求元に通知して回収し、送信DMAは次の送信で先頭のディスクリプタから再開する
+static void tx_abort(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	TX_DESCRIPTOR *p_desc;
+	uint32_t idx;
+	
+	// 送信DMA停止
+	p_reg->DMAOMR &= ~ETH_DMAOMR_ST;
+	
+	// 送信中のディスクリプタはすべてエラーで完了
+	while (this->tx_free_num < TX_DISCRIPTOR_NUM) {
+		idx = this->tx_clean_idx;
+		p_desc = &(tx_descriptor[idx]);
+		tx_complete(p_desc->TDES[0] | TDES0_ES);
+		p_desc->TDES[0] = tx_tdes0_mode(idx);
+	}
+	
+	// リングの先頭から使い直す (ディスクリプタリストのアドレスは送信DMA停止中に設定する)
+	this->tx_put_idx = 0;
+	this->tx_clean_idx = 0;
+	p_reg->DMATDLAR = (uint32_t)&(tx_descriptor[0]);
+}
+
+// PTP時刻取得
+static void ptp_get_time(ETH_TypeDef *p_reg, uint32_t *p_sec, uint32_t *p_nsec)
+{
+	uint32_t sec;
+	
+	// 読み出し中に秒が繰り上がった場合は読み直す
+	do {
+		sec = p_reg->PTPTSHR;
+		*p_nsec = p_reg->PTPTSLR & ETH_PTPTSLR_STSS;
+	} while (sec != p_reg->PTPTSHR);
+	*p_sec = sec;
+}
+
+// PTP時刻に加算
+static void ptp_add_time(uint32_t *p_sec, uint32_t *p_nsec, uint32_t nsec)
+{
+	*p_nsec += nsec;
+	while (*p_nsec >= NSEC_PER_SEC) {
+		*p_nsec -= NSEC_PER_SEC;
+		(*p_sec)++;
+	}
+}
+
+// PTP時刻の差分[ns] (a - b, ±1秒以内であること)
+static int32_t ptp_diff_time(uint32_t a_sec, uint32_t a_nsec, uint32_t b_sec, uint32_t b_nsec)
+{
+	return (int32_t)((a_sec - b_sec) * NSEC_PER_SEC) + ((int32_t)a_nsec - (int32_t)b_nsec);
+}
+
+// ターゲット時刻設定
+static void tt_set_target(ETH_TypeDef *p_reg, uint32_t sec, uint32_t nsec)
+{
+	p_reg->PTPTTHR = sec;
+	p_reg->PTPTTLR = nsec;
+	// ターゲット時刻割り込み有効 (割り込み発生でクリアされるため毎回設定)
+	p_reg->PTPTSCR |= ETH_PTPTSCR_TSITE;
+}
+
+// タイムトリガ送信処理 (ターゲット時刻割り込み)
+static void tt_handler(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	TT_FRAME *p_frame;
+	TX_DESCRIPTOR *p_desc;
+	uint32_t now_sec, now_nsec;
+	uint32_t idx;
+	int32_t offset;
+	
+	// 停止中
+	if (p_tt->status != TT_ST_RUN) {
+		return;
+	}
+	
+	p_tt->stat.cycle_cnt++;
+	
+	// 送信待ちフレームなし
+	if (p_tt->w_idx == p_tt->r_idx) {
+		p_tt->stat.idle_cnt++;
+		
+	// ディスクリプタが空いていない
+	} else if (this->tx_free_num == 0) {
+		p_tt->stat.miss_cnt++;
+		
+	// 送信 (キャッシュはキューイング時にクリーン済み)
+	} else {
+		p_frame = &(p_tt->que[p_tt->r_idx]);
+		idx = this->tx_put_idx;
+		p_desc = &(tx_descriptor[idx]);
+		p_desc->TDES[2] = (uint32_t)p_frame->p_data;
+		p_desc->TDES[1] = TDES1_TBS1(p_frame->size);
+		p_desc->TDES[0] = TDES0_OWN | TDES0_IC | TDES0_LS | TDES0_FS | tx_tdes0_mode(idx);
+		this->tx_kind[idx] = TX_KIND_TT;
+		this->tx_put_idx = (idx + 1) % TX_DISCRIPTOR_NUM;
+		this->tx_free_num--;
+		tx_kick(p_reg);
+		p_tt->r_idx = (p_tt->r_idx + 1) & (TT_QUEUE_NUM - 1);
+		
+		// 送信要求時刻のターゲット時刻からのオフセットを記録
+		ptp_get_time(p_reg, &now_sec, &now_nsec);
+		offset = ptp_diff_time(now_sec, now_nsec, p_tt->tgt_sec, p_tt->tgt_nsec);
+		if ((p_tt->stat.send_cnt == 0) || (offset < p_tt->stat.offset_min)) {
+			p_tt->stat.offset_min = offset;
+		}
+		if ((p_tt->stat.send_cnt == 0) || (offset > p_tt->stat.offset_max)) {
+			p_tt->stat.offset_max = offset;
+		}
+		p_tt->stat.offset_last = offset;
+		p_tt->offset_sum += offset;
+		p_tt->log[p_tt->log_idx] = offset;
+		p_tt->log_idx = (p_tt->log_idx + 1) & (TT_LOG_NUM - 1);
+		p_tt->stat.send_cnt++;
+	}
+	
+	// 次のターゲット時刻
+	ptp_add_time(&(p_tt->tgt_sec), &(p_tt->tgt_nsec), p_tt->period);
+	
+	// 割り込みが遅れて次のスロットを過ぎていたら飛ばす
+	ptp_get_time(p_reg, &now_sec, &now_nsec);
+	while (ptp_diff_time(now_sec, now_nsec, p_tt->tgt_sec, p_tt->tgt_nsec) >= 0) {
+		p_tt->stat.cycle_cnt++;
+		// 送信待ちフレームがあればスロットを逃した
+		if (p_tt->w_idx != p_tt->r_idx) {
+			p_tt->stat.miss_cnt++;
+		} else {
+			p_tt->stat.idle_cnt++;
+		}
+		ptp_add_time(&(p_tt->tgt_sec), &(p_tt->tgt_nsec), p_tt->period);
+	}
+	
+	// ターゲット時刻再設定
+	tt_set_target(p_reg, p_tt->tgt_sec, p_tt->tgt_nsec);
+}
+
+// 受信リングの使用数 (DMAが書き込み済みでソフトウェアが未読のディスクリプタ数)
+static uint32_t rx_count_used(void)
+{
+	ETH_CB *this = get_myself();
+	uint32_t idx = this->rx_idx;
+	uint32_t used = 0;
+	
+	while (used < RX_DISCRIPTOR_NUM) {
+		if ((rx_descriptor[idx].RDES[0] & RDES0_OWN) != 0) {
+			break;
+		}
+		used++;
+		idx = (idx + 1) % RX_DISCRIPTOR_NUM;
+	}
+	
+	return used;
+}
+
+// フロー制御レジスタ値
+static uint32_t fc_get_reg(ETH_FC_PAR *p_par, uint16_t pause_time)
+{
+	uint32_t macfcr;
+	
+	// PT   : PAUSEフレームで通知する停止時間[512bit time]
+	// TFCE : PAUSEフレーム送信有効
+	// RFCE : PAUSEフレーム受信で送信停止
+	macfcr = ((uint32_t)pause_time << ETH_MACFCR_PT_Pos);
+	if (p_par->tx_enable != 0) {
+		macfcr |= ETH_MACFCR_TFCE;
+	}
+	if (p_par->rx_enable != 0) {
+		macfcr |= ETH_MACFCR_RFCE;
+	}
+	
+	return macfcr;
+}
+
+// PAUSEフレーム送信 (pause_time=0で送信再開要求)
+static osStatus fc_send_pause(ETH_TypeDef *p_reg, uint16_t pause_time)
+{
+	ETH_CB *this = get_myself();
+	uint32_t macfcr;
+	
+	// 前回のPAUSEフレームを送信中
+	if ((p_reg->MACFCR & ETH_MACFCR_FCBBPA) != 0) {
+		return osErrorResource;
+	}
+	
+	// 停止時間を設定して送信
+	macfcr = fc_get_reg(&(this->fc.par), pause_time);
+	p_reg->MACFCR = macfcr;
+	p_reg->MACFCR = macfcr | ETH_MACFCR_FCBBPA;
+	
+	return osOK;
+}
+
+// 受信リング使用数によるフロー制御 (割り込み禁止で呼ぶこと)
+// rx_event : 新しいフレームを受信した (相手が送信している)
+static void fc_update(ETH_TypeDef *p_reg, uint32_t rx_event)
+{
+	ETH_CB *this = get_myself();
+	FC_CB *p_fc = &(this->fc);
+	uint32_t now_sec, now_nsec;
+	uint32_t used;
+	uint32_t time_us;
+	
+	// 受信待ちフレーム数 (受信リング + 優先度キュー)
+	used = rx_count_used() + this->rx.que_num;
+	if (used > p_fc->stat.ring_max) {
+		p_fc->stat.ring_max = used;
+	}
+	
+	// PAUSE送信しない
+	if (p_fc->par.tx_enable == 0) {
+		return;
+	}
+	
+	// 閾値を超えたら相手の送信を止める
+	// (*) 停止中にフレームが届いた場合は停止時間が切れているため再送する
+	if ((used >= p_fc->par.high_thresh) && ((p_fc->status == FC_ST_XON) || (rx_event != 0))) {
+		if (fc_send_pause(p_reg, p_fc->par.pause_time) == osOK) {
+			if (p_fc->status == FC_ST_XON) {
+				ptp_get_time(p_reg, &(p_fc->xoff_sec), &(p_fc->xoff_nsec));
+				p_fc->status = FC_ST_XOFF;
+			}
+			p_fc->stat.xoff_cnt++;
+		}
+		
+	// 閾値を下回ったら送信を再開させる
+	} else if ((used <= p_fc->par.low_thresh) && (p_fc->status == FC_ST_XOFF)) {
+		if (fc_send_pause(p_reg, 0) == osOK) {
+			p_fc->status = FC_ST_XON;
+			p_fc->stat.xon_cnt++;
+			// 停止させていた時間
+			ptp_get_time(p_reg, &now_sec, &now_nsec);
+			time_us = (now_sec - p_fc->xoff_sec) * 1000000 + (now_nsec / 1000) - (p_fc->xoff_nsec / 1000);
+			p_fc->stat.pause_us_total += time_us;
+			if (time_us > p_fc->stat.pause_us_max) {
+				p_fc->stat.pause_us_max = time_us;
+			}
+		}
+	} else {
+		;
+	}
+}
+
+// 受信したPAUSEフレームの統計
+static void fc_rx_pause(uint8_t *p_frame)
+{
+	ETH_CB *this = get_myself();
+	
+	this->fc.stat.rx_pause_cnt++;
+	this->fc.stat.rx_pause_quanta += ((uint32_t)p_frame[16] << 8) | p_frame[17];
+}
+
+// 受信フレームをPCPで優先度キューに振り分ける (割り込み禁止で呼ぶこと)
+// (*) 受信したパケットバッファをキューに登録し、ディスクリプタには新しいバッファを割り当てる (コピーしない)
+static void rx_classify(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	RX_CB *p_rx = &(this->rx);
+	RX_DESCRIPTOR *p_desc;
+	PKT_BUF *p_pkt;
+	PKT_BUF *p_new;
+	uint8_t *p_buf;
+	uint32_t rdes0;
+	uint32_t type;
+	uint32_t prio;
+	uint32_t returned = 0;
+	
+	while (1) {
+		// ディスクリプタ取得
+		p_desc = &rx_descriptor[this->rx_idx];
+		rdes0 = p_desc->RDES[0];
+		
+		// まだ受信していない
+		if ((rdes0 & RDES0_OWN) != 0) {
+			break;
+		}
+		
+		// エラーなしで1ディスクリプタに収まっているフレームのみ受け付ける
+		if ((rdes0 & (RDES0_ES | RDES0_FS | RDES0_LS)) == (RDES0_FS | RDES0_LS)) {
+			p_pkt = p_rx->desc_pkt[this->rx_idx];
+			p_pkt->len = RDES0_FL(rdes0);
+			// MACでIPヘッダ、ペイロードのチェックサムを検証済み (FT=1でエラーなし)
+			if ((rdes0 & (RDES0_FT | RDES0_IPHCE | RDES0_PCE)) == RDES0_FT) {
+				p_pkt->flags |= PKT_FLAG_CSUM_OK;
+			// チェックサムエラー
+			} else if (((rdes0 & RDES0_FT) != 0) && ((rdes0 & (RDES0_IPHCE | RDES0_PCE)) != 0)) {
+				p_pkt->flags |= PKT_FLAG_CSUM_ERR;
+			}
+			p_buf = p_pkt->p_data;
+			SCB_InvalidateDCache_by_Addr((uint32_t*)p_buf, p_pkt->len);
+			TRACE_EVT(TRACE_ETH_RX, p_pkt->len);
+			BOOT_MARK(BOOT_MARK_FIRST_RX);
+			type = ((uint32_t)p_buf[12] << 8) | p_buf[13];
+			
+			// PAUSEフレームは統計を取って破棄
+			if ((type == ETH_TYPE_MAC_CONTROL) && ((((uint32_t)p_buf[14] << 8) | p_buf[15]) == MAC_CONTROL_PAUSE)) {
+				fc_rx_pause(p_buf);
+				
+			// VIDが一致しないタグ付きフレームは破棄 (MACVLANTRのフィルタだけに頼らずディスクリプタのステータスでも確認する)
+			} else if ((p_rx->vlan.vid != 0) && ((rdes0 & RDES0_VLAN) != 0) &&
+			           (VLAN_VID(((uint16_t)p_buf[14] << 8) | p_buf[15]) != p_rx->vlan.vid)) {
+				p_rx->stat.vid_drop_cnt++;
+				
+			} else {
+				// 優先度決定 (タグなしはPCP=0扱い)
+				if (type == ETH_TYPE_VLAN) {
+					prio = p_rx->vlan.prio_map[p_buf[14] >> 5];
+				} else {
+					prio = p_rx->vlan.prio_map[0];
+				}
+				
+				// キューが一杯、入れ替えるバッファがない場合はリングに残す (フロー制御で相手を止める)
+				if ((p_rx->w_idx[prio] - p_rx->r_idx[prio]) >= RX_QUE_NUM) {
+					break;
+				}
+				if ((p_new = pkt_alloc()) == NULL) {
+					break;
+				}
+				
+				// 優先度キューに登録
+				p_rx->que[prio][p_rx->w_idx[prio] & RX_QUE_MASK] = p_pkt;
+				p_rx->w_idx[prio]++;
+				p_rx->que_num++;
+				p_rx->stat.rx_cnt[prio]++;
+				if (type == ETH_TYPE_VLAN) {
+					p_rx->stat.tagged_cnt++;
+				}
+				
+				// ディスクリプタには新しいバッファを割り当てる
+				p_rx->desc_pkt[this->rx_idx] = p_new;
+				p_desc->RDES[2] = (uint32_t)p_new->p_data;
+			}
+		}
+		
+		// ディスクリプタをDMAに返す
+		p_desc->RDES[0] = RDES0_OWN;
+		this->rx_idx = (this->rx_idx + 1) % RX_DISCRIPTOR_NUM;
+		returned++;
+	}
+	
+	// 受信再開
+	if (returned != 0) {
+		p_reg->DMARPDR = 0;
+	}
+}
 
 // 割り込みハンドラ
-void ETH_IRQHandler(void)
+// (*) HAL ETHドライバ選択時はdrv/eth_hal.cの割り込みハンドラを使う
+#ifndef ETH_IF_USE_HAL
+// 受信待ちタスクすべてに通知 (割り込みコンテキスト)
+static void rx_wakeup(void)
+{
+	ETH_CB *this = get_myself();
+	RX_WAITER *p_rx_waiter;
+	
+	for (p_rx_waiter = this->p_rx_waiter; p_rx_waiter != NULL; p_rx_waiter = p_rx_waiter->next) {
+		os_sig_set(&(p_rx_waiter->waiter), EVT_RECV_SUCCESS);
+	}
+}
+
+static void eth_irq_handler(void)
 {
 	ETH_CB *this = get_myself();
 	ETH_TypeDef *p_reg;
@@ -288,29 +961,64 @@ void ETH_IRQHandler(void)
 	dmasr = p_reg->DMASR;
 	dmaier = p_reg->DMAIER;
 	
+	// ステータスクリア (W1C)
+	p_reg->DMASR = dmasr;
+	
+	// ターゲット時刻到達 (PTPTSSRの読み出しでクリア)
+	if ((macsr & ETH_MACSR_TSTS) != 0) {
+		if ((p_reg->PTPTSSR & ETH_PTPTSSR_TSTTR) != 0) {
+			tt_handler(p_reg);
+		}
+	}
+	
 	// エラー確認
 	if ((dmasr & ETH_DMASR_EBS) != 0) {
-		// イベント送信
-		osSignalSet(this->thread_id, EVT_SEND_FAIL);
+		// 送信中のフレームをすべて失敗で回収して送信リングをリセット
+		// (送信完了を待っている要求に失敗を通知、TSOの要求はセグメント数を減らす)
+		tx_abort(p_reg);
 		return;
 	}
 	
+	// 送信アンダーフロー (送信DMAはサスペンドするのでポーリング要求で再開)
+	if ((dmasr & ETH_DMASR_TUS) != 0) {
+		this->dma_stat.tx_underflow_cnt++;
+		p_reg->DMATPDR = 0;
+	}
+	
+	// 受信オーバーフロー
+	if ((dmasr & ETH_DMASR_ROS) != 0) {
+		this->dma_stat.rx_overflow_cnt++;
+	}
+	
+	// 受信リングが一杯
+	if ((dmasr & ETH_DMASR_RBUS) != 0) {
+		this->fc.stat.ring_full_cnt++;
+	}
+	
 	// 受信完了
 	if (((dmaier & ETH_DMAIER_RIE) != 0) && ((dmasr & ETH_DMASR_RS) != 0)) {
-		// イベント送信
-		osSignalSet(this->thread_id, EVT_RECV_SUCCESS);
-		
+		// 優先度キューに振り分け
+		rx_classify(p_reg);
+		// フロー制御
+		fc_update(p_reg, 1);
+		// 受信待ちタスクに通知
+		rx_wakeup();
+	}
+	
 	// 送信完了
-	} else if (((dmaier & ETH_DMAIER_TIE) != 0) && ((dmasr & ETH_DMASR_TS) != 0)) {
-		// イベント送信
-		osSignalSet(this->thread_id, EVT_SEND_SUCCESS);
-		
-	// その他
-	} else {
-		;
-		
+	if (((dmaier & ETH_DMAIER_TIE) != 0) && ((dmasr & ETH_DMASR_TS) != 0)) {
+		tx_reclaim();
 	}
 }
+void ETH_IRQHandler(void)
+{
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_ETH);
+	
+	eth_irq_handler();
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_ETH);
+}
+#endif
 
 /**
   * @brief This function handles Ethernet wake-up interrupt through EXTI line 19.
@@ -323,84 +1031,272 @@ void ETH_WKUP_IRQHandler(void)
 // DMAリセット
 static void dma_reset(ETH_TypeDef *p_reg)
 {
-	uint32_t timeout = 1000;
+	uint32_t start;
 	
 	p_reg->MACCR &= ~(ETH_MACCR_TE | ETH_MACCR_RE);
 	p_reg->DMAOMR &= ~(ETH_DMAOMR_ST | ETH_DMAOMR_SR);
 	p_reg->DMABMR |= ETH_DMABMR_SR;
+	start = hrt_get_us();
 	while ((p_reg->DMABMR & ETH_DMABMR_SR) != 0) {
-		if (--timeout == 0) {
+		if (hrt_elapsed_us(start) > DMA_RESET_TMOUT_US) {
 			break;  // SR が読めない errata 対策
 		}
 	}
 }
 
-// レジスタ設定
-static void eth_config(ETH_TypeDef *p_reg)
+// ハッシュフィルタのビット番号計算
+// CRC32(IEEE802.3)をビット反転した上位6ビットを使用する
+static uint32_t filter_hash(const uint8_t *p_addr)
 {
-	uint32_t loopback_setting;
-	volatile uint32_t tmp_reg;
+	uint32_t crc = 0xFFFFFFFF;
+	uint8_t i, j;
 	
-	// クロック有効
-	__HAL_RCC_SYSCFG_CLK_ENABLE();
+	for (i = 0; i < 6; i++) {
+		crc ^= p_addr[i];
+		for (j = 0; j < 8; j++) {
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+		}
+	}
 	
-	  /* Select MII or RMII Mode*/
-	SYSCFG->PMC &= ~(SYSCFG_PMC_MII_RMII_SEL);
-	SYSCFG->PMC |= (uint32_t)HAL_ETH_RMII_MODE;	
+	return (__RBIT(~crc) >> 26);
+}
+
+// アドレスフィルタのレジスタ反映
+static void filter_apply(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	FILTER_CB *p_filter = &(this->filter);
+	FILTER_ENTRY *p_entry;
+	uint32_t hash[2] = {0, 0};
+	uint32_t macffr = 0;
+	uint8_t i;
 	
-	// DMAリセット
-	dma_reset(p_reg);
+	// 完全一致フィルタ (未使用のスロットは無効化)
+	for (i = 0; i < FILTER_PERFECT_NUM; i++) {
+		*get_perfect_hr(p_reg, i) = 0;
+		*get_perfect_lr(p_reg, i) = 0;
+	}
+	for (i = 0; i < FILTER_ADDR_NUM; i++) {
+		p_entry = &(p_filter->entry[i]);
+		if ((p_entry->ref == 0) || (p_entry->slot == ETH_FILTER_SLOT_HASH)) {
+			continue;
+		}
+		*get_perfect_lr(p_reg, p_entry->slot) = (((uint32_t)p_entry->addr[3] << 24) | ((uint32_t)p_entry->addr[2] << 16) |
+		                                          ((uint32_t)p_entry->addr[1] << 8) | ((uint32_t)p_entry->addr[0] << 0));
+		*get_perfect_hr(p_reg, p_entry->slot) = (ETH_MACA1HR_AE | ((uint32_t)p_entry->addr[5] << 8) | ((uint32_t)p_entry->addr[4] << 0));
+	}
 	
-	// 送信ディスクリプタのアドレスを設定
-	p_reg->DMATDLAR = (uint32_t)&(tx_descriptor[0]);
+	// ハッシュテーブル
+	for (i = 0; i < FILTER_HASH_BITS; i++) {
+		if (p_filter->hash_ref[i] != 0) {
+			hash[i >> 5] |= (1UL << (i & 0x1F));
+		}
+	}
+	p_reg->MACHTLR = hash[0];
+	p_reg->MACHTHR = hash[1];
+	
+	// フィルタ設定
+	// HPF(1) : ハッシュを使う場合も完全一致フィルタに一致したフレームは受信
+	// HM(1)  : マルチキャストはハッシュフィルタ
+	// HU(1)  : ユニキャストはハッシュフィルタ
+	if (p_filter->hash_mc_num != 0) {
+		macffr |= ETH_MACFFR_HM | ETH_MACFFR_HPF;
+	}
+	if (p_filter->hash_uc_num != 0) {
+		macffr |= ETH_MACFFR_HU | ETH_MACFFR_HPF;
+	}
+	// PCF(10) : PAUSEに従う場合は統計を取るため制御フレームも受信する
+	if (this->fc.par.rx_enable != 0) {
+		macffr |= ETH_MACFFR_PCF_ForwardAll;
+	}
+	p_reg->MACFFR = macffr;
+}
+
+// PTPのレジスタ更新完了待ち (bitが0になるまで)
+static osStatus ptp_wait_clear(ETH_TypeDef *p_reg, uint32_t bit)
+{
+	uint32_t start;
 	
-	// DMA設定
-	// Tx FIFO : 256 bytes
-	// Rx FIFO : 128 bytes
-	// バースト長は16word(16*4=64byte)
-	p_reg->DMABMR |= (ETH_DMABMR_FB | ETH_DMABMR_AAB | ETH_DMABMR_PBL_16Beat);
-	tmp_reg = p_reg->DMABMR;
-	// ディレイ
-	osDelay(1);
+	start = hrt_get_us();
+	while ((p_reg->PTPTSCR & bit) != 0) {
+		if (hrt_elapsed_us(start) > PTP_UPDATE_TMOUT_US) {
+			return osErrorTimeoutResource;
+		}
+	}
 	
-	// ループバック設定
-#ifdef LOOPBACK_TEST_ENABLE
-	// ROD(1)  : Receive own 有効 → 
-	loopback_setting = ETH_MACCR_ROD | ETH_MACCR_LM;
-#endif
+	return osOK;
+}
+
+// PTPタイムスタンプ設定
+static osStatus ptp_config(ETH_TypeDef *p_reg)
+{
+	uint32_t hclk;
+	osStatus ercd;
 	
-	// レジスタ設定
-	// CSTF(1) : CRC stripping有効 → FCSを削除してバッファに格納
-	// WD(0)   : ウォッチドッグ有効 → 2048byte以降は切り捨てる
-	// JD(0)   : Jabber 有効 → 2048byte以上送信しようとすると
-	// IPCO(1) : - IPヘッダー、TCP/UDPチェックサムを自動検証
-	// APCS(1) : - パディング領域とFCSを自動的に除去
-	p_reg->MACCR = ETH_MACCR_CSTF | ETH_MACCR_IPCO | ETH_MACCR_APCS;
+	// ターゲット時刻割り込みはタイムトリガ送信開始までマスク
+	p_reg->MACIMR |= ETH_MACIMR_TSTIM;
 	
-	// フィルタレジスタ設定
-	// HPF(0)  : MACアドレスレジスタと完全一致する場合のみ受信※1の場合は、ハッシュ
-	// SAF(0)  : 送信元MACアドレスはチェックされず、通常の受信処理
-	// SAIF(0) : 通常のSAF動作（送信元MACが一致すれば受信）
-	// PCF(0)  : 制御フレームを破棄
-	// BFD(0)  : ブロードキャストフレームを受信
-	// PAM(0)  : マルチキャストアドレスは ハッシュテーブルや完全一致フィルタで選別される
-	// DAIF(0) : 宛先MACアドレスが MACA1HR/MACA1LR に一致すれば受信
-	// HM(0)   : マルチキャストアドレスはハッシュフィルタされない
-	// HU(0)   : ユニキャストアドレスは完全一致（Perfect Filter）でのみ受信
-	// PM(0)   : - MACアドレスフィルタが有効。自分宛のフレームのみ受信
- 	p_reg->MACFFR = 0;
+	// タイムスタンプ機能は有効
+	//  TSPFFMAE(1)  : 受信フレームの宛先MACアドレスが一致する場合にタイムスタンプを生成
+	//  TSSMRME(1)   : マスター宛のメッセージに対してのみ受信時にタイムスタンプスナップショットを取得する
+	//  TSSEME(1)    : PTPイベントメッセージ（Sync, Delay_Req など）に対してのみ、タイムスタンプスナップショットを取得する
+	//  TSSIPV4FE(1) : IPv4パケットに対してのみタイムスタンプスナップショットを取得
+	//  TSSSR(1)     : サブ秒はナノ秒単位 (999,999,999で繰り上がり)
+	p_reg->PTPTSCR |= (ETH_PTPTSCR_TSPFFMAE | ETH_PTPTSCR_TSSMRME | ETH_PTPTSCR_TSSEME | ETH_PTPTSCR_TSSIPV4FE | ETH_PTPTSCR_TSSSR | ETH_PTPTSCR_TSE);
+	
+	// サブ秒インクリメント
+	p_reg->PTPSSIR = PTP_SUBSEC_INC;
+	
+	// ファイン補正 : HCLKから PTP_CLOCK_HZ の更新を生成する
+	// addend = 2^32 * PTP_CLOCK_HZ / HCLK
+	hclk = HAL_RCC_GetHCLKFreq();
+	p_reg->PTPTSAR = (uint32_t)(((uint64_t)PTP_CLOCK_HZ << 32) / hclk);
+	p_reg->PTPTSCR |= ETH_PTPTSCR_TSARU;
+	if ((ercd = ptp_wait_clear(p_reg, ETH_PTPTSCR_TSARU)) != osOK) {
+		return ercd;
+	}
+	p_reg->PTPTSCR |= ETH_PTPTSCR_TSFCU;
+	
+	// システム時刻を0で初期化
+	p_reg->PTPTSHUR = 0;
+	p_reg->PTPTSLUR = 0;
+	p_reg->PTPTSCR |= ETH_PTPTSCR_TSSTI;
+	
+	return ptp_wait_clear(p_reg, ETH_PTPTSCR_TSSTI);
+}
+
+// DMA設定チェックとDMAOMR/DMABMRレジスタ値
+static osStatus dma_get_reg(ETH_DMA_PAR *p_dma, uint32_t *p_omr, uint32_t *p_bmr)
+{
+	uint32_t pbl;
+	uint32_t ttc;
+	uint32_t rtc;
+	
+	// スレッショルド (0はデフォルトの64byte)
+	for (ttc = 0; ttc < sizeof(dma_ttc_tbl)/sizeof(dma_ttc_tbl[0]); ttc++) {
+		if ((p_dma->tx_thresh == 0) || (p_dma->tx_thresh == dma_ttc_tbl[ttc])) {
+			break;
+		}
+	}
+	for (rtc = 0; rtc < sizeof(dma_rtc_tbl)/sizeof(dma_rtc_tbl[0]); rtc++) {
+		if ((p_dma->rx_thresh == 0) || (p_dma->rx_thresh == dma_rtc_tbl[rtc])) {
+			break;
+		}
+	}
+	if ((ttc >= sizeof(dma_ttc_tbl)/sizeof(dma_ttc_tbl[0])) || (rtc >= sizeof(dma_rtc_tbl)/sizeof(dma_rtc_tbl[0]))) {
+		return osErrorParameter;
+	}
+	
+	// バースト長 (1,2,4,8,16,32、0はデフォルト)
+	pbl = p_dma->pbl;
+	if (pbl == 0) {
+		pbl = DMA_PBL_DEFAULT;
+	}
+	if ((pbl > 32) || ((pbl & (pbl - 1)) != 0)) {
+		return osErrorParameter;
+	}
+	
+	// TSF : 送信ストアアンドフォワード (0の場合はTTCのスレッショルドで送信開始)
+	// RSF : 受信ストアアンドフォワード (0の場合はRTCのスレッショルドでDMA転送開始)
+	// OSF : 前のフレームのステータスを待たずに次のフレームを読み出す
+	*p_omr = (ttc << ETH_DMAOMR_TTC_Pos) | (rtc << ETH_DMAOMR_RTC_Pos);
+	if (p_dma->tx_sf != 0) {
+		*p_omr |= ETH_DMAOMR_TSF;
+	}
+	if (p_dma->rx_sf != 0) {
+		*p_omr |= ETH_DMAOMR_RSF;
+	}
+	if (p_dma->osf != 0) {
+		*p_omr |= ETH_DMAOMR_OSF;
+	}
+	
+	// FB  : 固定バースト
+	// AAB : アドレスアラインドビート
+	// DSL : リングモードのディスクリプタ間の空き[word]
+	*p_bmr = ETH_DMABMR_FB | ETH_DMABMR_AAB | (pbl << ETH_DMABMR_PBL_Pos) | (TX_DESC_SKIP_WORD << ETH_DMABMR_DSL_Pos);
+	
+	return osOK;
+}
+
+// VLANタグレジスタ値
+static uint32_t vlan_get_reg(ETH_VLAN_PAR *p_vlan)
+{
+	if (p_vlan->vid == 0) {
+		return 0;
+	}
+	
+	return ETH_MACVLANTR_VLANTC | VLAN_VID(p_vlan->vid);
+}
+
+// レジスタ設定
+static osStatus eth_config(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	uint32_t dmaomr;
+	uint32_t dmabmr;
+	volatile uint32_t tmp_reg;
+	osStatus ercd;
+	
+	// クロック有効
+	__HAL_RCC_SYSCFG_CLK_ENABLE();
+	
+	  /* Select MII or RMII Mode*/
+	SYSCFG->PMC &= ~(SYSCFG_PMC_MII_RMII_SEL);
+	SYSCFG->PMC |= (uint32_t)HAL_ETH_RMII_MODE;	
+	
+	// DMAリセット
+	dma_reset(p_reg);
+	
+	// 送受信ディスクリプタのアドレスを設定
+	p_reg->DMATDLAR = (uint32_t)&(tx_descriptor[0]);
+	p_reg->DMARDLAR = (uint32_t)&(rx_descriptor[0]);
+	
+	// DMA設定
+	// オープンパラメータのDMA設定 (eth_open()でチェック済み、デフォルトはスレッショルドモード、バースト長は16word(16*4=64byte))
+	dma_get_reg(&(this->open_par.dma), &dmaomr, &dmabmr);
+	p_reg->DMABMR = dmabmr;
+	tmp_reg = p_reg->DMABMR;
+	p_reg->DMAOMR = dmaomr;
+	// ディレイ (スケジューラ開始前でも呼べるようにビジーウェイト)
+	hrt_delay_us(REG_WRITE_DELAY_US);
+	
+	// レジスタ設定
+	// CSTF(1) : CRC stripping有効 → FCSを削除してバッファに格納
+	// WD(0)   : ウォッチドッグ有効 → 2048byte以降は切り捨てる
+	// JD(0)   : Jabber 有効 → 2048byte以上送信しようとすると
+	// IPCO(1) : - IPヘッダー、TCP/UDPチェックサムを自動検証
+	// APCS(1) : - パディング領域とFCSを自動的に除去
+	p_reg->MACCR = ETH_MACCR_CSTF | ETH_MACCR_IPCO | ETH_MACCR_APCS;
+	
+	// LM(1)   : MACループバック (eth_loopback_config()で設定)
+	if (this->loopback == ETH_LOOPBACK_MAC) {
+		p_reg->MACCR |= ETH_MACCR_LM;
+	}
 	
-	// ハッシュフィルタは使用しない
-	p_reg->MACHTHR = 0;
-	p_reg->MACHTLR = 0;
+	// フィルタレジスタ設定 (eth_filter_add()で登録したアドレスは filter_apply() で反映)
+	// HPF(0)  : MACアドレスレジスタと完全一致する場合のみ受信※1の場合は、ハッシュ
+	// SAF(0)  : 送信元MACアドレスはチェックされず、通常の受信処理
+	// SAIF(0) : 通常のSAF動作（送信元MACが一致すれば受信）
+	// PCF(0)  : 制御フレームを破棄
+	// BFD(0)  : ブロードキャストフレームを受信
+	// PAM(0)  : マルチキャストアドレスは ハッシュテーブルや完全一致フィルタで選別される
+	// DAIF(0) : 宛先MACアドレスが MACA1HR/MACA1LR に一致すれば受信
+	// HM(0)   : マルチキャストアドレスはハッシュフィルタされない
+	// HU(0)   : ユニキャストアドレスは完全一致（Perfect Filter）でのみ受信
+	// PM(0)   : - MACアドレスフィルタが有効。自分宛のフレームのみ受信
+	// MACA1～3、ハッシュテーブルも登録アドレスから設定
+	osMutexWait(this->filter.mutex, osWaitForever);
+	filter_apply(p_reg);
+	osMutexRelease(this->filter.mutex);
 	
 	// フロー制御
-	// いったんデフォルト設定
-	p_reg->MACFCR = 0;
+	// eth_fc_config()で設定 (デフォルトは無効)
+	p_reg->MACFCR = fc_get_reg(&(this->fc.par), this->fc.par.pause_time);
 	
 	// VLAN設定
-	// VLANはいったん使わない
-	p_reg->MACVLANTR = 0;
+	// VLANTC(1) : VIDの12bitで比較
+	// VLANTI    : 受信するVID (0はフィルタしない)
+	p_reg->MACVLANTR = vlan_get_reg(&(this->rx.vlan));
 	
 	// ウェイクアップ設定
 	// ウェイクアップはいったん使わない
@@ -412,8 +1308,6 @@ static void eth_config(ETH_TypeDef *p_reg)
 	p_reg->MACA0LR = (((uint32_t)mac_address[3] << 24) | ((uint32_t)mac_address[2] << 16) | 
 	                   ((uint32_t)mac_address[1] << 8) | ((uint32_t)mac_address[0] << 0));
 	
-	// MACA1~3LR、MACA1~3HRはいったん使用しない
-	
 #ifdef MMC_ENABLE
 	// カウンタリセット
 	p_reg->MMCCR |= ETH_MMCCR_CR;
@@ -424,43 +1318,88 @@ static void eth_config(ETH_TypeDef *p_reg)
 	
 #endif
 	
-	// タイムスタンプ機能は有効
-	//  TSPFFMAE(1)  : 受信フレームの宛先MACアドレスが一致する場合にタイムスタンプを生成
-	//  TSSMRME(1)   : マスター宛のメッセージに対してのみ受信時にタイムスタンプスナップショットを取得する
-	//  TSSEME(1)    : PTPイベントメッセージ（Sync, Delay_Req など）に対してのみ、タイムスタンプスナップショットを取得する
-	//  TSSIPV4FE(1) : IPv4パケットに対してのみタイムスタンプスナップショットを取得
-	p_reg->PTPTSCR |= (ETH_PTPTSCR_TSPFFMAE | ETH_PTPTSCR_TSSMRME | ETH_PTPTSCR_TSSEME | ETH_PTPTSCR_TSSIPV4FE | ETH_PTPTSCR_TSE);
+	// タイムスタンプ設定 (PTPのクロックが来ていない場合は送受信を有効にしない)
+	if ((ercd = ptp_config(p_reg)) != osOK) {
+		return ercd;
+	}
 	
 	// 割り込み設定
-	p_reg->DMAIER |= (ETH_DMAIER_NISE | ETH_DMAIER_AISE | ETH_DMAIER_RIE | ETH_DMAIER_TIE);
+	// RBUIE : 受信リングが一杯になったことを検出する
+	// TUIE  : 送信アンダーフロー (カットスルーのスレッショルド調整用)
+	// ROIE  : 受信オーバーフロー
+	p_reg->DMAIER |= (ETH_DMAIER_NISE | ETH_DMAIER_AISE | ETH_DMAIER_RIE | ETH_DMAIER_TIE | ETH_DMAIER_RBUIE |
+	                  ETH_DMAIER_TUIE | ETH_DMAIER_ROIE);
+	
+	// DM(1)   : 全二重 (PAUSEフレームは全二重のみ)
+	// FES(1)  : 100Mbps
+	// オートネゴシエーションが済んでいればその結果、まだならオープンパラメータの通信方式 (10Mbps)
+	// (*) eth_phy_init()は送受信有効ならMACCRに反映するので、判定から送受信有効までは割り込み禁止
+	__disable_irq();
+	if (this->link_up != 0) {
+		p_reg->MACCR |= this->link_maccr;
+	} else if (this->open_par.mode == COM_MODE_FULL_DUPLEX) {
+		p_reg->MACCR |= ETH_MACCR_DM;
+	}
 	
 	// 送受信有効
 	p_reg->MACCR |= (ETH_MACCR_TE | ETH_MACCR_RE);
+	__enable_irq();
 	
+	return osOK;
 }
 
 // ディスクリプタ設定
-static void desc_config(void)
+static osStatus desc_config(void)
 {
+	ETH_CB *this = get_myself();
 	TX_DESCRIPTOR *p_cur_desc;
 	TX_DESCRIPTOR *p_nxt_desc;
+	RX_DESCRIPTOR *p_rx_desc;
 	uint8_t i;
 	
-	// ディスクリプタ設定
-	for (i = 0; i < (TX_DISCRIPTOR_NUM - 1); i++) {
+	// 受信ディスクリプタ設定 (全てDMA所有でパケットバッファを割り当てる)
+	for (i = 0; i < RX_DISCRIPTOR_NUM; i++) {
+		p_rx_desc = &rx_descriptor[i];
+		if (this->rx.desc_pkt[i] == NULL) {
+			if ((this->rx.desc_pkt[i] = pkt_alloc()) == NULL) {
+				return osErrorNoMemory;
+			}
+		}
+		p_rx_desc->RDES[1] = RDES1_RCH | RDES1_RBS1(RX_BUFF_SIZE);
+		p_rx_desc->RDES[2] = (uint32_t)this->rx.desc_pkt[i]->p_data;
+		p_rx_desc->RDES[3] = (uint32_t)&rx_descriptor[(i + 1) % RX_DISCRIPTOR_NUM];
+		p_rx_desc->RDES[0] = RDES0_OWN;
+	}
+	
+	// 優先度キューは空
+	memset(this->rx.w_idx, 0, sizeof(this->rx.w_idx));
+	memset(this->rx.r_idx, 0, sizeof(this->rx.r_idx));
+	this->rx.que_num = 0;
+	
+	// ディスクリプタ設定 (最後のディスクリプタは先頭に戻す)
+	for (i = 0; i < TX_DISCRIPTOR_NUM; i++) {
 		// ディスクリプタ取得
 		p_cur_desc = &tx_descriptor[i];
-		p_nxt_desc = &tx_descriptor[i + 1];
+		p_nxt_desc = &tx_descriptor[(i + 1) % TX_DISCRIPTOR_NUM];
+#ifdef TX_RING_MODE_ENABLE
+		// リングモードはTERで先頭に戻る
+		p_cur_desc->TDES[0] = tx_tdes0_mode(i);
+		p_cur_desc->TDES[3] = 0;
+		(void)p_nxt_desc;
+#else
 		// 次のディスクリプタのアドレスを取得
 		p_cur_desc->TDES[3] = (uint32_t)p_nxt_desc;
+#endif
 	}
+	
+	return osOK;
 }
 
 // PHYレジスタ読み出し
 static osStatus phy_read(ETH_TypeDef *p_reg, uint8_t phy_reg, uint16_t *data)
 {
 	osStatus ercd = osErrorTimeoutResource;
-	uint8_t timeout = 10;
+	uint32_t start;
 	
 	// PHYアドレスとリードしたいレジスタのインデックスを設定
 	p_reg->MACMIIAR = MACMIIAR_PA(PHY_ADDRESS) | MACMIIAR_MR(phy_reg);
@@ -472,12 +1411,13 @@ static osStatus phy_read(ETH_TypeDef *p_reg, uint8_t phy_reg, uint16_t *data)
 	p_reg->MACMIIAR |= ETH_MACMIIAR_MB;
 	
 	// 読み出しが終わるまで待つ
-	while (timeout--) {
+	start = hrt_get_us();
+	do {
 		if ((p_reg->MACMIIAR & ETH_MACMIIAR_MB) == 0) {
 			ercd = osOK;
 			break;
 		}
-	}
+	} while (hrt_elapsed_us(start) <= PHY_MDIO_TMOUT_US);
 	
 	// 読み出し
 	*data = p_reg->MACMIIDR;
@@ -489,7 +1429,7 @@ static osStatus phy_read(ETH_TypeDef *p_reg, uint8_t phy_reg, uint16_t *data)
 static osStatus phy_write(ETH_TypeDef *p_reg, uint8_t phy_reg, uint16_t data)
 {
 	osStatus ercd = osErrorTimeoutResource;
-	uint8_t timeout = 10;
+	uint32_t start;
 	
 	// 書き込み
 	p_reg->MACMIIDR = data;
@@ -498,12 +1438,13 @@ static osStatus phy_write(ETH_TypeDef *p_reg, uint8_t phy_reg, uint16_t data)
 	p_reg->MACMIIAR = MACMIIAR_PA(PHY_ADDRESS) | MACMIIAR_MR(phy_reg) | ETH_MACMIIAR_MW | ETH_MACMIIAR_MB;
 	
 	// 書き込みが終わるまで待つ
-	while (timeout--) {
+	start = hrt_get_us();
+	do {
 		if ((p_reg->MACMIIAR & ETH_MACMIIAR_MB) == 0) {
 			ercd = osOK;
 			break;
 		}
-	}
+	} while (hrt_elapsed_us(start) <= PHY_MDIO_TMOUT_US);
 	
 	return ercd;
 }
@@ -615,40 +1556,26 @@ EXIT:
 }
 
 // 送信完了待ち
-static osStatus send_wait(ETH_TypeDef *p_reg)
+static osStatus send_wait(OS_SIG_WAITER *p_waiter)
 {
-	TX_DESCRIPTOR *p_desc;
-	osEvent event;
-	osStatus ercd;
-	
-	// 先頭ディスクリプタのOWNビットをセット
-	p_desc = &(tx_descriptor[0]);
-	p_desc->TDES[0] |= TDES0_OWN;
-	
-	// 送信開始
-	p_reg->DMAOMR |= ETH_DMAOMR_ST;
+	uint32_t bits;
+	osStatus ercd = osOK;
 	
 	// 送信完了まち
-	event = osSignalWait((EVT_SEND_SUCCESS|EVT_SEND_FAIL), osWaitForever);
-	// OSエラー発生
-	if (event.status != osEventSignal) {
-		ercd = event.status;
-		
-	// 送信成功
-	} else if (event.value.signals == EVT_SEND_SUCCESS) {
-		ercd = osOK;
-		
+	TRACE_EVT(TRACE_ETH_WAIT_START, 0);
+	bits = os_sig_wait(p_waiter, (EVT_SEND_SUCCESS|EVT_SEND_FAIL), -1);
+	TRACE_EVT(TRACE_ETH_WAIT_END, bits);
+	
 	// 送信失敗
-	} else if (event.value.signals == EVT_SEND_FAIL) {
+	if ((bits & EVT_SEND_FAIL) != 0) {
 		ercd = osErrorISR;	// 良いエラーコードがない...
-		
 	}
 	
 	return ercd;
 }
 
 // 初期化
-void eth_init(void)
+osStatus eth_init(void)
 {
 	ETH_CB *this = get_myself();
 	
@@ -657,14 +1584,116 @@ void eth_init(void)
 	
 	// ディスクリプタクリア
 	memset(&tx_descriptor[0], 0, sizeof(TX_DESCRIPTOR)*TX_DISCRIPTOR_NUM);
+	memset(&rx_descriptor[0], 0, sizeof(RX_DESCRIPTOR)*RX_DISCRIPTOR_NUM);
+	
+	// アドレスフィルタの排他
+	MEM_PLAN_MUTEX(eth, eth_filter);
+	this->filter.mutex = osMutexCreate(osMutex(eth_filter));
 	
-	// メールキュー作成 (*) 64*1024byteのメモリを確保
-	osMailQDef(ConsoleSendBuf, BUFF_SISE_K, 1024);
-	this->mail_handle = osMailCreate(osMailQ(ConsoleSendBuf), NULL);
+	// MDIOの排他
+	MEM_PLAN_MUTEX(eth, eth_mdio);
+	this->mdio_mutex = osMutexCreate(osMutex(eth_mdio));
 	
 	// 状態更新
 	this->status = ST_CLOSE;
+	this->tt.status = TT_ST_STOP;
+	memcpy(this->rx.vlan.prio_map, vlan_prio_map_default, sizeof(this->rx.vlan.prio_map));
+#ifdef LOOPBACK_TEST_ENABLE
+	this->loopback = ETH_LOOPBACK_MAC;
+#endif
+	
+	return osOK;
+}
+
+// MDIOの排他開始 (PHYレジスタの一連のアクセスをまとめて排他する、タスクコンテキストのみ)
+static void mdio_lock(void)
+{
+	ETH_CB *this = get_myself();
+	
+	osMutexWait(this->mdio_mutex, osWaitForever);
+}
+
+// MDIOの排他終了
+static void mdio_unlock(void)
+{
+	ETH_CB *this = get_myself();
+	
+	osMutexRelease(this->mdio_mutex);
+}
+
+// PHY初期化 (オートネゴシエーションをやり直してリンクアップまで待つ)
+// MDIOしか使わないので、eth_open()と関係なく起動時にバックグラウンドで実行できる
+// リンクアップしたら決まった速度と全二重をMACCR(FES、DM)に反映する (オープン前ならeth_open()で反映)
+osStatus eth_phy_init(void)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg = ch_info_tbl.p_reg;
+	uint16_t bcr, bsr, scsr;
+	uint32_t maccr;
+	uint32_t start;
+	osStatus ercd;
+	
+	// オートネゴシエーション再開
+	mdio_lock();
+	if ((ercd = phy_read(p_reg, PHY_REG_BASIC_CONTROL, &bcr)) == osOK) {
+		bcr |= (BASIC_CONTROL_AUTO_NEGOTIATE_ENABLE | BASIC_CONTROL_RESTART_AUTO_NEGOTIATE);
+		ercd = phy_write(p_reg, PHY_REG_BASIC_CONTROL, bcr);
+	}
+	mdio_unlock();
+	if (ercd != osOK) {
+		return ercd;
+	}
+	
+	// 完了とリンクアップ待ち (待っている間はMDIOを離す)
+	start = osKernelSysTick();
+	while (1) {
+		osDelay(PHY_AUTONEG_POLL);
+		mdio_lock();
+		ercd = phy_read(p_reg, PHY_REG_BASIC_STATUS, &bsr);
+		mdio_unlock();
+		if (ercd != osOK) {
+			return ercd;
+		}
+		if ((bsr & (BASIC_STAUS_AUTO_NEGOTIATE_COMPLETE | BASIC_STAUS_LINK_STATUS)) ==
+		    (BASIC_STAUS_AUTO_NEGOTIATE_COMPLETE | BASIC_STAUS_LINK_STATUS)) {
+			break;
+		}
+		if ((osKernelSysTick() - start) >= PHY_AUTONEG_TMOUT) {
+			return osErrorTimeoutResource;
+		}
+	}
+	
+	// 決まった速度と全二重
+	mdio_lock();
+	ercd = phy_read(p_reg, PHY_REG_PHY_SPECIAL_CONTROL_STATUS, &scsr);
+	if (ercd == osOK) {
+		maccr = 0;
+		if ((scsr & PHY_SPECIAL_CONTROL_STATUS_100MBPS) != 0) {
+			maccr |= ETH_MACCR_FES;
+		}
+		if ((scsr & PHY_SPECIAL_CONTROL_STATUS_FULL_DUPLEX) != 0) {
+			maccr |= ETH_MACCR_DM;
+		}
+		
+		// MACに反映 (送受信有効ならすぐ、PHYループバック中は抜けたときに戻す値として保存)
+		__disable_irq();
+		this->link_maccr = maccr;
+		this->link_up = 1;
+		if (this->loopback == ETH_LOOPBACK_PHY) {
+			this->loopback_maccr = maccr;
+		} else if ((p_reg->MACCR & ETH_MACCR_TE) != 0) {
+			p_reg->MACCR = (p_reg->MACCR & ~(ETH_MACCR_FES | ETH_MACCR_DM)) | maccr;
+		}
+		__enable_irq();
+	}
+	mdio_unlock();
+	if (ercd != osOK) {
+		return ercd;
+	}
+	
+	BOOT_MARK(BOOT_MARK_LINK_UP);
 	
+	return osOK;
 }
 
 // オープン
@@ -672,12 +1701,17 @@ osStatus eth_open(ETH_OPEN *p_par)
 {
 	ETH_CB *this = get_myself();
 	ETH_TypeDef *p_reg;
-	uint32_t loopback_setting = 0;
+	uint32_t dmaomr;
+	uint32_t dmabmr;
+	osStatus ercd;
 	
 	// パラメータチェック
 	if (p_par == NULL) {
 		return osErrorParameter;
 	}
+	if (dma_get_reg(&(p_par->dma), &dmaomr, &dmabmr) != osOK) {
+		return osErrorParameter;
+	}
 	
 	// 初期化していない場合はエラー
 	if (this->status != ST_CLOSE) {
@@ -687,11 +1721,26 @@ osStatus eth_open(ETH_OPEN *p_par)
 	// レジスタのベースアドレスを取得
 	p_reg = ch_info_tbl.p_reg;
 	
+	// オープンパラメータ保存
+	this->open_par = *p_par;
+	
 	// レジスタ設定
-	eth_config(p_reg);
+	if ((ercd = eth_config(p_reg)) != osOK) {
+		return ercd;
+	}
 	
-	// ディスクリプタ設定
-	desc_config();
+	// ディスクリプタ設定 (受信バッファはパケットバッファから確保)
+	if ((ercd = desc_config()) != osOK) {
+		return ercd;
+	}
+	this->tx_put_idx = 0;
+	this->tx_clean_idx = 0;
+	this->tx_free_num = TX_DISCRIPTOR_NUM;
+	this->rx_idx = 0;
+	this->fc.status = FC_ST_XON;
+	
+	// 受信DMA開始
+	p_reg->DMAOMR |= ETH_DMAOMR_SR;
 	
 	// 状態更新
 	this->status = ST_OPEN;
@@ -699,96 +1748,1308 @@ osStatus eth_open(ETH_OPEN *p_par)
 	return osOK;
 }
 
-// 送信
-osStatus eth_send(uint8_t *p_data, uint32_t size)
+// 送信ディスクリプタ設定
+// p_hdr != NULLの場合はヘッダを先頭のバッファにする (ペイロードはコピーしない)
+// リングモードではヘッダをバッファ1、ペイロードをバッファ2に設定するので1ディスクリプタで送信できる
+// p_sg : ペイロードのバッファリスト (連続していないバッファをそのまま1フレームとして送る)
+// kind     : 送信ディスクリプタの使用者 (TX_KIND_SEND、TX_KIND_ASYNC、TX_KIND_TSO)
+// p_waiter : 送信完了を通知する要求 (NULLは通知しない)
+static osStatus tx_submit(ETH_TypeDef *p_reg, uint8_t *p_hdr, uint32_t hdr_size, const ETH_SG *p_sg, uint32_t sg_num, uint32_t kind, OS_SIG_WAITER *p_waiter)
 {
 	ETH_CB *this = get_myself();
-	ETH_TypeDef *p_reg;
-	uint32_t remain_size = size;
-	uint32_t send_size;
-	uint8_t descriptor_idx = 0;
+	uint8_t *p_data;
+	uint32_t remain_size;
+	uint32_t seg_addr[TX_SEG_NUM_MAX];
+	uint32_t seg_len[TX_SEG_NUM_MAX];
+	uint32_t seg_num = 0;
+	uint32_t seg;
+	uint32_t desc_num;
+	uint32_t first_idx;
+	uint32_t descriptor_idx;
 	uint32_t tdes0 = 0;
+	uint32_t tdes1;
+	uint32_t i;
 	TX_DESCRIPTOR *p_desc;
-	osStatus ercd;
 	
-	// パラメータチェック
-	if ((p_data == NULL) || (size == 0)) {
-		return osErrorParameter;
+	// ヘッダ用のバッファ (アドレスはディスクリプタ確保後に決まる)
+	if (p_hdr != NULL) {
+		seg_addr[seg_num] = 0;
+		seg_len[seg_num++] = hdr_size;
 	}
 	
-	// オープンしていない場合はエラー
-	if (this->status != ST_OPEN) {
-		return osErrorResource;
+	for (i = 0; i < sg_num; i++) {
+		p_data = p_sg[i].p_data;
+		remain_size = p_sg[i].size;
+		
+		// フラッシュ
+		TRACE_EVT(TRACE_ETH_CLEAN_START, remain_size);
+		SCB_CleanDCache_by_Addr((uint32_t*)p_data, remain_size);
+		TRACE_EVT(TRACE_ETH_CLEAN_END, 0);
+		
+		// ペイロードをバッファサイズごとに分割
+		while (remain_size != 0) {
+			if (seg_num >= TX_SEG_NUM_MAX) {
+				return osErrorParameter;
+			}
+			seg_addr[seg_num] = (uint32_t)p_data;
+			seg_len[seg_num] = (remain_size > DATA_BUFF_SIZE_MAX) ? DATA_BUFF_SIZE_MAX : remain_size;
+			p_data += seg_len[seg_num];
+			remain_size -= seg_len[seg_num];
+			seg_num++;
+		}
+	}
+	
+	// 送信するデータがない
+	if (seg_num == 0) {
+		return osErrorParameter;
 	}
 	
-	// タスク情報を取得
-	this->thread_id = osThreadGetId();
+	// 1フレームに必要なディスクリプタ数
+	desc_num = (seg_num + TX_BUFF_PER_DESC - 1) / TX_BUFF_PER_DESC;
 	
-	// レジスタのベースアドレスを取得
-	p_reg = ch_info_tbl.p_reg;
+	// ディスクリプタはタイムトリガ送信(割り込み)と共有するため割り込み禁止で確保、設定する
+	__disable_irq();
+	
+	// ディスクリプタが足りない
+	if (this->tx_free_num < desc_num) {
+		__enable_irq();
+		return osErrorResource;
+	}
+	first_idx = this->tx_put_idx;
+	descriptor_idx = first_idx;
+	
+	// ヘッダは先頭ディスクリプタ用のバッファに作成する
+	if (p_hdr != NULL) {
+		memcpy(&(tx_hdr[first_idx][0]), p_hdr, hdr_size);
+		SCB_CleanDCache_by_Addr((uint32_t*)&(tx_hdr[first_idx][0]), TX_HDR_SIZE);
+		seg_addr[0] = (uint32_t)&(tx_hdr[first_idx][0]);
+	}
 	
 	// tdes0設定
-	tdes0 |= TDES0_FS | TDES0_TCH;
-	
-	// 全部送信
-	while (remain_size != 0) {
-		// 初回データ or 中間データ
-		if (remain_size > DATA_BUFF_SIZE_MAX) {
-			// 送信サイズ決定
-			send_size = DATA_BUFF_SIZE_MAX;
-			// 残りのサイズ計算
-			remain_size -= DATA_BUFF_SIZE_MAX;
-			
-		// 最終データ
-		} else {
-			// 送信サイズは残りのサイズ
-			send_size = remain_size;
-			// 最終セグメント、送信完了設定
-			tdes0 |= (TDES0_LS|TDES0_IC);
-			// 残りのサイズ計算
-			remain_size = 0;
-			
-		}
-		
+	tdes0 |= TDES0_FS;
+	// チェックサム挿入 (ストア&フォワード時のみ有効)
+	if (this->open_par.dma.tx_sf != 0) {
+		tdes0 |= TDES0_CIC(TDES0_CIC_FULL);
+	}
+	
+	// 全部設定
+	seg = 0;
+	for (i = 0; i < desc_num; i++) {
 		// ディスクリプタ取得
 		p_desc = &(tx_descriptor[descriptor_idx]);
 		
-		// TDES0～2設定
-		p_desc->TDES[2] = (uint32_t)p_data;
-		p_desc->TDES[1] = TDES1_TBS1(send_size);
+		// バッファ1
+		p_desc->TDES[2] = seg_addr[seg];
+		tdes1 = TDES1_TBS1(seg_len[seg]);
+		seg++;
+#ifdef TX_RING_MODE_ENABLE
+		// バッファ2
+		if (seg < seg_num) {
+			p_desc->TDES[3] = seg_addr[seg];
+			tdes1 |= TDES1_TBS2(seg_len[seg]);
+			seg++;
+		} else {
+			p_desc->TDES[3] = 0;
+		}
+#endif
+		p_desc->TDES[1] = tdes1;
 		
-		// TDES0設定
-		p_desc->TDES[0] = tdes0;
+		// 最終セグメント、送信完了設定
+		this->tx_waiter[descriptor_idx] = NULL;
+		if (seg >= seg_num) {
+			tdes0 |= (TDES0_LS|TDES0_IC);
+			this->tx_waiter[descriptor_idx] = p_waiter;
+		}
 		
-		// フラッシュ
-		SCB_CleanDCache_by_Addr(p_data, send_size);
+		// TDES0設定
+		p_desc->TDES[0] = tdes0 | tx_tdes0_mode(descriptor_idx);
+		this->tx_kind[descriptor_idx] = kind;
 		
 		// 次の送信準備
-		descriptor_idx++;
-		p_data += send_size;
+		descriptor_idx = (descriptor_idx + 1) % TX_DISCRIPTOR_NUM;
 		tdes0 &= ~TDES0_FS;		// 次のディスクリプタにはFSは立ててはいけない
 		tdes0 |= TDES0_OWN;		// 最初のディスクリプタにはセットしない
-		
-		// もう残りない
-		if (remain_size == 0) {
-			;
-			
-		// ディスクリプタももうない
-		} else if (descriptor_idx >= TX_DISCRIPTOR_NUM) {
-			descriptor_idx = 0;
-			
-			
-		// その他
-		} else {
-			continue;
-			
-		}
-		
-		// 送信失敗したなら終了
-		if (send_wait(p_reg) != osOK) {
-			break;
-		}
+	}
+	this->tx_put_idx = descriptor_idx;
+	this->tx_free_num -= desc_num;
+	
+	// 先頭ディスクリプタのOWNビットを最後にセットして送信開始
+	tx_descriptor[first_idx].TDES[0] |= TDES0_OWN;
+	tx_kick(p_reg);
+	TRACE_EVT(TRACE_ETH_TX_POST, first_idx | (desc_num << 8));
+	BOOT_MARK(BOOT_MARK_FIRST_TX);
+	
+	__enable_irq();
+	
+	return osOK;
+}
+
+// 送信
+osStatus eth_send(uint8_t *p_data, uint32_t size)
+{
+	ETH_SG sg;
+	
+	sg.p_data = p_data;
+	sg.size = size;
+	
+	return eth_send_sg(&sg, 1);
+}
+
+// 複数バッファの送信 (リストの順に連結して1フレームとして送信する)
+osStatus eth_send_sg(const ETH_SG *p_sg, uint32_t num)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	OS_SIG_WAITER waiter;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if ((p_sg == NULL) || (num == 0)) {
+		return osErrorParameter;
 	}
 	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// 送信完了の待ち準備 (要求ごとに通知先を持つので複数タスクから送信できる)
+	os_sig_prepare(&waiter);
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// ディスクリプタ設定
+	if ((ercd = tx_submit(p_reg, NULL, 0, p_sg, num, TX_KIND_SEND, &waiter)) != osOK) {
+		return ercd;
+	}
+	
+	// 送信完了待ち
+	ercd = send_wait(&waiter);
+	
 	return ercd;
-}	
+}
+
+// 送信 (完了を待たない)
+// 送信完了まで(eth_tx_flush()が戻るまで)p_dataの内容を変更しないこと
+// 戻り値 : osErrorResource 送信ディスクリプタが空いていない
+osStatus eth_send_nowait(uint8_t *p_data, uint32_t size)
+{
+	ETH_CB *this = get_myself();
+	ETH_SG sg;
+	
+	// パラメータチェック
+	if ((p_data == NULL) || (size == 0)) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// ディスクリプタ設定
+	sg.p_data = p_data;
+	sg.size = size;
+	
+	return tx_submit(ch_info_tbl.p_reg, NULL, 0, &sg, 1, TX_KIND_ASYNC, NULL);
+}
+
+// 送信中のフレームがなくなるまで待つ
+// tmout : タイムアウト[ms]
+osStatus eth_tx_flush(uint32_t tmout)
+{
+	ETH_CB *this = get_myself();
+	uint32_t start = osKernelSysTick();
+	
+	while (this->tx_free_num != TX_DISCRIPTOR_NUM) {
+		if ((osKernelSysTick() - start) >= tmout) {
+			return osErrorTimeoutResource;
+		}
+		osDelay(1);
+	}
+	
+	return osOK;
+}
+
+// パケットバッファの送信 (送信完了後もバッファは呼び出し元が所有する)
+osStatus eth_send_pkt(PKT_BUF *p_pkt)
+{
+	// パラメータチェック
+	if (p_pkt == NULL) {
+		return osErrorParameter;
+	}
+	
+	return eth_send(p_pkt->p_data, p_pkt->len);
+}
+
+// VLANタグ付き送信
+// p_data : タグなしのフレーム (宛先、送信元、EtherType、ペイロード)
+// tci    : PCP(3bit) + DEI(1bit) + VID(12bit)
+// (*) タグはヘッダ用のバッファで挿入するのでペイロードは移動しない
+osStatus eth_send_vlan(uint8_t *p_data, uint32_t size, uint16_t tci)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint8_t hdr[ETH_ADDR_AREA_SIZE + VLAN_TAG_SIZE];
+	ETH_SG sg;
+	OS_SIG_WAITER waiter;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if ((p_data == NULL) || (size <= ETH_ADDR_AREA_SIZE)) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// 送信完了の待ち準備
+	os_sig_prepare(&waiter);
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// ヘッダ作成 (アドレス + VLANタグ)
+	memcpy(hdr, p_data, ETH_ADDR_AREA_SIZE);
+	hdr[12] = (uint8_t)(ETH_TYPE_VLAN >> 8);
+	hdr[13] = (uint8_t)(ETH_TYPE_VLAN & 0xFF);
+	hdr[14] = (uint8_t)(tci >> 8);
+	hdr[15] = (uint8_t)(tci & 0xFF);
+	
+	// ディスクリプタ設定 (EtherType以降は元のバッファをそのまま送る)
+	sg.p_data = p_data + ETH_ADDR_AREA_SIZE;
+	sg.size = size - ETH_ADDR_AREA_SIZE;
+	if ((ercd = tx_submit(p_reg, hdr, sizeof(hdr), &sg, 1, TX_KIND_SEND, &waiter)) != osOK) {
+		return ercd;
+	}
+	
+	// 送信完了待ち
+	ercd = send_wait(&waiter);
+	
+	return ercd;
+}
+
+// ビッグエンディアンの16bit値の読み書き
+static uint16_t tso_get16(const uint8_t *p)
+{
+	return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+static void tso_put16(uint8_t *p, uint16_t val)
+{
+	p[0] = (uint8_t)(val >> 8);
+	p[1] = (uint8_t)val;
+}
+
+// 16bitフィールドの変更に合わせたチェックサムの差分更新 (RFC 1624 : HC' = ~(~HC + ~m + m'))
+static uint16_t tso_csum_update(uint16_t csum, uint16_t old_val, uint16_t new_val)
+{
+	uint32_t sum;
+	
+	sum = (uint16_t)~csum + (uint16_t)~old_val + new_val;
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	
+	return (uint16_t)~sum;
+}
+
+// IPヘッダチェックサム計算 (テンプレートに1回だけ)
+static uint16_t tso_ip_csum(const uint8_t *p_ip, uint32_t len)
+{
+	uint32_t sum = 0;
+	uint32_t i;
+	
+	for (i = 0; i < len; i += 2) {
+		sum += tso_get16(&p_ip[i]);
+	}
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	
+	return (uint16_t)~sum;
+}
+
+// セグメンテーションオフロード送信
+// ペイロードをmssごとに分割し、各セグメントにヘッダテンプレートを複製して送信する
+// ・ヘッダはディスクリプタのバッファ1(tx_hdr)、ペイロードはバッファ2で元のバッファを直接指す (コピーしない)
+// ・ETH_TSO_UDP : IPv4の全長、ID、UDP長をセグメントごとに書き換え、IPチェックサムは差分更新する
+//                 UDPチェックサムはMACで挿入する (チェックサム挿入が無効なら0 = チェックサムなし)
+// ・seq_offset  : ヘッダ内の32bitシーケンス番号(ビッグエンディアン)をセグメントごとに1ずつ増やす
+// (*) 全セグメントの送信完了まで戻らない (送信がTSO_STALL_TMOUT進まない場合はosErrorTimeoutResource)
+osStatus eth_send_tso(const uint8_t *p_hdr, uint32_t hdr_size, uint8_t *p_data, uint32_t size, const ETH_TSO_PAR *p_par)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint8_t hdr[TX_HDR_SIZE];
+	uint8_t *p_ip = NULL;
+	ETH_SG sg;
+	TSO_REQ req;
+	uint32_t ip_off;
+	uint32_t ip_hdr_size = 0;
+	uint32_t mss;
+	uint32_t seq = 0;
+	uint32_t pending_num;
+	uint32_t start;
+	uint32_t i;
+	uint16_t csum = 0;
+	uint16_t old_val, new_val;
+	osStatus ercd = osOK;
+	
+	// パラメータチェック
+	if ((p_hdr == NULL) || (p_data == NULL) || (p_par == NULL) || (size == 0) ||
+		(hdr_size < ETH_ADDR_AREA_SIZE + 2) || (hdr_size > TX_HDR_SIZE) || (p_par->type >= ETH_TSO_TYPE_MAX)) {
+		return osErrorParameter;
+	}
+	if ((p_par->seq_offset != 0) && ((p_par->seq_offset + 4) > hdr_size)) {
+		return osErrorParameter;
+	}
+	
+	// VLANタグがあればその後ろがEtherType
+	ip_off = ETH_ADDR_AREA_SIZE + 2;
+	if (tso_get16(&p_hdr[ETH_ADDR_AREA_SIZE]) == ETH_TYPE_VLAN) {
+		ip_off += VLAN_TAG_SIZE;
+	}
+	
+	// セグメントサイズ (0は最大フレームサイズに収まる最大値)
+	mss = (p_par->mss != 0) ? p_par->mss : (ETH_FRAME_SIZE_MAX + (ip_off - ETH_ADDR_AREA_SIZE - 2) - hdr_size);
+	if ((hdr_size + mss) > (ETH_FRAME_SIZE_MAX + (ip_off - ETH_ADDR_AREA_SIZE - 2)) || (mss > DATA_BUFF_SIZE_MAX)) {
+		return osErrorParameter;
+	}
+	
+	// テンプレートをコピー
+	memcpy(hdr, p_hdr, hdr_size);
+	
+	// UDP : IPv4(プロトコルUDP)で、ヘッダがIP、UDPヘッダで終わっていること
+	if (p_par->type == ETH_TSO_UDP) {
+		p_ip = &hdr[ip_off];
+		ip_hdr_size = (uint32_t)(p_ip[0] & 0x0F) * 4;
+		if ((tso_get16(&hdr[ip_off - 2]) != ETH_TYPE_IPV4) || (p_ip[9] != IP_PROTO_UDP) ||
+			(ip_hdr_size < 20) || (hdr_size != (ip_off + ip_hdr_size + 8))) {
+			return osErrorParameter;
+		}
+		// IPチェックサムはテンプレートで計算しておき、以降は差分更新
+		tso_put16(&p_ip[10], 0);
+		csum = tso_ip_csum(p_ip, ip_hdr_size);
+		tso_put16(&p_ip[10], csum);
+		// UDPチェックサムはMACで挿入 (無効なら使わない)
+		tso_put16(&p_ip[ip_hdr_size + 6], 0);
+	}
+	if (p_par->seq_offset != 0) {
+		seq = ((uint32_t)tso_get16(&hdr[p_par->seq_offset]) << 16) | tso_get16(&hdr[p_par->seq_offset + 2]);
+	}
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// セグメント送信完了の待ち準備
+	os_sig_prepare(&(req.waiter));
+	req.pending_num = 0;
+	req.err_cnt = 0;
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	while (size != 0) {
+		sg.p_data = p_data;
+		sg.size = (size > mss) ? mss : size;
+		
+		// ヘッダ書き換え (IPv4全長、UDP長)
+		if (p_ip != NULL) {
+			old_val = tso_get16(&p_ip[2]);
+			new_val = (uint16_t)(ip_hdr_size + 8 + sg.size);
+			tso_put16(&p_ip[2], new_val);
+			csum = tso_csum_update(csum, old_val, new_val);
+			tso_put16(&p_ip[10], csum);
+			tso_put16(&p_ip[ip_hdr_size + 4], (uint16_t)(8 + sg.size));
+		}
+		if (p_par->seq_offset != 0) {
+			tso_put16(&hdr[p_par->seq_offset], (uint16_t)(seq >> 16));
+			tso_put16(&hdr[p_par->seq_offset + 2], (uint16_t)seq);
+		}
+		
+		// ディスクリプタ設定 (空きがなければ送信中のセグメントの完了を待つ)
+		__disable_irq();
+		req.pending_num++;
+		__enable_irq();
+		start = osKernelSysTick();
+		while ((ercd = tx_submit(p_reg, hdr, hdr_size, &sg, 1, TX_KIND_TSO, &(req.waiter))) == osErrorResource) {
+			// 空かないまま時間が経った (送信DMAが止まっている)
+			if ((osKernelSysTick() - start) >= TSO_STALL_TMOUT) {
+				ercd = osErrorTimeoutResource;
+				break;
+			}
+			// 他の送信(タイムトリガ送信など)が使用中の場合は通知が来ないので待つだけ
+			if (req.pending_num > 1) {
+				os_sig_wait(&(req.waiter), EVT_TSO_DONE, 1);
+			} else {
+				osDelay(1);
+			}
+		}
+		if (ercd != osOK) {
+			__disable_irq();
+			req.pending_num--;
+			__enable_irq();
+			break;
+		}
+		
+		// 次のセグメント (IPv4 IDとシーケンス番号を1つ進める)
+		if (p_ip != NULL) {
+			old_val = tso_get16(&p_ip[4]);
+			new_val = old_val + 1;
+			tso_put16(&p_ip[4], new_val);
+			csum = tso_csum_update(csum, old_val, new_val);
+		}
+		seq++;
+		p_data += sg.size;
+		size -= sg.size;
+	}
+	
+	// 全セグメントの送信完了待ち (完了が進まなくなったらタイムアウト)
+	start = osKernelSysTick();
+	pending_num = req.pending_num;
+	while (req.pending_num != 0) {
+		os_sig_wait(&(req.waiter), EVT_TSO_DONE, 1);
+		if (req.pending_num != pending_num) {
+			pending_num = req.pending_num;
+			start = osKernelSysTick();
+		} else if ((osKernelSysTick() - start) >= TSO_STALL_TMOUT) {
+			break;
+		}
+	}
+	
+	// タイムアウトした場合は送信中のセグメントから要求を外す (reqはスタックにあるので通知させない)
+	__disable_irq();
+	if (req.pending_num != 0) {
+		for (i = 0; i < TX_DISCRIPTOR_NUM; i++) {
+			if (this->tx_waiter[i] == &(req.waiter)) {
+				this->tx_waiter[i] = NULL;
+			}
+		}
+		ercd = osErrorTimeoutResource;
+	}
+	__enable_irq();
+	
+	// 送信失敗したセグメントがある
+	if ((ercd == osOK) && (req.err_cnt != 0)) {
+		ercd = osErrorISR;	// send_wait()と同じ
+	}
+	
+	return ercd;
+}
+
+// 送信チェックサム挿入が有効か
+// (*) MACのチェックサム挿入はストア&フォワード送信でないと動作しない
+// 戻り値 : 1 有効 (IP、ICMP/UDP/TCPのチェックサムは0のまま渡してよい)
+uint32_t eth_tx_csum_offload(void)
+{
+	ETH_CB *this = get_myself();
+	
+	if ((this->status == ST_OPEN) && (this->open_par.dma.tx_sf != 0)) {
+		return 1;
+	}
+	return 0;
+}
+
+// MACアドレス取得
+void eth_get_mac_addr(uint8_t *p_addr)
+{
+	memcpy(p_addr, mac_address, sizeof(mac_address));
+}
+
+// 優先度キューから受信フレームの取り出し
+// 戻り値 : 受信したパケットバッファ (受信フレームがない場合はNULL)
+static PKT_BUF* rx_get_pkt(ETH_TypeDef *p_reg)
+{
+	ETH_CB *this = get_myself();
+	RX_CB *p_rx = &(this->rx);
+	PKT_BUF *p_pkt = NULL;
+	int32_t prio;
+	
+	__disable_irq();
+	
+	// 止まっていた受信があれば再開
+	rx_classify(p_reg);
+	
+	// 高い優先度から取り出す
+	for (prio = ETH_PRIO_NUM - 1; prio >= 0; prio--) {
+		if (p_rx->w_idx[prio] != p_rx->r_idx[prio]) {
+			p_pkt = p_rx->que[prio][p_rx->r_idx[prio] & RX_QUE_MASK];
+			p_rx->r_idx[prio]++;
+			p_rx->que_num--;
+			// フロー制御解除
+			fc_update(p_reg, 0);
+			break;
+		}
+	}
+	
+	__enable_irq();
+	
+	return p_pkt;
+}
+
+// 受信 (パケットバッファを渡す、使用後はpkt_free()で解放すること)
+// tmout : タイムアウト[ms] (0は待たない、負の値は永久待ち)
+// 戻り値 : 受信したパケットバッファ (タイムアウト、エラーの場合はNULL)
+PKT_BUF* eth_recv_pkt(int32_t tmout)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	PKT_BUF *p_pkt;
+	RX_WAITER rx_waiter;
+	RX_WAITER **pp_link;
+	uint32_t start;
+	uint32_t elapsed;
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return NULL;
+	}
+	
+	// 受信の待ち準備 (受信待ちリストの先頭につなぐ)
+	os_sig_prepare(&(rx_waiter.waiter));
+	__disable_irq();
+	rx_waiter.next = this->p_rx_waiter;
+	this->p_rx_waiter = &rx_waiter;
+	__enable_irq();
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// 受信待ちが複数いる場合は全員を起こすので、フレームは先に取り出したほうが受け取る
+	// (他の受信待ちに先を越されて起きた場合は残り時間で待ち直す)
+	start = osKernelSysTick();
+	while (1) {
+		// 受信フレームがあれば取り出す
+		if ((p_pkt = rx_get_pkt(p_reg)) != NULL) {
+			break;
+		}
+		// 待たない
+		if (tmout == 0) {
+			break;
+		}
+		// 受信待ち
+		if (tmout < 0) {
+			(void)os_sig_wait(&(rx_waiter.waiter), EVT_RECV_SUCCESS, -1);
+		} else {
+			elapsed = osKernelSysTick() - start;
+			if ((elapsed >= (uint32_t)tmout) ||
+				(os_sig_wait(&(rx_waiter.waiter), EVT_RECV_SUCCESS, tmout - (int32_t)elapsed) == 0)) {
+				break;
+			}
+		}
+	}
+	
+	// 受信待ちリストから外す
+	__disable_irq();
+	for (pp_link = &(this->p_rx_waiter); *pp_link != NULL; pp_link = &((*pp_link)->next)) {
+		if (*pp_link == &rx_waiter) {
+			*pp_link = rx_waiter.next;
+			break;
+		}
+	}
+	__enable_irq();
+	
+	return p_pkt;
+}
+
+// 受信
+// tmout : タイムアウト[ms] (0は待たない、負の値は永久待ち)
+// 戻り値 : 受信サイズ (タイムアウトの場合は0、エラーの場合は-1)
+int32_t eth_recv(uint8_t *p_data, uint32_t size, int32_t tmout)
+{
+	ETH_CB *this = get_myself();
+	PKT_BUF *p_pkt;
+	uint32_t len;
+	
+	// パラメータチェック
+	if ((p_data == NULL) || (size == 0)) {
+		return -1;
+	}
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return -1;
+	}
+	
+	// 受信
+	if ((p_pkt = eth_recv_pkt(tmout)) == NULL) {
+		return 0;
+	}
+	
+	// コピーしてバッファ解放
+	len = p_pkt->len;
+	if (len > size) {
+		len = size;
+	}
+	memcpy(p_data, p_pkt->p_data, len);
+	pkt_free(p_pkt);
+	
+	return len;
+}
+
+// フロー制御設定
+osStatus eth_fc_config(ETH_FC_PAR *p_par)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint32_t start;
+	
+	// パラメータチェック
+	if (p_par == NULL) {
+		return osErrorParameter;
+	}
+	if ((p_par->tx_enable != 0) &&
+		((p_par->high_thresh > RX_PENDING_MAX) || (p_par->low_thresh >= p_par->high_thresh))) {
+		return osErrorParameter;
+	}
+	
+	// 初期化していない場合はエラー
+	if (this->status == ST_INIT) {
+		return osErrorResource;
+	}
+	
+	// 設定保存
+	__disable_irq();
+	this->fc.par = *p_par;
+	memset(&(this->fc.stat), 0, sizeof(this->fc.stat));
+	this->fc.status = FC_ST_XON;
+	__enable_irq();
+	
+	// オープン中ならすぐ反映
+	// (*) PAUSEフレームの送信が終わらない場合(リンクダウンなど)は反映しない (設定は次のオープンで反映)
+	if (this->status == ST_OPEN) {
+		p_reg = ch_info_tbl.p_reg;
+		start = hrt_get_us();
+		while ((p_reg->MACFCR & ETH_MACFCR_FCBBPA) != 0) {
+			if (hrt_elapsed_us(start) > FC_PAUSE_TMOUT_US) {
+				return osErrorTimeoutResource;
+			}
+		}
+		p_reg->MACFCR = fc_get_reg(&(this->fc.par), this->fc.par.pause_time);
+		// PCFはアドレスフィルタと一緒に設定する
+		osMutexWait(this->filter.mutex, osWaitForever);
+		filter_apply(p_reg);
+		osMutexRelease(this->filter.mutex);
+	}
+	
+	return osOK;
+}
+
+// フロー制御統計取得
+osStatus eth_fc_get_stat(ETH_FC_STAT *p_stat)
+{
+	ETH_CB *this = get_myself();
+	
+	// パラメータチェック
+	if (p_stat == NULL) {
+		return osErrorParameter;
+	}
+	
+	__disable_irq();
+	*p_stat = this->fc.stat;
+	__enable_irq();
+	
+	return osOK;
+}
+
+// VLAN設定
+osStatus eth_vlan_config(ETH_VLAN_PAR *p_par)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint32_t i;
+	
+	// パラメータチェック
+	if ((p_par == NULL) || (p_par->vid > 0x0FFF)) {
+		return osErrorParameter;
+	}
+	for (i = 0; i < sizeof(p_par->prio_map); i++) {
+		if (p_par->prio_map[i] >= ETH_PRIO_NUM) {
+			return osErrorParameter;
+		}
+	}
+	
+	// 初期化していない場合はエラー
+	if (this->status == ST_INIT) {
+		return osErrorResource;
+	}
+	
+	// 設定保存
+	__disable_irq();
+	this->rx.vlan = *p_par;
+	__enable_irq();
+	
+	// オープン中ならすぐ反映
+	if (this->status == ST_OPEN) {
+		p_reg = ch_info_tbl.p_reg;
+		p_reg->MACVLANTR = vlan_get_reg(&(this->rx.vlan));
+	}
+	
+	return osOK;
+}
+
+// PCPから優先度キューへの変換の推奨値取得 (p_mapは8要素)
+void eth_vlan_get_default_map(uint8_t *p_map)
+{
+	memcpy(p_map, vlan_prio_map_default, sizeof(vlan_prio_map_default));
+}
+
+// ループバック設定
+// ETH_LOOPBACK_MAC : MAC内部で送信を受信に折り返す (PHYへは出ない)
+// ETH_LOOPBACK_PHY : PHYのMII側で折り返す (オートネゴシエーションを止めて100Mbps全二重固定)
+// ETH_LOOPBACK_NONE : ループバック解除 (PHYはオートネゴシエーションを再開)
+osStatus eth_loopback_config(ETH_LOOPBACK mode)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint16_t bmcr;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if (mode >= ETH_LOOPBACK_MAX) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない場合はエラー (PHYの設定にMIIを使う)
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// PHYループバック
+	if (mode == ETH_LOOPBACK_PHY) {
+		bmcr = BASIC_CONTROL_LOOP_BACK | BASIC_CONTROL_SPEED_SELECT_100MBPS | BASIC_CONTROL_DUPLEX;
+	} else {
+		bmcr = BASIC_CONTROL_AUTO_NEGOTIATE_ENABLE | BASIC_CONTROL_RESTART_AUTO_NEGOTIATE;
+	}
+	mdio_lock();
+	if ((this->loopback == ETH_LOOPBACK_PHY) || (mode == ETH_LOOPBACK_PHY)) {
+		if ((ercd = phy_write(p_reg, PHY_REG_BASIC_CONTROL, bmcr)) != osOK) {
+			mdio_unlock();
+			return ercd;
+		}
+	}
+	
+	// MACの速度と全二重をPHYに合わせる (PHYループバックは100Mbps全二重固定、抜けるときは元に戻す)
+	if ((this->loopback != ETH_LOOPBACK_PHY) && (mode == ETH_LOOPBACK_PHY)) {
+		this->loopback_maccr = p_reg->MACCR & (ETH_MACCR_FES | ETH_MACCR_DM);
+		p_reg->MACCR |= (ETH_MACCR_FES | ETH_MACCR_DM);
+		hrt_delay_us(REG_WRITE_DELAY_US);
+	} else if ((this->loopback == ETH_LOOPBACK_PHY) && (mode != ETH_LOOPBACK_PHY)) {
+		p_reg->MACCR = (p_reg->MACCR & ~(ETH_MACCR_FES | ETH_MACCR_DM)) | this->loopback_maccr;
+		hrt_delay_us(REG_WRITE_DELAY_US);
+	}
+	
+	// MACループバック
+	if (mode == ETH_LOOPBACK_MAC) {
+		p_reg->MACCR |= ETH_MACCR_LM;
+	} else {
+		p_reg->MACCR &= ~ETH_MACCR_LM;
+	}
+	
+	// eth_phy_init()がMACCRに反映するかどうかを見るのでMDIOの排他中に更新する
+	this->loopback = mode;
+	mdio_unlock();
+	
+	return osOK;
+}
+
+// ループバック設定取得
+ETH_LOOPBACK eth_loopback_get(void)
+{
+	ETH_CB *this = get_myself();
+	
+	return this->loopback;
+}
+
+// VLAN統計取得
+osStatus eth_vlan_get_stat(ETH_VLAN_STAT *p_stat)
+{
+	ETH_CB *this = get_myself();
+	
+	// パラメータチェック
+	if (p_stat == NULL) {
+		return osErrorParameter;
+	}
+	
+	__disable_irq();
+	*p_stat = this->rx.stat;
+	__enable_irq();
+	
+	return osOK;
+}
+
+// DMA動作モード変更
+// (*) 送信中のフレームがなくなるのを待って送受信DMAを止めてから変更する
+osStatus eth_dma_config(ETH_DMA_PAR *p_par)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint32_t dmaomr;
+	uint32_t dmabmr;
+	uint32_t start;
+	osStatus ercd;
+	
+	// パラメータチェック
+	if (p_par == NULL) {
+		return osErrorParameter;
+	}
+	if (dma_get_reg(p_par, &dmaomr, &dmabmr) != osOK) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない、タイムトリガ送信中の場合はエラー
+	if ((this->status != ST_OPEN) || (this->tt.status != TT_ST_STOP)) {
+		return osErrorResource;
+	}
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// 送信中のフレームがなくなるまで待つ (送信DMAがサスペンドしたままなら変更しない)
+	if ((ercd = eth_tx_flush(DMA_TX_DRAIN_TMOUT)) != osOK) {
+		return ercd;
+	}
+	
+	// 送受信DMA停止
+	p_reg->DMAOMR &= ~(ETH_DMAOMR_ST | ETH_DMAOMR_SR);
+	
+	// 送信FIFOフラッシュ (終わらない場合は設定を変えずに受信DMAだけ再開する)
+	p_reg->DMAOMR |= ETH_DMAOMR_FTF;
+	start = hrt_get_us();
+	while ((p_reg->DMAOMR & ETH_DMAOMR_FTF) != 0) {
+		if (hrt_elapsed_us(start) > DMA_FLUSH_TMOUT_US) {
+			p_reg->DMAOMR |= ETH_DMAOMR_SR;
+			return osErrorTimeoutResource;
+		}
+	}
+	
+	// 設定変更して受信DMA再開 (送信DMAは次の送信で開始)
+	this->open_par.dma = *p_par;
+	p_reg->DMABMR = dmabmr;
+	p_reg->DMAOMR = dmaomr | ETH_DMAOMR_SR;
+	
+	return osOK;
+}
+
+// DMA統計取得
+osStatus eth_dma_get_stat(ETH_DMA_STAT *p_stat)
+{
+	ETH_CB *this = get_myself();
+	ETH_TypeDef *p_reg;
+	uint32_t dmamfbocr;
+	
+	// パラメータチェック
+	if (p_stat == NULL) {
+		return osErrorParameter;
+	}
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	__disable_irq();
+	// 取りこぼしたフレーム数 (読み出しでクリアされるので積算する)
+	if (this->status == ST_OPEN) {
+		dmamfbocr = p_reg->DMAMFBOCR;
+		this->dma_stat.rx_missed_cnt += (dmamfbocr & ETH_DMAMFBOCR_MFC) >> ETH_DMAMFBOCR_MFC_Pos;
+		this->dma_stat.rx_missed_cnt += (dmamfbocr & ETH_DMAMFBOCR_MFA) >> ETH_DMAMFBOCR_MFA_Pos;
+	}
+	*p_stat = this->dma_stat;
+	__enable_irq();
+	
+	return osOK;
+}
+
+// DMA統計クリア
+void eth_dma_clear_stat(void)
+{
+	ETH_CB *this = get_myself();
+	
+	__disable_irq();
+	memset(&(this->dma_stat), 0, sizeof(this->dma_stat));
+	__enable_irq();
+}
+
+// タイムトリガ送信開始
+osStatus eth_tt_start(uint32_t period_ns)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	ETH_TypeDef *p_reg;
+	uint32_t sec, nsec;
+	
+	// パラメータチェック
+	if ((period_ns < TT_PERIOD_MIN) || (period_ns >= NSEC_PER_SEC)) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない or 動作中の場合はエラー
+	if ((this->status != ST_OPEN) || (p_tt->status != TT_ST_STOP)) {
+		return osErrorResource;
+	}
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// 統計クリア (キューに積まれたフレームは残す)
+	memset(&(p_tt->stat), 0, sizeof(p_tt->stat));
+	memset(p_tt->log, 0, sizeof(p_tt->log));
+	p_tt->offset_sum = 0;
+	p_tt->log_idx = 0;
+	p_tt->period = period_ns;
+	
+	// 最初のターゲット時刻
+	ptp_get_time(p_reg, &sec, &nsec);
+	ptp_add_time(&sec, &nsec, TT_START_DELAY);
+	p_tt->tgt_sec = sec;
+	p_tt->tgt_nsec = nsec;
+	
+	// 開始
+	__disable_irq();
+	p_tt->status = TT_ST_RUN;
+	tt_set_target(p_reg, sec, nsec);
+	p_reg->MACIMR &= ~ETH_MACIMR_TSTIM;
+	__enable_irq();
+	
+	return osOK;
+}
+
+// タイムトリガ送信停止
+osStatus eth_tt_stop(void)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	ETH_TypeDef *p_reg;
+	
+	// 動作中でない場合はエラー
+	if (p_tt->status != TT_ST_RUN) {
+		return osErrorResource;
+	}
+	
+	// レジスタのベースアドレスを取得
+	p_reg = ch_info_tbl.p_reg;
+	
+	// 停止 (送信されなかったフレームは破棄)
+	__disable_irq();
+	p_reg->MACIMR |= ETH_MACIMR_TSTIM;
+	p_reg->PTPTSCR &= ~ETH_PTPTSCR_TSITE;
+	p_tt->status = TT_ST_STOP;
+	p_tt->r_idx = p_tt->w_idx;
+	__enable_irq();
+	
+	return osOK;
+}
+
+// タイムトリガ送信フレームのキューイング
+// (*) フレームは1ディスクリプタに収まること。送信完了までバッファを書き換えないこと
+osStatus eth_tt_queue(uint8_t *p_data, uint32_t size)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	uint32_t w_idx;
+	
+	// パラメータチェック
+	if ((p_data == NULL) || (size == 0) || (size > DATA_BUFF_SIZE_MAX)) {
+		return osErrorParameter;
+	}
+	
+	// オープンしていない場合はエラー
+	if (this->status != ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// 割り込みで送信するため、あらかじめフラッシュしておく
+	SCB_CleanDCache_by_Addr((uint32_t*)p_data, size);
+	
+	// キューに詰める (読み出しは割り込みのみ)
+	w_idx = p_tt->w_idx;
+	if (((w_idx + 1) & (TT_QUEUE_NUM - 1)) == p_tt->r_idx) {
+		return osErrorResource;
+	}
+	p_tt->que[w_idx].p_data = p_data;
+	p_tt->que[w_idx].size = size;
+	__DMB();
+	p_tt->w_idx = (w_idx + 1) & (TT_QUEUE_NUM - 1);
+	
+	return osOK;
+}
+
+// タイムトリガ送信統計取得
+osStatus eth_tt_get_stat(ETH_TT_STAT *p_stat)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	uint64_t offset_sum;
+	
+	// パラメータチェック
+	if (p_stat == NULL) {
+		return osErrorParameter;
+	}
+	
+	__disable_irq();
+	*p_stat = p_tt->stat;
+	offset_sum = p_tt->offset_sum;
+	__enable_irq();
+	
+	// 平均オフセット
+	if (p_stat->send_cnt != 0) {
+		p_stat->offset_avg = (int32_t)((int64_t)offset_sum / p_stat->send_cnt);
+	}
+	
+	return osOK;
+}
+
+// 周期ごとの送信オフセット取得 (古い順)
+uint32_t eth_tt_get_log(int32_t *p_buf, uint32_t num)
+{
+	ETH_CB *this = get_myself();
+	TT_CB *p_tt = &(this->tt);
+	uint32_t log_num;
+	uint32_t idx;
+	uint32_t i;
+	
+	// パラメータチェック
+	if (p_buf == NULL) {
+		return 0;
+	}
+	
+	__disable_irq();
+	
+	// 記録されている数
+	log_num = (p_tt->stat.send_cnt < TT_LOG_NUM) ? p_tt->stat.send_cnt : TT_LOG_NUM;
+	if (num > log_num) {
+		num = log_num;
+	}
+	
+	// 新しい方からnum個を古い順に取得
+	idx = (p_tt->log_idx - num) & (TT_LOG_NUM - 1);
+	for (i = 0; i < num; i++) {
+		p_buf[i] = p_tt->log[idx];
+		idx = (idx + 1) & (TT_LOG_NUM - 1);
+	}
+	
+	__enable_irq();
+	
+	return num;
+}
+
+// 受信アドレス登録 (filter.mutexを取得して呼ぶ)
+// 完全一致フィルタ(MACA1～3)を優先して使用し、空きがなければハッシュフィルタに登録する
+static osStatus filter_add(const uint8_t *p_addr)
+{
+	ETH_CB *this = get_myself();
+	FILTER_CB *p_filter = &(this->filter);
+	FILTER_ENTRY *p_entry = NULL;
+	FILTER_ENTRY *p_free = NULL;
+	uint32_t bit;
+	uint8_t i;
+	
+	// 登録済みか確認
+	for (i = 0; i < FILTER_ADDR_NUM; i++) {
+		if (p_filter->entry[i].ref == 0) {
+			if (p_free == NULL) {
+				p_free = &(p_filter->entry[i]);
+			}
+		} else if (memcmp(p_filter->entry[i].addr, p_addr, 6) == 0) {
+			p_entry = &(p_filter->entry[i]);
+			break;
+		}
+	}
+	
+	// 登録済みなら参照カウントを増やすだけ
+	if (p_entry != NULL) {
+		if (p_entry->ref == 0xFF) {
+			return osErrorResource;
+		}
+		p_entry->ref++;
+		return osOK;
+	}
+	
+	// 登録できない
+	if (p_free == NULL) {
+		return osErrorResource;
+	}
+	
+	// 完全一致フィルタの空きを探す
+	memcpy(p_free->addr, p_addr, 6);
+	p_free->slot = ETH_FILTER_SLOT_HASH;
+	for (i = 0; i < FILTER_PERFECT_NUM; i++) {
+		if (p_filter->perfect_used[i] == 0) {
+			p_filter->perfect_used[i] = 1;
+			p_free->slot = i;
+			break;
+		}
+	}
+	
+	// 空きがないならハッシュに登録
+	if (p_free->slot == ETH_FILTER_SLOT_HASH) {
+		bit = filter_hash(p_addr);
+		p_filter->hash_ref[bit]++;
+		if ((p_addr[0] & 0x01) != 0) {
+			p_filter->hash_mc_num++;
+		} else {
+			p_filter->hash_uc_num++;
+		}
+	}
+	p_free->ref = 1;
+	
+	// オープン中ならすぐ反映
+	if (this->status == ST_OPEN) {
+		filter_apply(ch_info_tbl.p_reg);
+	}
+	
+	return osOK;
+}
+
+// 受信アドレス削除 (filter.mutexを取得して呼ぶ)
+// 完全一致フィルタが空いた場合はハッシュに登録されているアドレスを移動する
+static osStatus filter_del(const uint8_t *p_addr)
+{
+	ETH_CB *this = get_myself();
+	FILTER_CB *p_filter = &(this->filter);
+	FILTER_ENTRY *p_entry = NULL;
+	FILTER_ENTRY *p_move;
+	uint8_t slot;
+	uint8_t i;
+	
+	// 登録されているか確認
+	for (i = 0; i < FILTER_ADDR_NUM; i++) {
+		if ((p_filter->entry[i].ref != 0) && (memcmp(p_filter->entry[i].addr, p_addr, 6) == 0)) {
+			p_entry = &(p_filter->entry[i]);
+			break;
+		}
+	}
+	if (p_entry == NULL) {
+		return osErrorParameter;
+	}
+	
+	// まだ参照されている
+	if (--p_entry->ref != 0) {
+		return osOK;
+	}
+	
+	// ハッシュから削除
+	if (p_entry->slot == ETH_FILTER_SLOT_HASH) {
+		p_filter->hash_ref[filter_hash(p_entry->addr)]--;
+		if ((p_entry->addr[0] & 0x01) != 0) {
+			p_filter->hash_mc_num--;
+		} else {
+			p_filter->hash_uc_num--;
+		}
+		
+	// 完全一致フィルタから削除
+	} else {
+		slot = p_entry->slot;
+		p_filter->perfect_used[slot] = 0;
+		// ハッシュに登録されているアドレスがあれば空いたスロットに移動
+		for (i = 0; i < FILTER_ADDR_NUM; i++) {
+			p_move = &(p_filter->entry[i]);
+			if ((p_move->ref != 0) && (p_move->slot == ETH_FILTER_SLOT_HASH)) {
+				p_filter->hash_ref[filter_hash(p_move->addr)]--;
+				if ((p_move->addr[0] & 0x01) != 0) {
+					p_filter->hash_mc_num--;
+				} else {
+					p_filter->hash_uc_num--;
+				}
+				p_move->slot = slot;
+				p_filter->perfect_used[slot] = 1;
+				break;
+			}
+		}
+	}
+	
+	// オープン中ならすぐ反映
+	if (this->status == ST_OPEN) {
+		filter_apply(ch_info_tbl.p_reg);
+	}
+	
+	return osOK;
+}
+
+// 受信アドレス登録
+// (*) ネットワーク層、コンソールなど複数のタスクから呼ばれるので、テーブルとレジスタの更新はミューテックスで排他する
+osStatus eth_filter_add(const uint8_t *p_addr)
+{
+	ETH_CB *this = get_myself();
+	osStatus ercd;
+	
+	// パラメータチェック
+	if (p_addr == NULL) {
+		return osErrorParameter;
+	}
+	
+	// 初期化していない場合はエラー
+	if (this->status == ST_INIT) {
+		return osErrorResource;
+	}
+	
+	osMutexWait(this->filter.mutex, osWaitForever);
+	ercd = filter_add(p_addr);
+	osMutexRelease(this->filter.mutex);
+	
+	return ercd;
+}
+
+// 受信アドレス削除
+osStatus eth_filter_del(const uint8_t *p_addr)
+{
+	ETH_CB *this = get_myself();
+	osStatus ercd;
+	
+	// パラメータチェック
+	if (p_addr == NULL) {
+		return osErrorParameter;
+	}
+	
+	// 初期化していない場合はエラー
+	if (this->status == ST_INIT) {
+		return osErrorResource;
+	}
+	
+	osMutexWait(this->filter.mutex, osWaitForever);
+	ercd = filter_del(p_addr);
+	osMutexRelease(this->filter.mutex);
+	
+	return ercd;
+}
+
+// 受信アドレス一覧取得
+uint32_t eth_filter_get(ETH_FILTER_INFO *p_info, uint32_t num)
+{
+	ETH_CB *this = get_myself();
+	FILTER_CB *p_filter = &(this->filter);
+	FILTER_ENTRY *p_entry;
+	uint32_t cnt = 0;
+	uint8_t i;
+	
+	// パラメータチェック
+	if (p_info == NULL) {
+		return 0;
+	}
+	
+	// 初期化していない場合はエラー
+	if (this->status == ST_INIT) {
+		return 0;
+	}
+	
+	osMutexWait(p_filter->mutex, osWaitForever);
+	for (i = 0; (i < FILTER_ADDR_NUM) && (cnt < num); i++) {
+		p_entry = &(p_filter->entry[i]);
+		if (p_entry->ref == 0) {
+			continue;
+		}
+		memcpy(p_info[cnt].addr, p_entry->addr, 6);
+		p_info[cnt].slot = p_entry->slot;
+		p_info[cnt].ref = p_entry->ref;
+		p_info[cnt].hash_bit = filter_hash(p_entry->addr);
+		cnt++;
+	}
+	osMutexRelease(p_filter->mutex);
+	
+	return cnt;
+}
@@ -14,13 +14,147 @@ typedef enum {
 	COM_MODE_MAX
 } COM_MODE;
 
+// DMA動作モード (0はデフォルト)
 typedef struct {
-	COM_MODE mode;	// 通信方式
+	uint8_t		tx_sf;		// 送信ストアアンドフォワード (0:スレッショルドで送信開始(カットスルー))
+	uint8_t		rx_sf;		// 受信ストアアンドフォワード (0:スレッショルドでDMA転送開始)
+	uint8_t		osf;		// 送信ステータスを待たずに次のフレームを読み出す (Operate on Second Frame)
+	uint8_t		pbl;		// バースト長[beat] (1,2,4,8,16,32、0:16)
+	uint16_t	tx_thresh;	// 送信スレッショルド[byte] (16,24,32,40,64,128,192,256、0:64)
+	uint16_t	rx_thresh;	// 受信スレッショルド[byte] (32,64,96,128、0:64)
+} ETH_DMA_PAR;
+
+// DMA統計
+typedef struct {
+	uint32_t	tx_underflow_cnt;	// 送信アンダーフロー回数
+	uint32_t	rx_overflow_cnt;	// 受信オーバーフロー回数
+	uint32_t	rx_missed_cnt;		// 取りこぼしたフレーム数
+	uint32_t	tx_err_cnt;			// 送信エラー数 (eth_send_nowait)
+} ETH_DMA_STAT;
+
+// ループバック
+typedef enum {
+	ETH_LOOPBACK_NONE = 0,	// なし
+	ETH_LOOPBACK_MAC,		// MAC内部
+	ETH_LOOPBACK_PHY,		// PHY (BASIC_CONTROLのループバック)
+	ETH_LOOPBACK_MAX
+} ETH_LOOPBACK;
+
+// 送信バッファリスト
+typedef struct {
+	uint8_t		*p_data;	// データ
+	uint32_t	size;		// サイズ
+} ETH_SG;
+
+// セグメンテーションオフロード
+typedef enum {
+	ETH_TSO_RAW = 0,	// ヘッダをそのまま複製
+	ETH_TSO_UDP,		// ETH + IPv4 + UDPヘッダ (全長、ID、UDP長、チェックサムを書き換える)
+	ETH_TSO_TYPE_MAX
+} ETH_TSO_TYPE;
+typedef struct {
+	ETH_TSO_TYPE	type;			// ヘッダ種別
+	uint16_t		mss;			// 1セグメントのペイロードサイズ (0は最大フレームに収まる最大値)
+	uint16_t		seq_offset;		// ヘッダ内の32bitシーケンス番号の位置 (0はなし)
+} ETH_TSO_PAR;
+
+typedef struct {
+	COM_MODE mode;		// 通信方式
+	ETH_DMA_PAR dma;	// DMA動作モード
 } ETH_OPEN;
 
-extern void eth_init(void);
+// 受信優先度キュー数
+#define ETH_PRIO_NUM	(4)
+
+// VLAN設定
+typedef struct {
+	uint16_t	vid;			// 受信するVID (0はVLANフィルタしない)
+	uint8_t		prio_map[8];	// PCPごとの優先度キュー (0～ETH_PRIO_NUM-1、大きいほど先に受信)
+} ETH_VLAN_PAR;
+
+// VLAN統計
+typedef struct {
+	uint32_t	rx_cnt[ETH_PRIO_NUM];	// 優先度キューごとの受信数
+	uint32_t	tagged_cnt;				// VLANタグ付きフレーム受信数
+	uint32_t	vid_drop_cnt;			// VIDが一致しないため破棄したフレーム数
+} ETH_VLAN_STAT;
+
+// フロー制御設定
+typedef struct {
+	uint8_t		tx_enable;		// 受信リングの使用数でPAUSEフレームを送信する
+	uint8_t		rx_enable;		// 受信したPAUSEフレームに従って送信を止める
+	uint16_t	pause_time;		// PAUSEフレームで通知する停止時間[512bit time]
+	uint8_t		high_thresh;	// PAUSE送信する受信待ちフレーム数 (受信リング + 優先度キュー)
+	uint8_t		low_thresh;		// 送信再開(停止時間0のPAUSE)させる受信待ちフレーム数
+} ETH_FC_PAR;
+
+// フロー制御統計
+typedef struct {
+	uint32_t	xoff_cnt;			// PAUSEフレーム送信数
+	uint32_t	xon_cnt;			// 送信再開(停止時間0のPAUSE)送信数
+	uint32_t	pause_us_total;		// 相手の送信を止めていた時間の合計[us]
+	uint32_t	pause_us_max;		// 相手の送信を止めていた時間の最大[us]
+	uint32_t	rx_pause_cnt;		// PAUSEフレーム受信数
+	uint32_t	rx_pause_quanta;	// 受信したPAUSEフレームの停止時間の合計[512bit time]
+	uint32_t	ring_max;			// 受信待ちフレーム数の最大
+	uint32_t	ring_full_cnt;		// 受信リングが一杯になった回数
+} ETH_FC_STAT;
+
+// タイムトリガ送信統計
+// (*) オフセットはターゲット時刻から送信要求(OWNセット)までの時間[ns]
+typedef struct {
+	uint32_t	cycle_cnt;		// 経過周期数
+	uint32_t	send_cnt;		// 送信フレーム数
+	uint32_t	idle_cnt;		// 送信フレームがなかった周期数
+	uint32_t	miss_cnt;		// スロットに間に合わなかった回数
+	uint32_t	err_cnt;		// 送信エラーになったフレーム数 (アンダーフロー、遅延など)
+	int32_t		offset_min;		// 送信オフセット最小値[ns]
+	int32_t		offset_max;		// 送信オフセット最大値[ns]
+	int32_t		offset_avg;		// 送信オフセット平均値[ns]
+	int32_t		offset_last;	// 直近周期の送信オフセット[ns]
+} ETH_TT_STAT;
+
+// 受信アドレスフィルタ情報
+#define ETH_FILTER_SLOT_HASH	(0xFF)		// ハッシュフィルタに登録
+typedef struct {
+	uint8_t		addr[6];	// MACアドレス
+	uint8_t		slot;		// 完全一致フィルタ番号(0～2 : MACA1～3) or ETH_FILTER_SLOT_HASH
+	uint8_t		ref;		// 参照カウント
+	uint8_t		hash_bit;	// ハッシュテーブルのビット番号
+} ETH_FILTER_INFO;
+
+extern osStatus eth_init(void);
+extern osStatus eth_phy_init(void);
 extern osStatus eth_open(ETH_OPEN *p_par);
 extern osStatus eth_send(uint8_t *p_data, uint32_t size);
+extern osStatus eth_send_sg(const ETH_SG *p_sg, uint32_t num);
+extern osStatus eth_send_nowait(uint8_t *p_data, uint32_t size);
+extern osStatus eth_send_tso(const uint8_t *p_hdr, uint32_t hdr_size, uint8_t *p_data, uint32_t size, const ETH_TSO_PAR *p_par);
+extern osStatus eth_tx_flush(uint32_t tmout);
+extern osStatus eth_send_vlan(uint8_t *p_data, uint32_t size, uint16_t tci);
+extern osStatus eth_send_pkt(PKT_BUF *p_pkt);
+extern int32_t eth_recv(uint8_t *p_data, uint32_t size, int32_t tmout);
+extern PKT_BUF* eth_recv_pkt(int32_t tmout);
+extern uint32_t eth_tx_csum_offload(void);
+extern void eth_get_mac_addr(uint8_t *p_addr);
+extern osStatus eth_fc_config(ETH_FC_PAR *p_par);
+extern osStatus eth_fc_get_stat(ETH_FC_STAT *p_stat);
+extern osStatus eth_vlan_config(ETH_VLAN_PAR *p_par);
+extern osStatus eth_vlan_get_stat(ETH_VLAN_STAT *p_stat);
+extern void eth_vlan_get_default_map(uint8_t *p_map);
+extern osStatus eth_loopback_config(ETH_LOOPBACK mode);
+extern ETH_LOOPBACK eth_loopback_get(void);
+extern osStatus eth_dma_config(ETH_DMA_PAR *p_par);
+extern osStatus eth_dma_get_stat(ETH_DMA_STAT *p_stat);
+extern void eth_dma_clear_stat(void);
+extern osStatus eth_tt_start(uint32_t period_ns);
+extern osStatus eth_tt_stop(void);
+extern osStatus eth_tt_queue(uint8_t *p_data, uint32_t size);
+extern osStatus eth_tt_get_stat(ETH_TT_STAT *p_stat);
+extern uint32_t eth_tt_get_log(int32_t *p_buf, uint32_t num);
+extern osStatus eth_filter_add(const uint8_t *p_addr);
+extern osStatus eth_filter_del(const uint8_t *p_addr);
+extern uint32_t eth_filter_get(ETH_FILTER_INFO *p_info, uint32_t num);
 
 #endif /* SRC_PERI_ETH_H_ */
  
\ No newline at end of file
@@ -0,0 +1,330 @@
+/*
+ * hrt.c
+ *
+ *  Created on: 2026/3/28
+ *      Author: user
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "stm32f7xx.h"
+#include "stm32f7xx_hal_rcc.h"
+#include "cmsis_os.h"
+#include "console.h"
+#include "mem_plan.h"
+#include "os_sig.h"
+#include "trace.h"
+#include "os_stat.h"
+#include "hrt.h"
+
+// µs分解能のタイマサービス (TIM5、32bit)
+// ・TIM5を1MHzでフリーランさせ、カウンタ値をそのままµsの時刻として使う (約71分で一周)
+// ・コンペアチャネル4本をワンショット/周期のタイマとして使う (周期はコンペア値を足していくのでずれが積もらない)
+// ・nsの待ちはカウンタの分解能が足りないのでDWTのサイクルカウンタで待つ
+// (*) 時刻の差分は一周より短い区間でしか正しくないので、71分以上のタイムアウトには使わないこと
+
+// マクロ
+#define HRT_CLK					(1000000)	// カウントクロック[Hz]
+#define HRT_IRQ_PRIORITY		(5)			// 割り込み優先度 (FreeRTOSのAPIを呼べる範囲)
+#define HRT_BENCH_NUM_MAX		(10000)		// ベンチマークの最大回数
+#define HRT_BENCH_PERIOD_MAX	(1000000)	// ベンチマークの最大周期[us] (サイクルカウンタが一周しない範囲)
+#define HRT_BENCH_EVT			(1UL << 0)
+
+// レジスタ
+#define get_ccr(ch)				((&(TIM5->CCR1))[ch])
+#define HRT_SR_CCIF(ch)			(TIM_SR_CC1IF << (ch))
+#define HRT_DIER_CCIE(ch)		(TIM_DIER_CC1IE << (ch))
+#define HRT_EGR_CCG(ch)			(TIM_EGR_CC1G << (ch))
+
+// 状態
+#define ST_IDLE		(0)		// 停止中
+#define ST_RUN		(1)		// 動作中
+
+// チャネル制御ブロック
+typedef struct {
+	volatile uint32_t	status;		// 状態
+	HRT_MODE			mode;		// 動作モード
+	uint32_t			period;		// 周期[us]
+	HRT_CALLBACK		cb;			// コールバック
+	void				*p_ctx;		// コールバックのコンテキスト
+} HRT_CH_CB;
+
+// 制御ブロック
+typedef struct {
+	uint32_t			init;				// 初期化済み
+	HRT_CH_CB			ch[HRT_CH_MAX];		// チャネル
+} HRT_CB;
+static HRT_CB hrt_cb MEM_PLAN(app);
+#define get_myself() (&hrt_cb)
+
+// ベンチマーク制御ブロック
+typedef struct {
+	OS_SIG_WAITER		waiter;		// 待ち合わせ情報
+	uint32_t			num;		// 計測回数
+	volatile uint32_t	cnt;		// コールバック回数
+	uint32_t			last_cyc;	// 前回のサイクルカウンタ
+	uint32_t			min;		// 間隔の最小[cycle]
+	uint32_t			max;		// 間隔の最大[cycle]
+	uint64_t			sum;		// 間隔の合計[cycle]
+} HRT_BENCH_CB;
+static HRT_BENCH_CB hrt_bench_cb MEM_PLAN(app);
+#define get_bench() (&hrt_bench_cb)
+
+// タイマのクロック (APB1のプリスケーラが1以外ならPCLK1の2倍)
+static uint32_t hrt_get_tim_clk(void)
+{
+	uint32_t clk = HAL_RCC_GetPCLK1Freq();
+	
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+		clk *= 2;
+	}
+	
+	return clk;
+}
+
+// 割り込み処理
+static void hrt_irq_handler(void)
+{
+	HRT_CB *this = get_myself();
+	HRT_CH_CB *p_ch;
+	uint32_t sr;
+	uint32_t ch;
+	
+	// 有効なチャネルの要因だけクリア
+	sr = TIM5->SR & TIM5->DIER;
+	TIM5->SR = ~sr;
+	
+	for (ch = 0; ch < HRT_CH_MAX; ch++) {
+		if ((sr & HRT_SR_CCIF(ch)) == 0) {
+			continue;
+		}
+		p_ch = &(this->ch[ch]);
+		if (p_ch->mode == HRT_MODE_PERIODIC) {
+			// 次の周期 (処理が遅れてすでに過ぎていたら、一周待たないように今から1周期後にする)
+			get_ccr(ch) += p_ch->period;
+			if ((int32_t)(get_ccr(ch) - TIM5->CNT) <= 0) {
+				get_ccr(ch) = TIM5->CNT + p_ch->period;
+			}
+		} else {
+			TIM5->DIER &= ~HRT_DIER_CCIE(ch);
+			p_ch->status = ST_IDLE;
+		}
+		if (p_ch->cb != NULL) {
+			p_ch->cb((HRT_CH)ch, p_ch->p_ctx);
+		}
+	}
+}
+
+// TIM5割り込みハンドラ
+void TIM5_IRQHandler(void)
+{
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_HRT);
+	
+	hrt_irq_handler();
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_HRT);
+}
+
+// 初期化 (ほかのドライバのタイムアウトに使うので最初に呼ぶこと)
+osStatus hrt_init(void)
+{
+	HRT_CB *this = get_myself();
+	
+	memset(this, 0, sizeof(HRT_CB));
+	
+	// TIM5 (1MHz、フリーラン)
+	__HAL_RCC_TIM5_CLK_ENABLE();
+	TIM5->CR1 = 0;
+	TIM5->PSC = (hrt_get_tim_clk() / HRT_CLK) - 1;
+	TIM5->ARR = 0xFFFFFFFF;
+	TIM5->CNT = 0;
+	TIM5->EGR = TIM_EGR_UG;		// PSCを反映
+	TIM5->SR = 0;
+	TIM5->DIER = 0;
+	TIM5->CR1 = TIM_CR1_CEN;
+	
+	// 割り込み有効
+	HAL_NVIC_SetPriority(TIM5_IRQn, HRT_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(TIM5_IRQn);
+	
+	this->init = 1;
+	
+	return osOK;
+}
+
+// 現在時刻[us]
+uint32_t hrt_get_us(void)
+{
+	return TIM5->CNT;
+}
+
+// startからの経過時間[us]
+uint32_t hrt_elapsed_us(uint32_t start)
+{
+	return TIM5->CNT - start;
+}
+
+// µs待ち (最低us待つ)
+void hrt_delay_us(uint32_t us)
+{
+	uint32_t start = TIM5->CNT;
+	
+	// 呼んだ時点のカウントの途中から数えるので1カウント多く待つ
+	while ((TIM5->CNT - start) <= us) {
+		;
+	}
+}
+
+// ns待ち (CPUクロックの分解能)
+void hrt_delay_ns(uint32_t ns)
+{
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cyc = (uint32_t)(((uint64_t)ns * SystemCoreClock) / 1000000000ULL);
+	
+	while ((DWT->CYCCNT - start) < cyc) {
+		;
+	}
+}
+
+// タイマ開始 (us後にコールバック、周期モードならus周期で繰り返す)
+osStatus hrt_start(HRT_CH ch, HRT_MODE mode, uint32_t us, HRT_CALLBACK cb, void* p_ctx)
+{
+	HRT_CB *this = get_myself();
+	HRT_CH_CB *p_ch;
+	uint32_t primask;
+	
+	// パラメータチェック
+	if ((ch >= HRT_CH_MAX) || (mode >= HRT_MODE_MAX) || (us == 0) || (us >= 0x80000000)) {
+		return osErrorParameter;
+	}
+	if (!this->init) {
+		return osErrorResource;
+	}
+	
+	p_ch = &(this->ch[ch]);
+	if (p_ch->status != ST_IDLE) {
+		return osErrorResource;
+	}
+	
+	p_ch->mode = mode;
+	p_ch->period = us;
+	p_ch->cb = cb;
+	p_ch->p_ctx = p_ctx;
+	p_ch->status = ST_RUN;
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	get_ccr(ch) = TIM5->CNT + us;
+	TIM5->SR = ~HRT_SR_CCIF(ch);
+	TIM5->DIER |= HRT_DIER_CCIE(ch);
+	// 設定中にカウンタが追い越していたら (一致を逃すと一周待つので) すぐに発生させる
+	if ((int32_t)(get_ccr(ch) - TIM5->CNT) <= 0) {
+		TIM5->EGR = HRT_EGR_CCG(ch);
+	}
+	__set_PRIMASK(primask);
+	
+	return osOK;
+}
+
+// タイマ停止
+osStatus hrt_stop(HRT_CH ch)
+{
+	HRT_CB *this = get_myself();
+	uint32_t primask;
+	
+	// パラメータチェック
+	if (ch >= HRT_CH_MAX) {
+		return osErrorParameter;
+	}
+	
+	primask = __get_PRIMASK();
+	__disable_irq();
+	TIM5->DIER &= ~HRT_DIER_CCIE(ch);
+	TIM5->SR = ~HRT_SR_CCIF(ch);
+	this->ch[ch].status = ST_IDLE;
+	__set_PRIMASK(primask);
+	
+	return osOK;
+}
+
+// ベンチマークのコールバック (前回からの間隔を集計)
+static void hrt_bench_callback(HRT_CH ch, void* p_ctx)
+{
+	HRT_BENCH_CB *p_bench = (HRT_BENCH_CB*)p_ctx;
+	uint32_t cyc = DWT->CYCCNT;
+	uint32_t diff;
+	
+	if (p_bench->cnt > 0) {
+		diff = cyc - p_bench->last_cyc;
+		if (diff < p_bench->min) {
+			p_bench->min = diff;
+		}
+		if (diff > p_bench->max) {
+			p_bench->max = diff;
+		}
+		p_bench->sum += diff;
+	}
+	p_bench->last_cyc = cyc;
+	
+	if (++p_bench->cnt > p_bench->num) {
+		hrt_stop(ch);
+		os_sig_set(&(p_bench->waiter), HRT_BENCH_EVT);
+	}
+}
+
+// 周期コールバックの間隔を測るコマンド
+// hrt_bench <period[us]> [num]
+static void hrt_bench_cmd(int argc, char *argv[])
+{
+	HRT_BENCH_CB *p_bench = get_bench();
+	uint32_t period;
+	uint32_t num = 1000;
+	uint32_t cyc_per_us = SystemCoreClock / 1000000;
+	uint32_t tmout;
+	osStatus ercd;
+	
+	if (argc < 2) {
+		console_printf("hrt_bench <period(1-%u)[us]> [num(1-%u)]\n", HRT_BENCH_PERIOD_MAX, HRT_BENCH_NUM_MAX);
+		return;
+	}
+	period = atoi(argv[1]);
+	if (argc >= 3) {
+		num = atoi(argv[2]);
+	}
+	if ((period == 0) || (period > HRT_BENCH_PERIOD_MAX) || (num == 0) || (num > HRT_BENCH_NUM_MAX)) {
+		console_printf("invalid parameter\n");
+		return;
+	}
+	
+	memset(p_bench, 0, sizeof(HRT_BENCH_CB));
+	p_bench->num = num;
+	p_bench->min = 0xFFFFFFFF;
+	os_sig_prepare(&(p_bench->waiter));
+	
+	if ((ercd = hrt_start(HRT_CH_4, HRT_MODE_PERIODIC, period, hrt_bench_callback, p_bench)) != osOK) {
+		console_printf("hrt_start error %d\n", ercd);
+		return;
+	}
+	
+	// 全部終わるまで待つ (余裕を見て2倍+1秒)
+	tmout = (uint32_t)(((uint64_t)period * (num + 1) * 2) / 1000) + 1000;
+	if ((os_sig_wait(&(p_bench->waiter), HRT_BENCH_EVT, tmout) & HRT_BENCH_EVT) == 0) {
+		hrt_stop(HRT_CH_4);
+		console_printf("timeout (%u callbacks)\n", p_bench->cnt);
+		return;
+	}
+	
+	console_printf("period %u us x %u : avg %u ns, min %u ns, max %u ns\n", period, num,
+	               (uint32_t)((p_bench->sum * 1000) / ((uint64_t)num * cyc_per_us)),
+	               (uint32_t)(((uint64_t)p_bench->min * 1000) / cyc_per_us), (uint32_t)(((uint64_t)p_bench->max * 1000) / cyc_per_us));
+}
+
+// コマンド設定関数
+void hrt_set_cmd(void)
+{
+	COMMAND_INFO cmd;
+	
+	// コマンドの設定
+	cmd.input = "hrt_bench";
+	cmd.func = hrt_bench_cmd;
+	console_set_command(&cmd);
+}
@@ -0,0 +1,39 @@
+/*
+ * hrt.h
+ *
+ *  Created on: 2026/3/28
+ *      Author: user
+ */
+
+#ifndef PERI_HRT_H_
+#define PERI_HRT_H_
+
+// チャネル (TIM5のコンペアチャネル)
+typedef enum {
+	HRT_CH_1 = 0,
+	HRT_CH_2,
+	HRT_CH_3,
+	HRT_CH_4,
+	HRT_CH_MAX,
+} HRT_CH;
+
+// 動作モード
+typedef enum {
+	HRT_MODE_ONESHOT = 0,	// 1回だけ
+	HRT_MODE_PERIODIC,		// 周期
+	HRT_MODE_MAX,
+} HRT_MODE;
+
+// コールバック (割り込みコンテキストで呼ばれる、FromISRのAPIは使える)
+typedef void (*HRT_CALLBACK)(HRT_CH ch, void* p_ctx);
+
+extern osStatus hrt_init(void);
+extern uint32_t hrt_get_us(void);
+extern uint32_t hrt_elapsed_us(uint32_t start);
+extern void hrt_delay_us(uint32_t us);
+extern void hrt_delay_ns(uint32_t ns);
+extern osStatus hrt_start(HRT_CH ch, HRT_MODE mode, uint32_t us, HRT_CALLBACK cb, void* p_ctx);
+extern osStatus hrt_stop(HRT_CH ch);
+extern void hrt_set_cmd(void);
+
+#endif /* PERI_HRT_H_ */
@@ -9,6 +9,8 @@
 #include "stm32f7xx_hal_rcc.h"
 #include "cmsis_os.h"
 #include "iodefine.h"
+#include "trace.h"
+#include "os_stat.h"
 #include "usart.h"
 
 
@@ -146,11 +148,19 @@ void usart_common_handler(USART_CH ch)
 // 割り込みハンドラ
 void USART1_IRQHandler(void)
 {
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_USART);
+	
 	usart_common_handler(USART_CH_1);
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_USART);
 }
 void USART2_IRQHandler(void)
 {
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_USART);
+	
 	usart_common_handler(USART_CH_2);
+	
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_USART);
 }
 //void USART3_IRQHandler(void)
 //{
@@ -24,6 +24,8 @@
 #include "task.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "trace.h"
+#include "os_stat.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -160,6 +162,7 @@ void DebugMon_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
+	OS_STAT_ISR_ENTER(OS_STAT_ISR_SYSTICK);
 
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
@@ -172,6 +175,7 @@ void SysTick_Handler(void)
   }
 #endif /* INCLUDE_xTaskGetSchedulerState */
   /* USER CODE BEGIN SysTick_IRQn 1 */
+	OS_STAT_ISR_EXIT(OS_STAT_ISR_SYSTICK);
 
   /* USER CODE END SysTick_IRQn 1 */
 }
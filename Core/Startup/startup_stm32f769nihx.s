@@ -43,13 +43,36 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* init tables (copy: load, start, end / zero: start, end). defined in linker script */
+.word  __copy_table_start__
+.word  __copy_table_end__
+.word  __zero_table_start__
+.word  __zero_table_end__
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
+/* 1: copy/zero with unrolled LDRD/STRD (32 bytes per loop), 0: one word per loop.
+   Build with -DSTARTUP_FAST_INIT=0 to compare the startup cycles (boot command). */
+#ifndef STARTUP_FAST_INIT
+#define STARTUP_FAST_INIT 1
+#endif
+
+/* DWT cycle counter (enabled by dwt_init(), only read here) */
+#define DWT_CYCCNT  0xE0001004
+
+/* startup_cyc[] index (see boot.c) */
+#define CYC_RESET   0
+#define CYC_SYSINIT 4
+#define CYC_COPY    8
+#define CYC_ZERO    12
+#define CYC_MAIN    16
+
 /**
  * @brief  This is the code that gets called when the processor first
  *          starts execution following a reset event. Only the absolutely
  *          necessary set is performed, after which the application
  *          supplied main() routine is called. 
+ *          The cycle count of each step is recorded in startup_cyc[]
+ *          (placed in .noinit so that the zero fill does not clear it).
  * @param  None
  * @retval : None
 */
@@ -59,43 +82,92 @@ defined in linker script */
   .type  Reset_Handler, %function
 Reset_Handler:  
   ldr   sp, =_estack      /* set stack pointer */
+
+/* Enable the cycle counter (dwt.c, uses no .data/.bss).
+   r5 = &CYCCNT, r6 = startup_cyc (kept until main) */
+  bl  dwt_init
+  ldr   r5, =DWT_CYCCNT
+  ldr   r6, =startup_cyc
+  ldr   r1, [r5]
+  str   r1, [r6, #CYC_RESET]
  
 /* Call the clock system initialization function.*/
   bl  SystemInit   
-
-/* Copy the data segment initializers from flash to SRAM */  
-  ldr r0, =_sdata
-  ldr r1, =_edata
-  ldr r2, =_sidata
-  movs r3, #0
-  b LoopCopyDataInit
-
-CopyDataInit:
-  ldr r4, [r2, r3]
-  str r4, [r0, r3]
-  adds r3, r3, #4
-
-LoopCopyDataInit:
-  adds r4, r0, r3
-  cmp r4, r1
-  bcc CopyDataInit
-  
-/* Zero fill the bss segment. */
-  ldr r2, =_sbss
-  ldr r4, =_ebss
-  movs r3, #0
-  b LoopFillZerobss
-
-FillZerobss:
-  str  r3, [r2]
-  adds r2, r2, #4
-
-LoopFillZerobss:
-  cmp r2, r4
-  bcc FillZerobss
+  ldr   r1, [r5]
+  str   r1, [r6, #CYC_SYSINIT]
+
+/* Copy the initializers of each copy table entry (.data, .itcm_text) */
+  ldr   r7, =__copy_table_start__
+  ldr   r8, =__copy_table_end__
+CopyTableLoop:
+  cmp   r7, r8
+  bcs   CopyTableDone
+  ldmia r7!, {r0, r1, r2}   /* r0 = load address, r1 = start, r2 = end */
+  cmp   r0, r1
+  beq   CopyTableLoop       /* already in place (RAM build) */
+#if STARTUP_FAST_INIT
+  b     CopyCheck32
+CopyLoop32:
+  ldrd  r3, r4, [r0, #0]
+  ldrd  r9, r10, [r0, #8]
+  strd  r3, r4, [r1, #0]
+  strd  r9, r10, [r1, #8]
+  ldrd  r3, r4, [r0, #16]
+  ldrd  r9, r10, [r0, #24]
+  strd  r3, r4, [r1, #16]
+  strd  r9, r10, [r1, #24]
+  adds  r0, r0, #32
+  adds  r1, r1, #32
+CopyCheck32:
+  subs  r3, r2, r1
+  cmp   r3, #32
+  bhs   CopyLoop32
+#endif
+CopyWordCheck:
+  cmp   r1, r2
+  bhs   CopyTableLoop
+  ldr   r3, [r0], #4
+  str   r3, [r1], #4
+  b     CopyWordCheck
+CopyTableDone:
+  ldr   r1, [r5]
+  str   r1, [r6, #CYC_COPY]
+
+/* Zero fill each zero table entry (.bss, .noinit is skipped) */
+  ldr   r7, =__zero_table_start__
+  ldr   r8, =__zero_table_end__
+  movs  r3, #0
+  movs  r4, #0
+ZeroTableLoop:
+  cmp   r7, r8
+  bcs   ZeroTableDone
+  ldmia r7!, {r1, r2}       /* r1 = start, r2 = end */
+#if STARTUP_FAST_INIT
+  b     ZeroCheck32
+ZeroLoop32:
+  strd  r3, r4, [r1, #0]
+  strd  r3, r4, [r1, #8]
+  strd  r3, r4, [r1, #16]
+  strd  r3, r4, [r1, #24]
+  adds  r1, r1, #32
+ZeroCheck32:
+  subs  r0, r2, r1
+  cmp   r0, #32
+  bhs   ZeroLoop32
+#endif
+ZeroWordCheck:
+  cmp   r1, r2
+  bhs   ZeroTableLoop
+  str   r3, [r1], #4
+  b     ZeroWordCheck
+ZeroTableDone:
+  ldr   r1, [r5]
+  str   r1, [r6, #CYC_ZERO]
    
 /* Call static constructors */
     bl __libc_init_array
+  ldr   r1, [r5]
+  str   r1, [r6, #CYC_MAIN]
 /* Call the application's entry point.*/
   bl  main
   bx  lr    
@@ -1,45 +0,0 @@
-################################################################################
-# Automatically-generated file. Do not edit!
-# Toolchain: GNU Tools for STM32 (13.3.rel1)
-################################################################################
-
-# Add inputs and outputs from these tool invocations to the build variables 
-C_SRCS += \
-../Middlewares/Third_Party/FreeRTOS/Source/croutine.c \
-../Middlewares/Third_Party/FreeRTOS/Source/event_groups.c \
-../Middlewares/Third_Party/FreeRTOS/Source/list.c \
-../Middlewares/Third_Party/FreeRTOS/Source/queue.c \
-../Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.c \
-../Middlewares/Third_Party/FreeRTOS/Source/tasks.c \
-../Middlewares/Third_Party/FreeRTOS/Source/timers.c 
-
-OBJS += \
-./Middlewares/Third_Party/FreeRTOS/Source/croutine.o \
-./Middlewares/Third_Party/FreeRTOS/Source/event_groups.o \
-./Middlewares/Third_Party/FreeRTOS/Source/list.o \
-./Middlewares/Third_Party/FreeRTOS/Source/queue.o \
-./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.o \
-./Middlewares/Third_Party/FreeRTOS/Source/tasks.o \
-./Middlewares/Third_Party/FreeRTOS/Source/timers.o 
-
-C_DEPS += \
-./Middlewares/Third_Party/FreeRTOS/Source/croutine.d \
-./Middlewares/Third_Party/FreeRTOS/Source/event_groups.d \
-./Middlewares/Third_Party/FreeRTOS/Source/list.d \
-./Middlewares/Third_Party/FreeRTOS/Source/queue.d \
-./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.d \
-./Middlewares/Third_Party/FreeRTOS/Source/tasks.d \
-./Middlewares/Third_Party/FreeRTOS/Source/timers.d 
-
-
-# Each subdirectory must supply rules for building sources it contributes
-Middlewares/Third_Party/FreeRTOS/Source/%.o Middlewares/Third_Party/FreeRTOS/Source/%.su Middlewares/Third_Party/FreeRTOS/Source/%.cyclo: ../Middlewares/Third_Party/FreeRTOS/Source/%.c Middlewares/Third_Party/FreeRTOS/Source/subdir.mk
-	arm-none-eabi-gcc "$<" -mcpu=cortex-m7 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F769xx -c -I../Core/Inc -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/app" -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/drv" -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/peri" -I../Drivers/STM32F7xx_HAL_Driver/Inc -I../Drivers/STM32F7xx_HAL_Driver/Inc/Legacy -I../Drivers/CMSIS/Device/ST/STM32F7xx/Include -I../Drivers/CMSIS/Include -I../Middlewares/Third_Party/FreeRTOS/Source/include -I../Middlewares/Third_Party/FreeRTOS/Source/CMSIS_RTOS -I../Middlewares/Third_Party/FreeRTOS/Source/portable/GCC/ARM_CM7/r0p1 -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv5-d16 -mfloat-abi=hard -mthumb -o "$@"
-
-clean: clean-Middlewares-2f-Third_Party-2f-FreeRTOS-2f-Source
-
-clean-Middlewares-2f-Third_Party-2f-FreeRTOS-2f-Source:
-	-$(RM) ./Middlewares/Third_Party/FreeRTOS/Source/croutine.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/croutine.d ./Middlewares/Third_Party/FreeRTOS/Source/croutine.o ./Middlewares/Third_Party/FreeRTOS/Source/croutine.su ./Middlewares/Third_Party/FreeRTOS/Source/event_groups.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/event_groups.d ./Middlewares/Third_Party/FreeRTOS/Source/event_groups.o ./Middlewares/Third_Party/FreeRTOS/Source/event_groups.su ./Middlewares/Third_Party/FreeRTOS/Source/list.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/list.d ./Middlewares/Third_Party/FreeRTOS/Source/list.o ./Middlewares/Third_Party/FreeRTOS/Source/list.su ./Middlewares/Third_Party/FreeRTOS/Source/queue.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/queue.d ./Middlewares/Third_Party/FreeRTOS/Source/queue.o ./Middlewares/Third_Party/FreeRTOS/Source/queue.su ./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.d ./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.o ./Middlewares/Third_Party/FreeRTOS/Source/stream_buffer.su ./Middlewares/Third_Party/FreeRTOS/Source/tasks.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/tasks.d ./Middlewares/Third_Party/FreeRTOS/Source/tasks.o ./Middlewares/Third_Party/FreeRTOS/Source/tasks.su ./Middlewares/Third_Party/FreeRTOS/Source/timers.cyclo ./Middlewares/Third_Party/FreeRTOS/Source/timers.d ./Middlewares/Third_Party/FreeRTOS/Source/timers.o ./Middlewares/Third_Party/FreeRTOS/Source/timers.su
-
-.PHONY: clean-Middlewares-2f-Third_Party-2f-FreeRTOS-2f-Source
-
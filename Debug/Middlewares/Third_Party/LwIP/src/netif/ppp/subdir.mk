@@ -1,99 +0,0 @@
-################################################################################
-# Automatically-generated file. Do not edit!
-# Toolchain: GNU Tools for STM32 (13.3.rel1)
-################################################################################
-
-# Add inputs and outputs from these tool invocations to the build variables 
-C_SRCS += \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/auth.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/demand.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/eap.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/magic.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/upap.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/utils.c \
-../Middlewares/Third_Party/LwIP/src/netif/ppp/vj.c 
-
-OBJS += \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.o \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.o 
-
-C_DEPS += \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.d \
-./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.d 
-
-
-# Each subdirectory must supply rules for building sources it contributes
-Middlewares/Third_Party/LwIP/src/netif/ppp/%.o Middlewares/Third_Party/LwIP/src/netif/ppp/%.su Middlewares/Third_Party/LwIP/src/netif/ppp/%.cyclo: ../Middlewares/Third_Party/LwIP/src/netif/ppp/%.c Middlewares/Third_Party/LwIP/src/netif/ppp/subdir.mk
-	arm-none-eabi-gcc "$<" -mcpu=cortex-m7 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F769xx -c -I../Core/Inc -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/app" -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/drv" -I"C:/Users/user/STM32CubeIDE/work/Eth/Core/Src/peri" -I../Drivers/STM32F7xx_HAL_Driver/Inc -I../Drivers/STM32F7xx_HAL_Driver/Inc/Legacy -I../Drivers/CMSIS/Device/ST/STM32F7xx/Include -I../Drivers/CMSIS/Include -I../Middlewares/Third_Party/FreeRTOS/Source/include -I../Middlewares/Third_Party/FreeRTOS/Source/CMSIS_RTOS -I../Middlewares/Third_Party/FreeRTOS/Source/portable/GCC/ARM_CM7/r0p1 -I../LWIP/App -I../LWIP/Target -I../Middlewares/Third_Party/LwIP/src/include -I../Middlewares/Third_Party/LwIP/system -I../Drivers/BSP/Components/lan8742 -I../Middlewares/Third_Party/LwIP/src/include/netif/ppp -I../Middlewares/Third_Party/LwIP/src/include/lwip -I../Middlewares/Third_Party/LwIP/src/include/lwip/apps -I../Middlewares/Third_Party/LwIP/src/include/lwip/priv -I../Middlewares/Third_Party/LwIP/src/include/lwip/prot -I../Middlewares/Third_Party/LwIP/src/include/netif -I../Middlewares/Third_Party/LwIP/src/include/compat/posix -I../Middlewares/Third_Party/LwIP/src/include/compat/posix/arpa -I../Middlewares/Third_Party/LwIP/src/include/compat/posix/net -I../Middlewares/Third_Party/LwIP/src/include/compat/posix/sys -I../Middlewares/Third_Party/LwIP/src/include/compat/stdc -I../Middlewares/Third_Party/LwIP/system/arch -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv5-d16 -mfloat-abi=hard -mthumb -o "$@"
-
-clean: clean-Middlewares-2f-Third_Party-2f-LwIP-2f-src-2f-netif-2f-ppp
-
-clean-Middlewares-2f-Third_Party-2f-LwIP-2f-src-2f-netif-2f-ppp:
-	-$(RM) ./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/auth.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/ccp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-md5.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap-new.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/chap_ms.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/demand.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/eap.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/ecp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/eui64.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/fsm.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipcp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/ipv6cp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/lcp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/magic.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/mppe.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/multilink.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/ppp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppapi.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppcrypt.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppoe.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppol2tp.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/pppos.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/upap.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/utils.su ./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.cyclo ./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.d ./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.o ./Middlewares/Third_Party/LwIP/src/netif/ppp/vj.su
-
-.PHONY: clean-Middlewares-2f-Third_Party-2f-LwIP-2f-src-2f-netif-2f-ppp
-
@@ -0,0 +1,98 @@
+/*
+ * lwip.c
+ *
+ *  Created on: 2026/1/31
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "mem_plan.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "net.h"
+
+#ifdef NET_USE_LWIP
+#include "lwip/opt.h"
+#include "lwip/init.h"
+#include "lwip/netif.h"
+#include "lwip/tcpip.h"
+#include "ethernetif.h"
+
+#include "lwip.h"
+
+// 状態定義
+#define ST_INIT		(0)		// 初期状態
+#define ST_OPEN		(2)		// オープン状態
+
+// マクロ
+#define TCPIP_INIT_TMOUT	(1000)	// tcpipスレッド起動待ち[ms]
+
+// 制御ブロック
+typedef struct {
+	uint32_t		status;			// 状態
+	struct netif	netif;			// netif
+	osSemaphoreId	init_sem;		// tcpipスレッド起動待ち
+} LWIP_APP_CB;
+static LWIP_APP_CB lwip_app_cb MEM_PLAN(net);
+#define get_myself() (&lwip_app_cb)
+
+// tcpipスレッド起動完了
+static void lwip_app_tcpip_done(void *arg)
+{
+	LWIP_APP_CB *this = get_myself();
+	
+	osSemaphoreRelease(this->init_sem);
+}
+
+// オープン
+// (*) 事前にeth_open()しておくこと (チェックサム挿入はストア&フォワード送信時のみ有効)
+osStatus lwip_app_open(NET_PAR *p_par)
+{
+	LWIP_APP_CB *this = get_myself();
+	ip4_addr_t ip_addr;
+	ip4_addr_t netmask;
+	ip4_addr_t gateway;
+	
+	// パラメータチェック
+	if ((p_par == NULL) || (p_par->ip_addr == 0)) {
+		return osErrorParameter;
+	}
+	
+	// オープン済み
+	if (this->status == ST_OPEN) {
+		return osErrorResource;
+	}
+	
+	// tcpipスレッド起動
+	MEM_PLAN_SEMAPHORE(net, lwip_init);
+	if ((this->init_sem = osSemaphoreCreate(osSemaphore(lwip_init), 1)) == NULL) {
+		return osErrorOS;
+	}
+	osSemaphoreWait(this->init_sem, 0);
+	tcpip_init(lwip_app_tcpip_done, NULL);
+	if (osSemaphoreWait(this->init_sem, TCPIP_INIT_TMOUT) != osOK) {
+		return osErrorTimeoutResource;
+	}
+	
+	// netif登録 (NET_PARはホストバイトオーダー)
+	IP4_ADDR(&ip_addr, (p_par->ip_addr >> 24) & 0xFF, (p_par->ip_addr >> 16) & 0xFF, (p_par->ip_addr >> 8) & 0xFF, p_par->ip_addr & 0xFF);
+	IP4_ADDR(&netmask, (p_par->netmask >> 24) & 0xFF, (p_par->netmask >> 16) & 0xFF, (p_par->netmask >> 8) & 0xFF, p_par->netmask & 0xFF);
+	IP4_ADDR(&gateway, (p_par->gateway >> 24) & 0xFF, (p_par->gateway >> 16) & 0xFF, (p_par->gateway >> 8) & 0xFF, p_par->gateway & 0xFF);
+	
+	LOCK_TCPIP_CORE();
+	if (netif_add(&(this->netif), &ip_addr, &netmask, &gateway, NULL, ethernetif_init, tcpip_input) == NULL) {
+		UNLOCK_TCPIP_CORE();
+		return osErrorOS;
+	}
+	netif_set_default(&(this->netif));
+	netif_set_up(&(this->netif));
+	UNLOCK_TCPIP_CORE();
+	
+	// 状態更新
+	this->status = ST_OPEN;
+	
+	return osOK;
+}
+
+#endif /* NET_USE_LWIP */
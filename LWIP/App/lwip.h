@@ -0,0 +1,13 @@
+/*
+ * lwip.h
+ *
+ *  Created on: 2026/1/31
+ *      Author: user
+ */
+
+#ifndef LWIP_APP_LWIP_H_
+#define LWIP_APP_LWIP_H_
+
+extern osStatus lwip_app_open(NET_PAR *p_par);
+
+#endif /* LWIP_APP_LWIP_H_ */
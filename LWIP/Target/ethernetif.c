@@ -0,0 +1,196 @@
+/*
+ * ethernetif.c
+ *
+ *  Created on: 2026/1/31
+ *      Author: user
+ */
+#include <string.h>
+#include "stm32f7xx.h"
+#include "cmsis_os.h"
+#include "mem_plan.h"
+#include "pkt_buf.h"
+#include "eth.h"
+#include "net.h"
+
+#ifdef NET_USE_LWIP
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+#include "lwip/memp.h"
+#include "lwip/netif.h"
+#include "lwip/etharp.h"
+#include "netif/ethernet.h"
+
+#include "ethernetif.h"
+
+// peri/eth.cをlwIPのnetifにする
+// 受信 : パケットバッファをカスタムpbufでくるんで渡す (pbuf解放時にpkt_free())
+// 送信 : pbufチェインをeth_send_sg()でそのままディスクリプタに設定する
+
+// マクロ
+#define IFNAME0				's'
+#define IFNAME1				't'
+#define ETHIF_MTU			(1500)
+#define ETHIF_SG_NUM		(8)			// 1フレームのpbuf数の最大 (超える場合はコピーして送る)
+#define ETHIF_RX_STACK		(512)		// 受信スレッドのスタックサイズ
+
+// 受信用カスタムpbuf
+typedef struct {
+	struct pbuf_custom	pc;			// lwIPのカスタムpbuf (先頭に置くこと)
+	PKT_BUF				*p_pkt;		// 受信したパケットバッファ
+} RX_PBUF;
+LWIP_MEMPOOL_DECLARE(ETHIF_RX_POOL, PKT_BUF_NUM, sizeof(RX_PBUF), "ethif rx pbuf");
+
+// 制御ブロック
+typedef struct {
+	struct netif		*netif;			// netif
+	osThreadId			rx_thread_id;	// 受信スレッド
+	ETHERNETIF_STAT		stat;			// 統計
+} ETHERNETIF_CB;
+static ETHERNETIF_CB ethernetif_cb MEM_PLAN(net);
+#define get_myself() (&ethernetif_cb)
+
+// カスタムpbufの解放 (lwIPのどのスレッドからも呼ばれる)
+static void ethernetif_rx_pbuf_free(struct pbuf *p)
+{
+	RX_PBUF *p_rx = (RX_PBUF*)p;
+	
+	pkt_free(p_rx->p_pkt);
+	LWIP_MEMPOOL_FREE(ETHIF_RX_POOL, p_rx);
+}
+
+// 受信フレームをpbufにする (コピーしない)
+static struct pbuf* ethernetif_rx_pbuf(PKT_BUF *p_pkt)
+{
+	RX_PBUF *p_rx;
+	
+	if ((p_rx = (RX_PBUF*)LWIP_MEMPOOL_ALLOC(ETHIF_RX_POOL)) == NULL) {
+		return NULL;
+	}
+	p_rx->pc.custom_free_function = ethernetif_rx_pbuf_free;
+	p_rx->p_pkt = p_pkt;
+	
+	return pbuf_alloced_custom(PBUF_RAW, (u16_t)p_pkt->len, PBUF_REF, &(p_rx->pc), p_pkt->p_data, PKT_DATA_SIZE);
+}
+
+// 受信スレッド
+static void ethernetif_rx_thread(void const *argument)
+{
+	ETHERNETIF_CB *this = get_myself();
+	struct netif *netif = (struct netif*)argument;
+	struct pbuf *p;
+	PKT_BUF *p_pkt;
+	
+	while (1) {
+		if ((p_pkt = eth_recv_pkt(-1)) == NULL) {
+			osDelay(10);
+			continue;
+		}
+		this->stat.rx_cnt++;
+		
+		// MACでチェックサムエラーを検出したフレームは捨てる (lwIPでは検証しない)
+		if ((p_pkt->flags & PKT_FLAG_CSUM_ERR) != 0) {
+			this->stat.rx_drop_cnt++;
+			pkt_free(p_pkt);
+			continue;
+		}
+		
+		if ((p = ethernetif_rx_pbuf(p_pkt)) == NULL) {
+			this->stat.rx_drop_cnt++;
+			pkt_free(p_pkt);
+			continue;
+		}
+		
+		// tcpipスレッドに渡す (失敗時はpbuf解放でパケットバッファも解放される)
+		if (netif->input(p, netif) != ERR_OK) {
+			this->stat.rx_drop_cnt++;
+			pbuf_free(p);
+		}
+	}
+}
+
+// 送信
+// pbufチェインをそのままバッファリストにする (ペイロードはコピーしない)
+static err_t ethernetif_output(struct netif *netif, struct pbuf *p)
+{
+	ETHERNETIF_CB *this = get_myself();
+	ETH_SG sg[ETHIF_SG_NUM];
+	struct pbuf *q;
+	PKT_BUF *p_pkt;
+	uint32_t num = 0;
+	osStatus ercd;
+	
+	for (q = p; q != NULL; q = q->next) {
+		if (q->len == 0) {
+			continue;
+		}
+		if (num >= ETHIF_SG_NUM) {
+			break;
+		}
+		sg[num].p_data = (uint8_t*)q->payload;
+		sg[num].size = q->len;
+		num++;
+	}
+	
+	// pbufが多すぎる場合は1つのバッファにまとめる
+	if (q != NULL) {
+		if ((p_pkt = pkt_alloc()) == NULL) {
+			this->stat.tx_err_cnt++;
+			return ERR_MEM;
+		}
+		pbuf_copy_partial(p, pkt_put(p_pkt, p->tot_len), p->tot_len, 0);
+		ercd = eth_send_pkt(p_pkt);
+		pkt_free(p_pkt);
+		this->stat.tx_copy_cnt++;
+	} else {
+		ercd = eth_send_sg(sg, num);
+	}
+	
+	if (ercd != osOK) {
+		this->stat.tx_err_cnt++;
+		return ERR_IF;
+	}
+	this->stat.tx_cnt++;
+	
+	return ERR_OK;
+}
+
+// netif初期化 (netif_add()から呼ばれる)
+// (*) 事前にeth_open()しておくこと (チェックサム挿入はストア&フォワード送信時のみ有効)
+err_t ethernetif_init(struct netif *netif)
+{
+	ETHERNETIF_CB *this = get_myself();
+	
+	// コンテキストクリア
+	memset(this, 0, sizeof(ETHERNETIF_CB));
+	this->netif = netif;
+	
+	LWIP_MEMPOOL_INIT(ETHIF_RX_POOL);
+	
+	// netif設定
+	netif->name[0] = IFNAME0;
+	netif->name[1] = IFNAME1;
+	netif->output = etharp_output;
+	netif->linkoutput = ethernetif_output;
+	netif->mtu = ETHIF_MTU;
+	netif->hwaddr_len = ETH_HWADDR_LEN;
+	eth_get_mac_addr(netif->hwaddr);
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+	
+	// 受信スレッド作成
+	MEM_PLAN_THREAD(net, ethif_rx, ethernetif_rx_thread, osPriorityAboveNormal, ETHIF_RX_STACK);
+	if ((this->rx_thread_id = osThreadCreate(osThread(ethif_rx), netif)) == NULL) {
+		return ERR_MEM;
+	}
+	
+	return ERR_OK;
+}
+
+// 統計取得
+void ethernetif_get_stat(ETHERNETIF_STAT *p_stat)
+{
+	ETHERNETIF_CB *this = get_myself();
+	
+	*p_stat = this->stat;
+}
+
+#endif /* NET_USE_LWIP */
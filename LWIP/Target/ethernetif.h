@@ -0,0 +1,23 @@
+/*
+ * ethernetif.h
+ *
+ *  Created on: 2026/1/31
+ *      Author: user
+ */
+
+#ifndef LWIP_TARGET_ETHERNETIF_H_
+#define LWIP_TARGET_ETHERNETIF_H_
+
+// 統計
+typedef struct {
+	uint32_t	rx_cnt;			// 受信フレーム数
+	uint32_t	rx_drop_cnt;	// 破棄した受信フレーム数 (pbuf不足、チェックサムエラー)
+	uint32_t	tx_cnt;			// 送信フレーム数
+	uint32_t	tx_copy_cnt;	// バッファ数が多すぎてコピーして送信した数
+	uint32_t	tx_err_cnt;		// 送信エラー数
+} ETHERNETIF_STAT;
+
+extern err_t ethernetif_init(struct netif *netif);
+extern void ethernetif_get_stat(ETHERNETIF_STAT *p_stat);
+
+#endif /* LWIP_TARGET_ETHERNETIF_H_ */
@@ -0,0 +1,114 @@
+/*
+ * lwipopts.h
+ *
+ *  Created on: 2026/1/31
+ *      Author: user
+ */
+
+#ifndef LWIP_TARGET_LWIPOPTS_H_
+#define LWIP_TARGET_LWIPOPTS_H_
+
+// TCPスループット重視の設定
+// ・受信はパケットバッファプール(PKT_BUF_NUM=32)をカスタムpbufでそのまま渡すので、
+//   受信ウィンドウはディスクリプタ(8)と余裕分を除いたバッファ数に合わせる
+// ・送信はpbufチェインをそのままディスクリプタに設定する (コピーしない)
+// ・チェックサムは送受信ともMACで処理する
+
+// OS
+#define NO_SYS							0
+#define SYS_LIGHTWEIGHT_PROT			1
+#define LWIP_TCPIP_CORE_LOCKING			1
+#define TCPIP_THREAD_NAME				"tcpip"
+#define TCPIP_THREAD_STACKSIZE			1024
+#define TCPIP_THREAD_PRIO				osPriorityHigh
+#define TCPIP_MBOX_SIZE					16
+#define DEFAULT_THREAD_STACKSIZE		512
+#define DEFAULT_THREAD_PRIO				osPriorityNormal
+#define DEFAULT_RAW_RECVMBOX_SIZE		8
+#define DEFAULT_UDP_RECVMBOX_SIZE		8
+#define DEFAULT_TCP_RECVMBOX_SIZE		16
+#define DEFAULT_ACCEPTMBOX_SIZE			4
+
+// メモリ
+#define MEM_ALIGNMENT					4
+#define MEM_SIZE						(16 * 1024)		// 送信セグメントのヘッダ、PBUF_RAM用
+#define MEMP_NUM_PBUF					32				// PBUF_REF/ROM (送信ペイロードの参照)
+#define MEMP_NUM_TCP_PCB				4
+#define MEMP_NUM_TCP_PCB_LISTEN			2
+#define MEMP_NUM_TCP_SEG				32
+#define MEMP_NUM_UDP_PCB				4
+#define MEMP_NUM_NETBUF					8
+#define MEMP_NUM_NETCONN				6
+#define MEMP_NUM_TCPIP_MSG_INPKT		16
+#define PBUF_POOL_SIZE					8				// 受信はパケットバッファを使うので少なくてよい
+#define PBUF_POOL_BUFSIZE				LWIP_MEM_ALIGN_SIZE(TCP_MSS + 40 + PBUF_LINK_HLEN)
+#define LWIP_SUPPORT_CUSTOM_PBUF		1
+#define ETH_PAD_SIZE					0
+
+// プロトコル
+#define LWIP_ARP						1
+#define LWIP_ETHERNET					1
+#define LWIP_IPV4						1
+#define LWIP_IPV6						0
+#define LWIP_ICMP						1
+#define LWIP_UDP						1
+#define LWIP_TCP						1
+#define LWIP_DHCP						0
+#define LWIP_DNS						0
+#define LWIP_IGMP						0
+#define IP_REASSEMBLY					0
+#define IP_FRAG							0
+#define ARP_TABLE_SIZE					8
+#define ARP_QUEUEING					1
+
+// TCP
+#define TCP_MSS							1460
+#define TCP_WND							(16 * TCP_MSS)	// 受信ウィンドウ (受信バッファ数で制限)
+#define TCP_SND_BUF						(8 * TCP_MSS)
+#define TCP_SND_QUEUELEN				(4 * TCP_SND_BUF / TCP_MSS)
+#define TCP_SNDLOWAT					(TCP_SND_BUF / 2)
+#define TCP_QUEUE_OOSEQ					1
+#define TCP_OVERSIZE					TCP_MSS
+#define LWIP_TCP_TIMESTAMPS				0
+#define LWIP_WND_SCALE					0
+#define TCP_LISTEN_BACKLOG				1
+// TCP_WNDがPBUF_POOLより大きいとエラーになるが、受信はパケットバッファを使うので無効にする
+#define LWIP_DISABLE_TCP_SANITY_CHECKS	1
+
+// チェックサム (MACのチェックサムオフロードを使う)
+#define CHECKSUM_BY_HARDWARE			1
+#if CHECKSUM_BY_HARDWARE
+#define CHECKSUM_GEN_IP					0
+#define CHECKSUM_GEN_UDP				0
+#define CHECKSUM_GEN_TCP				0
+#define CHECKSUM_GEN_ICMP				0
+#define CHECKSUM_CHECK_IP				0
+#define CHECKSUM_CHECK_UDP				0
+#define CHECKSUM_CHECK_TCP				0
+#define CHECKSUM_CHECK_ICMP				0
+#else
+#define CHECKSUM_GEN_IP					1
+#define CHECKSUM_GEN_UDP				1
+#define CHECKSUM_GEN_TCP				1
+#define CHECKSUM_GEN_ICMP				1
+#define CHECKSUM_CHECK_IP				1
+#define CHECKSUM_CHECK_UDP				1
+#define CHECKSUM_CHECK_TCP				1
+#define CHECKSUM_CHECK_ICMP				1
+#endif
+
+// netif
+#define LWIP_NETIF_TX_SINGLE_PBUF		0	// pbufチェインのまま送信する
+#define LWIP_NETIF_LINK_CALLBACK		0
+#define LWIP_NETIF_STATUS_CALLBACK		0
+
+// API
+#define LWIP_NETCONN					1
+#define LWIP_SOCKET						0
+#define LWIP_SO_RCVTIMEO				1
+
+// 統計、デバッグ
+#define LWIP_STATS						0
+#define LWIP_DEBUG						0
+
+#endif /* LWIP_TARGET_LWIPOPTS_H_ */
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# profsym.py
+#
+# profコマンドのダンプをELFのシンボルで関数名にして、フラットプロファイルと
+# flamegraph.pl / speedscope 用のfolded stack形式を出力する
+#
+#   python3 profsym.py capture.txt                          : フラットプロファイルを表示
+#   python3 profsym.py capture.txt --folded prof.folded     : folded stackも出力
+#   python3 profsym.py capture.txt --elf Debug/Eth.elf --nm arm-none-eabi-nm
+#
+# LRは"prof start <rate> lr"で記録したときだけ使う (呼び出し元1段ぶん)
+# (*) LRは関数呼び出しのたびに書き換わるので、リーフ関数以外では呼び出し元として正しくないことがある
+
+import argparse
+import bisect
+import os
+import subprocess
+import sys
+
+DEFAULT_ELF = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Debug", "Eth.elf")
+
+
+class Capture:
+	def __init__(self):
+		self.rate = 0
+		self.samples = 0
+		self.isr = 0
+		self.lost = 0
+		self.hist = []	# (pc, lr, cnt)
+
+
+# コンソール出力の読み込み (#PROFより前の行は読み飛ばす)
+def read_capture(f):
+	cap = Capture()
+	started = False
+	for line in f:
+		w = line.split()
+		if not w:
+			continue
+		if w[0] == "#PROF":
+			started = True
+			cap.rate, cap.samples, cap.isr, cap.lost = (int(x) for x in w[1:5])
+			cap.hist = []
+		elif not started:
+			continue
+		elif w[0] == "P" and len(w) >= 4:
+			cap.hist.append((int(w[1], 16), int(w[2], 16), int(w[3])))
+		elif w[0] == "#END":
+			break
+	if not started:
+		sys.exit("no #PROF header found")
+	return cap
+
+
+# シンボル表 (関数のみ、アドレス順)
+class Symbols:
+	def __init__(self, elf, nm):
+		self.addr = []
+		self.end = []
+		self.name = []
+		try:
+			out = subprocess.run([nm, "-n", "-S", "--defined-only", elf],
+			                     check=True, capture_output=True, text=True).stdout
+		except (OSError, subprocess.CalledProcessError) as e:
+			sys.exit("%s failed: %s" % (nm, e))
+		for line in out.splitlines():
+			w = line.split()
+			# アドレス サイズ 種別 名前 (サイズのないシンボルは3項目)
+			if len(w) == 4 and w[2] in "tTwW":
+				addr = int(w[0], 16) & ~1	# Thumbのbit0を落とす
+				self.addr.append(addr)
+				self.end.append(addr + int(w[1], 16))
+				self.name.append(w[3])
+
+	def lookup(self, addr):
+		addr &= ~1
+		i = bisect.bisect_right(self.addr, addr) - 1
+		if (i >= 0) and (addr < self.end[i]):
+			return self.name[i]
+		return "0x%08x" % addr
+
+
+# EXC_RETURN (割り込みの中でLRが例外からの戻り値になっている)
+def is_exc_return(lr):
+	return lr >= 0xFFFFFFE0
+
+
+def main():
+	ap = argparse.ArgumentParser(description="symbolize prof dump")
+	ap.add_argument("input", nargs="?", help="console capture (default: stdin)")
+	ap.add_argument("--elf", default=DEFAULT_ELF)
+	ap.add_argument("--nm", default="arm-none-eabi-nm")
+	ap.add_argument("--folded", metavar="FILE", help="write folded stacks")
+	ap.add_argument("--top", type=int, default=30, help="number of functions to show")
+	opt = ap.parse_args()
+
+	if opt.input:
+		with open(opt.input, errors="replace") as f:
+			cap = read_capture(f)
+	else:
+		cap = read_capture(sys.stdin)
+	sym = Symbols(opt.elf, opt.nm)
+
+	flat = {}
+	folded = {}
+	total = 0
+	for pc, lr, cnt in cap.hist:
+		func = sym.lookup(pc)
+		flat[func] = flat.get(func, 0) + cnt
+		total += cnt
+		stack = func
+		if lr != 0:
+			caller = "[exception]" if is_exc_return(lr) else sym.lookup(lr)
+			# 非リーフ関数ではLRが自分の中を指していることがあるので省く
+			if caller != func:
+				stack = caller + ";" + func
+		folded[stack] = folded.get(stack, 0) + cnt
+
+	print("rate %d Hz, samples %d (in isr %d, lost %d)" % (cap.rate, cap.samples, cap.isr, cap.lost))
+	print("%8s %7s  %s" % ("samples", "%", "function"))
+	for func, cnt in sorted(flat.items(), key=lambda x: -x[1])[:opt.top]:
+		print("%8d %6.2f%%  %s" % (cnt, cnt * 100.0 / total if total else 0, func))
+
+	if opt.folded:
+		with open(opt.folded, "w") as f:
+			for stack, cnt in sorted(folded.items()):
+				f.write("%s %d\n" % (stack, cnt))
+
+
+if __name__ == "__main__":
+	main()
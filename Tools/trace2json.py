@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+# trace2json.py
+#
+# traceコマンドのダンプをChromeのトレース形式(JSON)に変換する
+# (Perfetto UI / chrome://tracing で開ける)
+#
+#   python3 trace2json.py capture.txt -o trace.json      : "trace dump"のコンソール出力から変換
+#   python3 trace2json.py --udp 5000 -o trace.json       : "trace dump <ip> 5000"をUDPで受信して変換
+#
+# タスクはpid 1、割り込みはpid 2、Ethernetドライバはpid 3に並べる
+
+import argparse
+import json
+import socket
+import struct
+import sys
+
+# カテゴリ、イベントID (trace.hと合わせること)
+CAT_OS, CAT_ISR, CAT_TICK, CAT_ETH = 0, 1, 2, 3
+
+TASK_IN, TASK_OUT = 0x000, 0x001
+QUEUE_SEND, QUEUE_RECV = 0x002, 0x003
+QUEUE_BLOCK_SEND, QUEUE_BLOCK_RECV = 0x004, 0x005
+NOTIFY, NOTIFY_BLOCK, NOTIFY_TAKE = 0x006, 0x007, 0x008
+ISR_ENTER, ISR_EXIT = 0x100, 0x101
+TICK_ENTER, TICK_EXIT = 0x200, 0x201
+ETH_CLEAN_START, ETH_CLEAN_END = 0x300, 0x301
+ETH_TX_POST = 0x302
+ETH_WAIT_START, ETH_WAIT_END = 0x303, 0x304
+ETH_TX_DONE, ETH_RX = 0x305, 0x306
+
+PID_TASK, PID_ISR, PID_ETH = 1, 2, 3
+
+INSTANT_NAME = {
+	QUEUE_SEND: "queue send",
+	QUEUE_RECV: "queue recv",
+	QUEUE_BLOCK_SEND: "queue block send",
+	QUEUE_BLOCK_RECV: "queue block recv",
+	NOTIFY: "notify",
+	NOTIFY_BLOCK: "notify block",
+	NOTIFY_TAKE: "notify take",
+	ETH_TX_POST: "tx post",
+	ETH_TX_DONE: "tx done",
+	ETH_RX: "rx",
+}
+
+# UDP (trace.cと合わせること)
+UDP_MAGIC = b"TRC1"
+UDP_TYPE_META, UDP_TYPE_EVENT, UDP_TYPE_END = 0, 1, 2
+UDP_NAME_TASK = 0
+UDP_NAME_SIZE = 16
+REC_SIZE = 8
+
+
+class Capture:
+	def __init__(self):
+		self.hz = 216000000
+		self.num = 0
+		self.lost = 0
+		self.task = {}
+		self.isr = {}
+		self.events = []	# (ts, id, arg)
+
+
+# コンソール出力の読み込み (#TRACEより前の行は読み飛ばす)
+def read_text(f):
+	cap = Capture()
+	started = False
+	for line in f:
+		w = line.split()
+		if not w:
+			continue
+		if w[0] == "#TRACE":
+			started = True
+			cap.hz, cap.num, cap.lost = int(w[1]), int(w[2]), int(w[3])
+		elif not started:
+			continue
+		elif w[0] == "#TASK":
+			cap.task[int(w[1])] = " ".join(w[2:])
+		elif w[0] == "#ISR":
+			cap.isr[int(w[1])] = " ".join(w[2:])
+		elif w[0] == "E":
+			v = [int(x, 16) for x in w[1:]]
+			for i in range(0, len(v) - 2, 3):
+				cap.events.append((v[i], v[i + 1], v[i + 2]))
+		elif w[0] == "#END":
+			break
+	if not started:
+		sys.exit("no #TRACE header found")
+	return cap
+
+
+# UDPで受信
+def read_udp(port, timeout):
+	cap = Capture()
+	chunks = {}
+	sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+	sock.bind(("", port))
+	sock.settimeout(timeout)
+	got_meta = False
+	try:
+		while True:
+			data, _ = sock.recvfrom(2048)
+			if len(data) < 8 or data[0:4] != UDP_MAGIC:
+				continue
+			typ = data[4]
+			seq = struct.unpack_from("<H", data, 6)[0]
+			body = data[8:]
+			if typ == UDP_TYPE_META:
+				got_meta = True
+				cap.hz, cap.num, cap.lost, n = struct.unpack_from("<IIIB", body, 0)
+				off = 14
+				for _ in range(n):
+					kind, num = body[off], body[off + 1]
+					name = body[off + 2:off + 2 + UDP_NAME_SIZE].split(b"\0")[0].decode(errors="replace")
+					(cap.task if kind == UDP_NAME_TASK else cap.isr)[num] = name
+					off += 2 + UDP_NAME_SIZE
+			elif typ == UDP_TYPE_EVENT:
+				chunks[seq] = body
+			elif typ == UDP_TYPE_END:
+				break
+	except socket.timeout:
+		print("timeout, conversion continues with received packets", file=sys.stderr)
+	finally:
+		sock.close()
+	if not got_meta:
+		sys.exit("no META packet received")
+	for seq in sorted(chunks):
+		body = chunks[seq]
+		for off in range(0, len(body) - REC_SIZE + 1, REC_SIZE):
+			cap.events.append(struct.unpack_from("<IHH", body, off))
+	if len(cap.events) != cap.num:
+		print("warning: %d of %d events received" % (len(cap.events), cap.num), file=sys.stderr)
+	return cap
+
+
+# 32bitのタイムスタンプを伸ばして[us]にする (記録順に並んでいるので差分は符号付きで見る)
+def unwrap(cap):
+	out = []
+	prev = None
+	base = 0
+	for ts, eid, arg in cap.events:
+		if prev is None:
+			cur = 0
+		else:
+			d = (ts - prev) & 0xFFFFFFFF
+			if d >= 0x80000000:
+				d -= 0x100000000
+			cur = base + d
+		base, prev = cur, ts
+		out.append((cur, eid, arg))
+	# 割り込みとタスクの記録が前後することがあるので並べなおす (同時刻は記録順)
+	out.sort(key=lambda e: e[0])
+	scale = 1e6 / cap.hz
+	return [(t * scale, eid, arg) for t, eid, arg in out]
+
+
+def convert(cap):
+	events = unwrap(cap)
+	out = []
+
+	def meta(pid, tid, key, name):
+		ev = {"ph": "M", "pid": pid, "name": key, "args": {"name": name}}
+		if tid is not None:
+			ev["tid"] = tid
+		out.append(ev)
+
+	meta(PID_TASK, None, "process_name", "tasks")
+	meta(PID_ISR, None, "process_name", "interrupts")
+	meta(PID_ETH, None, "process_name", "eth driver")
+	for num, name in cap.task.items():
+		meta(PID_TASK, num, "thread_name", name)
+	for num, name in cap.isr.items():
+		meta(PID_ISR, num, "thread_name", name)
+
+	running = {}	# 実行中のタスク : 開始時刻
+	isr_start = {}	# 割り込み番号 : 開始時刻
+	clean_start = None
+	cur_task = 0
+	wait_id = 0
+
+	def task_name(num):
+		return cap.task.get(num, "task%d" % num)
+
+	for ts, eid, arg in events:
+		cat = eid >> 8
+		if eid == TASK_IN:
+			running[arg] = ts
+			cur_task = arg
+		elif eid == TASK_OUT:
+			if arg in running:
+				t0 = running.pop(arg)
+				out.append({"ph": "X", "pid": PID_TASK, "tid": arg, "ts": t0, "dur": ts - t0, "name": task_name(arg)})
+		elif eid in (ISR_ENTER, TICK_ENTER):
+			isr_start[arg] = ts
+		elif eid in (ISR_EXIT, TICK_EXIT):
+			if arg in isr_start:
+				t0 = isr_start.pop(arg)
+				out.append({"ph": "X", "pid": PID_ISR, "tid": arg, "ts": t0, "dur": ts - t0,
+				            "name": cap.isr.get(arg, "isr%d" % arg)})
+		elif eid == ETH_CLEAN_START:
+			clean_start = (ts, arg)
+		elif eid == ETH_CLEAN_END:
+			if clean_start is not None:
+				out.append({"ph": "X", "pid": PID_ETH, "tid": 0, "ts": clean_start[0], "dur": ts - clean_start[0],
+				            "name": "dcache clean", "args": {"size": clean_start[1]}})
+				clean_start = None
+		elif eid == ETH_WAIT_START:
+			wait_id += 1
+			out.append({"ph": "b", "pid": PID_ETH, "tid": cur_task, "ts": ts, "cat": "eth", "id": wait_id,
+			            "name": "send wait", "args": {"task": task_name(cur_task)}})
+		elif eid == ETH_WAIT_END:
+			out.append({"ph": "e", "pid": PID_ETH, "tid": cur_task, "ts": ts, "cat": "eth", "id": wait_id,
+			            "name": "send wait", "args": {"bits": arg}})
+		elif eid in INSTANT_NAME:
+			pid, tid = (PID_ETH, 0) if cat == CAT_ETH else (PID_TASK, cur_task)
+			args = {"arg": arg}
+			if eid == ETH_TX_POST:
+				args = {"first": arg & 0xFF, "desc": arg >> 8}
+			elif eid in (NOTIFY, NOTIFY_BLOCK, NOTIFY_TAKE):
+				args = {"task": task_name(arg)}
+			elif eid in (QUEUE_SEND, QUEUE_RECV, QUEUE_BLOCK_SEND, QUEUE_BLOCK_RECV):
+				args = {"queue": "0x%04x" % arg}
+			out.append({"ph": "i", "s": "t", "pid": pid, "tid": tid, "ts": ts, "name": INSTANT_NAME[eid], "args": args})
+
+	return {"traceEvents": out, "displayTimeUnit": "ns",
+	        "metadata": {"cpu_hz": cap.hz, "events": cap.num, "lost": cap.lost}}
+
+
+def main():
+	ap = argparse.ArgumentParser(description="convert trace dump to Chrome trace JSON")
+	ap.add_argument("input", nargs="?", help="console capture (default: stdin)")
+	ap.add_argument("--udp", type=int, metavar="PORT", help="receive dump by UDP")
+	ap.add_argument("--timeout", type=float, default=10.0, help="UDP receive timeout [s]")
+	ap.add_argument("-o", "--output", default="trace.json")
+	opt = ap.parse_args()
+
+	if opt.udp is not None:
+		cap = read_udp(opt.udp, opt.timeout)
+	elif opt.input:
+		with open(opt.input, errors="replace") as f:
+			cap = read_text(f)
+	else:
+		cap = read_text(sys.stdin)
+
+	with open(opt.output, "w") as f:
+		json.dump(convert(cap), f)
+	print("%d events (%d lost) -> %s" % (len(cap.events), cap.lost, opt.output))
+
+
+if __name__ == "__main__":
+	main()